@@ -1,5 +1,30 @@
 #include "AdminConfigManager.h"
 #include <SPIFFS.h>
+#include <algorithm>
+
+namespace {
+// Reads optional { "depth": n, "overflow": "dropNewest|dropOldest|coalesce" }
+// over the given defaults. A coalescing queue holds one reading per sensor
+// whatever its depth, so "depth" is ignored, with a warning, for coalesce.
+QueueConfig parseQueueConfig(const ConfigNode& node, QueueConfig queue) {
+  if (node.has("overflow")) {
+    String policy = node.get<String>("overflow");
+    policy.toLowerCase();
+    if (policy == "dropnewest")      queue.policy = OverflowPolicy::DropNewest;
+    else if (policy == "dropoldest") queue.policy = OverflowPolicy::DropOldest;
+    else if (policy == "coalesce")   queue.policy = OverflowPolicy::CoalesceLatest;
+    else Serial.println("⚠️ Unknown queue overflow policy '" + policy + "', keeping default");
+  }
+  if (node.has("depth")) {
+    if (queue.policy == OverflowPolicy::CoalesceLatest) {
+      Serial.println("⚠️ Queue depth is ignored with overflow 'coalesce' (one slot per sensor)");
+    } else {
+      queue.depth = std::max<uint16_t>(1, node.get<uint16_t>("depth"));
+    }
+  }
+  return queue;
+}
+}
 
 AdminConfigManager::AdminConfigManager() {}
 
@@ -84,6 +109,13 @@ std::vector<SensorConfig> AdminConfigManager::getSensors() const {
     if (sensor.interface == "i2c") {
       sensor.sdaPin = node.get<uint8_t>("sdaPin");
       sensor.sclPin = node.get<uint8_t>("sclPin");
+      if (node.has("address")) {
+        // Either a number or a string such as "0x77"
+        JsonVariantConst address = node.getNode("address").getRaw();
+        sensor.i2cAddress = address.is<const char*>()
+          ? static_cast<uint8_t>(strtoul(address.as<const char*>(), nullptr, 0))
+          : address.as<uint8_t>();
+      }
     } else if (sensor.interface == "spi") {
       sensor.mosiPin = node.get<uint8_t>("mosiPin");
       sensor.misoPin = node.get<uint8_t>("misoPin");
@@ -93,6 +125,20 @@ std::vector<SensorConfig> AdminConfigManager::getSensors() const {
       sensor.analogPin = node.get<uint8_t>("analogPin");
     } else if (sensor.interface == "onewire") {
       sensor.onewirePin = node.get<uint8_t>("onewirePin");
+      if (node.has("resolution")) {
+        sensor.resolution = constrain(node.get<uint8_t>("resolution"), 9, 12);
+      }
+      for (const auto& probeNode : node.getArray("probes")) {
+        if (!probeNode.has("rom") || !probeNode.has("name")) {
+          Serial.printf("[AdminConfig] ⚠️ Probe on '%s' missing 'rom' or 'name'. Skipping.\n", sensor.name.c_str());
+          continue;
+        }
+        OneWireProbeConfig probe;
+        probe.rom  = probeNode.get<String>("rom");
+        probe.name = probeNode.get<String>("name");
+        probe.rom.toUpperCase();
+        sensor.probes.push_back(probe);
+      }
     } else {
       Serial.printf("[AdminConfig] ❌ Unknown interface '%s' for sensor '%s'. Skipping.\n",
                     sensor.interface.c_str(), sensor.name.c_str());
@@ -169,6 +215,24 @@ bool AdminConfigManager::debugEnabled() const {
 
 MqttConfig AdminConfigManager::getMqttConfig() const {
   ConfigNode root(doc);
+
+  MqttFormat format = MqttFormat::Json;
+  if (root.has("mqtt.format")) {
+    String formatStr = root.get<String>("mqtt.format");
+    formatStr.toLowerCase();
+    if (formatStr == "msgpack") format = MqttFormat::MsgPack;
+  }
+
+  uint32_t spoolMaxBytes = 64 * 1024;
+  if (root.has("mqtt.spoolMaxBytes")) {
+    spoolMaxBytes = root.get<uint32_t>("mqtt.spoolMaxBytes");
+  }
+
+  QueueConfig queue;
+  if (root.has("mqtt.queue")) {
+    queue = parseQueueConfig(root.getNode("mqtt.queue"), queue);
+  }
+
   return {
     root.get<bool>("mqtt.enabled"),
     root.get<String>("mqtt.sensorId"),
@@ -180,10 +244,22 @@ MqttConfig AdminConfigManager::getMqttConfig() const {
     root.get<String>("mqtt.password"),
     root.get<uint16_t>("mqtt.batchSize"),
     root.get<uint32_t>("mqtt.flushIntervalMs"),
-    root.get<uint32_t>("mqtt.bufferSize")
+    root.get<int>("mqtt.bufferSize"),
+    format,
+    spoolMaxBytes,
+    queue
   };
 }
 
+QueueConfig AdminConfigManager::getOverlayQueueConfig() const {
+  ConfigNode root(doc);
+  QueueConfig queue = OverlayConfig().queue;
+  if (root.has("overlayQueue")) {
+    queue = parseQueueConfig(root.getNode("overlayQueue"), queue);
+  }
+  return queue;
+}
+
 OtaConfig AdminConfigManager::getOtaConfig() const {
   ConfigNode root(doc);
   return {
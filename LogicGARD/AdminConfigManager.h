@@ -29,6 +29,7 @@ public:
   TimeProviderType getTimeProviderType() const;
   bool debugEnabled() const;
   MqttConfig getMqttConfig() const;
+  QueueConfig getOverlayQueueConfig() const;
   OtaConfig getOtaConfig() const;
   TftDisplayConfig getTftDisplayConfig() const;
 
@@ -1,31 +1,64 @@
 #pragma once
 
 #include <Arduino.h>
+#include <vector>
 #include "Types.h"
-#include "HttpClientWrapper.h"
+#include "HttpConnectionPool.h"
 #include "BaseComponent.h"
 
+// One request of a batch sent over a single connection
+struct HttpBatchItem {
+  String payload;
+  String response;
+  bool ok = false;
+};
+
 class AuthStrategy : public BaseComponent {
 public:
-  explicit AuthStrategy(const AuthCredentials& creds)
+  static constexpr LogTag logTag = LogTag::Http;
+
+  // Without a shared pool the strategy gets a private single connection
+  explicit AuthStrategy(const AuthCredentials& creds,
+                        std::shared_ptr<HttpConnectionPool> pool = nullptr)
     : credentials(creds),
-      httpClient(std::make_unique<HttpClientWrapper>()) {}
+      pool(pool ? pool : std::make_shared<HttpConnectionPool>(1)) {}
 
   virtual ~AuthStrategy() {}
 
   // Must be implemented by derived classes
   virtual String getAuthHeader(String method, String uri) = 0;
 
+  bool post(const String& payload, String* responseOut, const ApiConfig& config) {
+    auto connection = pool->acquire();
+    if (!connection) return false;
+    return postOn(connection, payload, responseOut, config);
+  }
+
+  // Sends the items one after another on a single pooled connection;
+  // returns how many succeeded.
+  size_t postAll(std::vector<HttpBatchItem>& items, const ApiConfig& config) {
+    auto connection = pool->acquire();
+    if (!connection) return 0;
+
+    size_t succeeded = 0;
+    for (HttpBatchItem& item : items) {
+      item.ok = postOn(connection, item.payload, &item.response, config);
+      if (item.ok) ++succeeded;
+    }
+    return succeeded;
+  }
+
+protected:
   // Shared POST logic for all auth strategies
-  virtual bool post(const String& payload, String* responseOut, const ApiConfig& config) {
+  virtual bool postOn(HttpConnectionPool::Lease& connection, const String& payload,
+                      String* responseOut, const ApiConfig& config) {
     String url = config.fullUrl();
     String authHeader = getAuthHeader("POST", config.path);
 
-    int code = httpClient->performPost(url, payload, authHeader, responseOut);
+    int code = connection->performPost(url, payload, authHeader, responseOut);
     return code == 200 || code == 1;
   }
 
-protected:
   AuthCredentials credentials;
-  std::unique_ptr<HttpClientWrapper> httpClient;
+  std::shared_ptr<HttpConnectionPool> pool;
 };
\ No newline at end of file
@@ -1,3 +1,14 @@
 #include "BaseComponent.h"
 
-bool BaseComponent::debugEnabled = false;
\ No newline at end of file
+namespace {
+// Every tag starts at INFO, so a new LogTag cannot be left at NONE by a
+// missing initializer. Constant-initialized, hence ready before any
+// static constructor logs.
+constexpr std::array<uint8_t, static_cast<size_t>(LogTag::Count)> defaultLogLevels() {
+  std::array<uint8_t, static_cast<size_t>(LogTag::Count)> levels{};
+  for (uint8_t& level : levels) level = LOG_LEVEL_INFO;
+  return levels;
+}
+}
+
+std::array<uint8_t, static_cast<size_t>(LogTag::Count)> BaseComponent::logLevels = defaultLogLevels();
@@ -1,19 +1,57 @@
 #pragma once
 #include <Arduino.h>
+#include <array>
+#include "Log.h"
+#include "LogRing.h"
 
 class BaseComponent {
 public:
+  static constexpr LogTag logTag = LogTag::Core;
+
+  // Toggles debug level on every component (OTA DebugEnable/DebugDisable).
   static void enableDebug(bool enabled) {
-    debugEnabled = enabled;
+    uint8_t level = enabled ? LOG_LEVEL_DEBUG : LOG_LEVEL_INFO;
+    for (uint8_t& l : logLevels) l = level;
+  }
+
+  static void setLogLevel(LogTag tag, uint8_t level) {
+    logLevels[static_cast<uint8_t>(tag)] = level;
   }
 
-  static void debugLog(const String& msg) {
-    if (debugEnabled) {
-      Serial.print("[Debug] ");
-      Serial.println(msg);
+  static bool logEnabled(LogTag tag, uint8_t level) {
+    return level <= logLevels[static_cast<uint8_t>(tag)];
+  }
+
+  // Captures the call into a LogEvent; formatting happens later on the
+  // LogRing drain task, or inline if the ring has not been started yet.
+  // Once the ring runs the event is built in its ring slot rather than on
+  // the caller's stack, which may be a small sensor or consumer task.
+  template<typename... Args>
+  static void log(LogTag tag, uint8_t level, const char* fmt, Args... args) {
+    if (LogRing::isRunning()) {
+      uint32_t ticket;
+      LogEvent* slot = LogRing::claim(ticket);
+      if (!slot) return;
+      capture(*slot, tag, level, fmt, args...);
+      LogRing::commit(ticket);
+    } else {
+      LogEvent event;
+      capture(event, tag, level, fmt, args...);
+      LogRing::write(event);
     }
   }
 
 protected:
-  static bool debugEnabled;
-};
\ No newline at end of file
+  template<typename... Args>
+  static void capture(LogEvent& event, LogTag tag, uint8_t level, const char* fmt, Args... args) {
+    event.fmt = fmt;
+    event.tag = tag;
+    event.level = level;
+    event.argc = 0;
+    event.textUsed = 0;
+    int expand[] = { 0, (event.add(args), 0)... };
+    (void)expand;
+  }
+
+  static std::array<uint8_t, static_cast<size_t>(LogTag::Count)> logLevels;
+};
@@ -1,28 +1,34 @@
 #include "BasicAuthStrategy.h"
 #include <base64.h>
 
-BasicAuthStrategy::BasicAuthStrategy(const AuthCredentials& creds)
-  : AuthStrategy(creds) {}
-
-bool BasicAuthStrategy::post(const String& payload, String* responseOut, const ApiConfig& config) {
-  if (!httpClient || !httpClient->isValid()) {
+BasicAuthStrategy::BasicAuthStrategy(const AuthCredentials& creds,
+                                     std::shared_ptr<HttpConnectionPool> pool)
+  : AuthStrategy(creds, pool),
+    cachedHeader(buildAuthHeader()) {}
+
+bool BasicAuthStrategy::postOn(HttpConnectionPool::Lease& connection, const String& payload,
+                               String* responseOut, const ApiConfig& config) {
+  if (!connection->isValid()) {
     Serial.println("[BasicAuth] Invalid HTTP client");
     return false;
   }
 
   String url = config.fullUrl();
-  String authHeader = getAuthHeader("POST", config.path);
 
-  if (authHeader.isEmpty()) {
+  if (cachedHeader.isEmpty()) {
     Serial.println("[BasicAuth] Failed to generate Authorization header");
     return false;
   }
 
-  int code = httpClient->performPost(url, payload, authHeader, responseOut);
+  int code = connection->performPost(url, payload, cachedHeader, responseOut);
   return code == 200 || code == 1;
 }
 
-String BasicAuthStrategy::getAuthHeader(String method, String uri) {
+String BasicAuthStrategy::getAuthHeader(String, String) {
+  return cachedHeader;
+}
+
+String BasicAuthStrategy::buildAuthHeader() const {
   if (credentials.username.isEmpty() || credentials.password.isEmpty()) {
     return String();
   }
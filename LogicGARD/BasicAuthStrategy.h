@@ -3,8 +3,20 @@
 
 class BasicAuthStrategy : public AuthStrategy {
 public:
-  explicit BasicAuthStrategy(const AuthCredentials& creds);
+  explicit BasicAuthStrategy(const AuthCredentials& creds,
+                             std::shared_ptr<HttpConnectionPool> pool = nullptr);
 
-  bool post(const String& payload, String* responseOut, const ApiConfig& config) override;
   String getAuthHeader(String method, String uri) override;
+
+protected:
+  bool postOn(HttpConnectionPool::Lease& connection, const String& payload,
+              String* responseOut, const ApiConfig& config) override;
+
+private:
+  String buildAuthHeader() const;
+
+  // Basic auth is preemptive: the header only depends on the credentials,
+  // which are fixed for the strategy's lifetime (a config save restarts the
+  // device), so it is encoded once and sent with every post.
+  String cachedHeader;
 };
\ No newline at end of file
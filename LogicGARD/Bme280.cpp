@@ -0,0 +1,129 @@
+#include "Bme280.h"
+
+namespace {
+constexpr uint8_t REG_CALIB_TP = 0x88;   // 0x88..0xA1: T1..T3, P1..P9, (A0 unused), H1
+constexpr uint8_t REG_CHIP_ID = 0xD0;
+constexpr uint8_t REG_CALIB_H = 0xE1;    // 0xE1..0xE7: H2..H6
+constexpr uint8_t REG_CTRL_HUM = 0xF2;
+constexpr uint8_t REG_CTRL_MEAS = 0xF4;
+constexpr uint8_t REG_CONFIG = 0xF5;
+constexpr uint8_t REG_DATA = 0xF7;       // 0xF7..0xFE: press, temp, hum
+
+constexpr uint8_t CHIP_ID = 0x60;
+constexpr uint8_t OSRS_X1 = 0x01;
+constexpr uint8_t MODE_FORCED = 0x01;
+constexpr uint8_t CTRL_MEAS_FORCED = (OSRS_X1 << 5) | (OSRS_X1 << 2) | MODE_FORCED;
+
+// Marks a channel the chip skipped
+constexpr int32_t ADC_SKIPPED_20 = 0x80000;
+constexpr int32_t ADC_SKIPPED_16 = 0x8000;
+
+uint16_t le16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+}
+
+bool Bme280::begin(I2cBus& bus, uint8_t address) {
+  this->bus = &bus;
+  this->address = address;
+
+  uint8_t id;
+  if (!bus.readRegisters(address, REG_CHIP_ID, &id, 1) || id != CHIP_ID) return false;
+
+  uint8_t tp[26];
+  uint8_t h[7];
+  if (!bus.readRegisters(address, REG_CALIB_TP, tp, sizeof(tp)) ||
+      !bus.readRegisters(address, REG_CALIB_H, h, sizeof(h))) {
+    return false;
+  }
+
+  digT1 = le16(tp + 0);
+  digT2 = static_cast<int16_t>(le16(tp + 2));
+  digT3 = static_cast<int16_t>(le16(tp + 4));
+  digP1 = le16(tp + 6);
+  digP2 = static_cast<int16_t>(le16(tp + 8));
+  digP3 = static_cast<int16_t>(le16(tp + 10));
+  digP4 = static_cast<int16_t>(le16(tp + 12));
+  digP5 = static_cast<int16_t>(le16(tp + 14));
+  digP6 = static_cast<int16_t>(le16(tp + 16));
+  digP7 = static_cast<int16_t>(le16(tp + 18));
+  digP8 = static_cast<int16_t>(le16(tp + 20));
+  digP9 = static_cast<int16_t>(le16(tp + 22));
+  digH1 = tp[25];
+  digH2 = static_cast<int16_t>(le16(h + 0));
+  digH3 = h[2];
+  digH4 = static_cast<int16_t>((static_cast<int8_t>(h[3]) * 16) | (h[4] & 0x0F));
+  digH5 = static_cast<int16_t>((static_cast<int8_t>(h[5]) * 16) | (h[4] >> 4));
+  digH6 = static_cast<int8_t>(h[6]);
+
+  // Sleep with no filter; ctrl_hum only takes effect on the next ctrl_meas write
+  return bus.writeRegister(address, REG_CTRL_MEAS, 0) &&
+         bus.writeRegister(address, REG_CONFIG, 0) &&
+         bus.writeRegister(address, REG_CTRL_HUM, OSRS_X1);
+}
+
+bool Bme280::trigger() {
+  return bus && bus->writeRegister(address, REG_CTRL_MEAS, CTRL_MEAS_FORCED);
+}
+
+bool Bme280::read(Reading& reading) {
+  uint8_t data[8];
+  if (!bus || !bus->readRegisters(address, REG_DATA, data, sizeof(data))) return false;
+
+  int32_t adcP = (static_cast<int32_t>(data[0]) << 12) | (data[1] << 4) | (data[2] >> 4);
+  int32_t adcT = (static_cast<int32_t>(data[3]) << 12) | (data[4] << 4) | (data[5] >> 4);
+  int32_t adcH = (static_cast<int32_t>(data[6]) << 8) | data[7];
+  if (adcT == ADC_SKIPPED_20 || adcP == ADC_SKIPPED_20 || adcH == ADC_SKIPPED_16) return false;
+
+  // Temperature first: it sets tFine for the other two
+  reading.centiCelsius = compensateTemperature(adcT);
+  reading.pressurePa = compensatePressure(adcP);
+  reading.centiHumidity = compensateHumidity(adcH);
+  return true;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Compensation, BME280 datasheet section 4.2.3
+// ─────────────────────────────────────────────────────────────
+
+// Returns hundredths of °C
+int32_t Bme280::compensateTemperature(int32_t adc) {
+  int32_t var1 = (((adc >> 3) - (static_cast<int32_t>(digT1) << 1)) * digT2) >> 11;
+  int32_t delta = (adc >> 4) - static_cast<int32_t>(digT1);
+  int32_t var2 = (((delta * delta) >> 12) * digT3) >> 14;
+  tFine = var1 + var2;
+  return (tFine * 5 + 128) >> 8;
+}
+
+// Returns Pa
+uint32_t Bme280::compensatePressure(int32_t adc) const {
+  int64_t var1 = static_cast<int64_t>(tFine) - 128000;
+  int64_t var2 = var1 * var1 * digP6;
+  var2 += (var1 * digP5) << 17;
+  var2 += static_cast<int64_t>(digP4) << 35;
+  var1 = ((var1 * var1 * digP3) >> 8) + ((var1 * digP2) << 12);
+  var1 = (((static_cast<int64_t>(1) << 47) + var1) * digP1) >> 33;
+  if (var1 == 0) return 0;
+
+  int64_t p = 1048576 - adc;
+  p = (((p << 31) - var2) * 3125) / var1;
+  var1 = (static_cast<int64_t>(digP9) * (p >> 13) * (p >> 13)) >> 25;
+  var2 = (static_cast<int64_t>(digP8) * p) >> 19;
+  p = ((p + var1 + var2) >> 8) + (static_cast<int64_t>(digP7) << 4);
+
+  // Q24.8 → whole Pa
+  return static_cast<uint32_t>((p + 128) >> 8);
+}
+
+// Returns hundredths of %RH
+uint32_t Bme280::compensateHumidity(int32_t adc) const {
+  int32_t v = tFine - 76800;
+  v = (((adc << 14) - (static_cast<int32_t>(digH4) << 20) - (static_cast<int32_t>(digH5) * v) + 16384) >> 15) *
+      (((((((v * digH6) >> 10) * (((v * static_cast<int32_t>(digH3)) >> 11) + 32768)) >> 10) + 2097152) *
+        digH2 + 8192) >> 14);
+  v -= ((((v >> 15) * (v >> 15)) >> 7) * static_cast<int32_t>(digH1)) >> 4;
+  v = v < 0 ? 0 : v;
+  v = v > 419430400 ? 419430400 : v;
+
+  // Q22.10 → hundredths
+  uint32_t q10 = static_cast<uint32_t>(v) >> 12;
+  return (q10 * 100 + 512) >> 10;
+}
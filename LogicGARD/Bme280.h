@@ -0,0 +1,43 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+#include "I2cBus.h"
+
+// Minimal BME280 driver for forced-mode single shots on a shared I2cBus
+// (address 0x76, or 0x77 with SDO high, so two fit on one bus). begin()
+// checks the chip ID and loads the trimming coefficients; trigger() starts
+// one measurement of all three channels and returns at once; read()
+// fetches the eight data registers in a single burst and compensates them
+// with the datasheet's integer formulas (no floating point).
+class Bme280 {
+public:
+  static constexpr uint8_t DEFAULT_ADDRESS = 0x76;
+  static constexpr uint32_t MEASURE_MS = 10;   // Datasheet t_max at 1x oversampling is 9.3 ms
+
+  struct Reading {
+    int32_t centiCelsius;
+    uint32_t pressurePa;
+    uint32_t centiHumidity;    // Hundredths of %RH
+  };
+
+  bool begin(I2cBus& bus, uint8_t address = DEFAULT_ADDRESS);
+  bool trigger();
+  bool read(Reading& reading);
+
+private:
+  int32_t compensateTemperature(int32_t adc);
+  uint32_t compensatePressure(int32_t adc) const;
+  uint32_t compensateHumidity(int32_t adc) const;
+
+  I2cBus* bus = nullptr;
+  uint8_t address = DEFAULT_ADDRESS;
+  int32_t tFine = 0;
+
+  uint16_t digT1;
+  int16_t digT2, digT3;
+  uint16_t digP1;
+  int16_t digP2, digP3, digP4, digP5, digP6, digP7, digP8, digP9;
+  uint8_t digH1, digH3;
+  int16_t digH2, digH4, digH5;
+  int8_t digH6;
+};
@@ -5,28 +5,42 @@ CameraManager::CameraManager(const CameraConfig& cameraConfig)
   : cameraConfig(cameraConfig) {}
   
 void CameraManager::begin(MessageDispatcher& dispatcher) {
-  BaseComponent::debugLog("CameraManager::begin - Starting initialization of overlay managers...");
+  LOG_DEBUG("CameraManager::begin - Starting initialization of overlay managers...");
+
+  // One identity cache per camera, shared by all of its overlays
+  auto identities = std::make_shared<OverlayIdentityCache>();
+  // Overlays of a camera share its keep-alive connections
+  auto connections = HttpConnectionPool::forHost(cameraConfig.api.scheme, cameraConfig.api.host, cameraConfig.api.port);
+  auto batcher = std::make_shared<OverlayBatcher>(
+    std::make_shared<SecureHttpClient>(
+      std::make_unique<DigestAuthStrategy>(cameraConfig.credentials, connections),
+      cameraConfig.api
+    )
+  );
+  batcher->begin();
 
   size_t index = 0;
   for (const OverlayConfig& overlayConfig : cameraConfig.overlays) {
-    BaseComponent::debugLog("OverlayManager[" + String(index) + "] - Creating with config...");
-    BaseComponent::debugLog("  sensor: [" + overlayConfig.sensorId + "]");
+    LOG_DEBUG("OverlayManager[%u] - Creating with config...", (unsigned)index);
+    LOG_DEBUG("  sensor: [%s]", overlayConfig.sensorId.c_str());
 
     overlayManagers.push_back(std::make_unique<OverlayManager>(
       overlayConfig,
       std::make_shared<SecureHttpClient>(
-        std::make_unique<DigestAuthStrategy>(cameraConfig.credentials),
+        std::make_unique<DigestAuthStrategy>(cameraConfig.credentials, connections),
         cameraConfig.api
-      )
+      ),
+      identities,
+      batcher
     ));
 
     overlayManagers.back()->begin(dispatcher);
 
-    BaseComponent::debugLog("OverlayManager[" + String(index) + "] - Initialized.");
+    LOG_DEBUG("OverlayManager[%u] - Initialized.", (unsigned)index);
     ++index;
   }
   
-  BaseComponent::debugLog("CameraManager::begin - Total overlay managers initialized: " + String(overlayManagers.size()));
+  LOG_DEBUG("CameraManager::begin - Total overlay managers initialized: %u", (unsigned)overlayManagers.size());
 }
 
 String CameraManager::getText() const {
@@ -5,12 +5,14 @@
 #include "SecureHttpClient.h"
 #include "DigestAuthStrategy.h"
 #include "OverlayManager.h"
-#include "TemperatureMessage.h"
+#include "SensorMessage.h"
 #include "BaseComponent.h"
 #include "IDisplay.h"
 
 class CameraManager : public BaseComponent, public IDisplay {
 public:
+  static constexpr LogTag logTag = LogTag::Camera;
+
   CameraManager(const CameraConfig& cameraConfig);
 
   void begin(MessageDispatcher& dispatcher);
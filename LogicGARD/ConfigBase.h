@@ -2,14 +2,17 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include <SPIFFS.h>
 #include "BaseComponent.h"
 
 class ConfigBase : public BaseComponent {
 public:
+  static constexpr LogTag logTag = LogTag::Config;
+
   virtual ~ConfigBase() = default;
 
   // Load config from JSON string
-  bool AdminConfigManager::updateFromJsonString(String source) {
+  virtual bool updateFromJsonString(String source) {
     StaticJsonDocument<7168> json;
     DeserializationError error = deserializeJson(json, source);
     if (error) return false;
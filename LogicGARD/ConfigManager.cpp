@@ -6,7 +6,7 @@ ConfigManager::ConfigManager() {}
 
 void ConfigManager::begin(String filename) {
   _filename = filename;
-  BaseComponent::debugLog("[ConfigManager] Opening config file: " + _filename);
+  LOG_DEBUG("[ConfigManager] Opening config file: %s", _filename.c_str());
 
   File file = SPIFFS.open(_filename, FILE_READ);
   if (!file || file.isDirectory()) {
@@ -21,7 +21,7 @@ void ConfigManager::begin(String filename) {
     Serial.print("[ConfigManager] ❌ Failed to parse config file: ");
     Serial.println(error.c_str());
   } else {
-    BaseComponent::debugLog("[ConfigManager] ✅ Config loaded");
+    LOG_DEBUG("[ConfigManager] ✅ Config loaded");
   }
 }
 
@@ -35,14 +35,14 @@ void ConfigManager::writeConfig() {
   if (serializeJson(doc, file) == 0) {
     Serial.println("[ConfigManager] ❌ Failed to write to file");
   } else {
-    BaseComponent::debugLog("[ConfigManager] ✅ Settings saved to " + _filename);
+    LOG_DEBUG("[ConfigManager] ✅ Settings saved to %s", _filename.c_str());
   }
 
   file.close();
 }
 
 void ConfigManager::reset() {
-  BaseComponent::debugLog("[ConfigManager] Resetting config file: " + _filename);
+  LOG_DEBUG("[ConfigManager] Resetting config file: %s", _filename.c_str());
   File configFile = SPIFFS.open(_filename, FILE_WRITE);
   if (!configFile) return;
   configFile.print("{}");
@@ -50,7 +50,7 @@ void ConfigManager::reset() {
 }
 
 String ConfigManager::renderHtml(String htmlFilename) {
-  BaseComponent::debugLog("[ConfigManager] Rendering HTML from: " + htmlFilename);
+  LOG_DEBUG("[ConfigManager] Rendering HTML from: %s", htmlFilename.c_str());
   File file = SPIFFS.open(htmlFilename, FILE_READ);
   if (!file || file.isDirectory()) {
     return "<h1>" + htmlFilename + " not found</h1>";
@@ -69,7 +69,7 @@ void ConfigManager::syncValuesFrom(const JsonObject& patch) {
     JsonVariant target = getNested(doc.as<JsonObject>(), key);
     if (!target.isNull() && target.containsKey("value")) {
       target["value"] = value;
-      BaseComponent::debugLog("[ConfigManager] Updated key: " + String(key));
+      LOG_DEBUG("[ConfigManager] Updated key: %s", key);
     } else {
       Serial.printf("[ConfigManager] ⚠️ Key not found or missing 'value': %s\n", key);
     }
@@ -122,7 +122,7 @@ ApiConfig ConfigManager::getCameraApiConfig(const ConfigNode& node) {
   return ApiConfig{
     node.get<String>("scheme.value"),
     node.get<String>("ip.value"),
-    node.get<int>("port.value"),
+    node.get<uint16_t>("port.value"),
     node.get<String>("path.value")
   };
 }
@@ -142,6 +142,10 @@ std::vector<OverlayConfig> ConfigManager::getOverlayConfigList(const ConfigNode&
       overlayNode.get<int>("fontSize.value"),
       overlayNode.get<String>("textColor.value")
     });
+    // Optional: configs saved before the setting existed stay in °F
+    if (overlayNode.has("unit.value") && overlayNode.get<String>("unit.value") == unitSymbol(TemperatureUnit::Celsius)) {
+      overlays.back().unit = TemperatureUnit::Celsius;
+    }
   }
 
   return overlays;
@@ -176,7 +180,7 @@ void ConfigManager::updateSensorList(const std::vector<String>& sensorList) {
     sensorsArray.clear();
 
     for (const String& sensor : sensorList) {
-      BaseComponent::debugLog("[ConfigManager] Adding sensor: " + sensor);
+      LOG_DEBUG("[ConfigManager] Adding sensor: %s", sensor.c_str());
       sensorsArray.add(sensor);
     }
 
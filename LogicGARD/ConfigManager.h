@@ -17,7 +17,6 @@ public:
   void begin(String filename = "/user.json");
   void writeConfig() override;
   void reset() override;
-  bool updateFromJsonString(String source) override;
   String renderHtml(String htmlFilename = "/user.html") override;
   void syncValuesFrom(const JsonObject& patch) override;
   bool isConfigured() override;
@@ -42,7 +41,6 @@ public:
 
 private:
   StaticJsonDocument<7168> doc;
-  String _filename;
 
   JsonVariant getNested(JsonObject root, const char* path) const;
   std::vector<OverlayConfig> getOverlayConfigList(const ConfigNode& node);
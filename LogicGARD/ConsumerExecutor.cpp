@@ -0,0 +1,57 @@
+#include "ConsumerExecutor.h"
+#include "MessageConsumer.h"
+
+QueueHandle_t ConsumerExecutor::ready = nullptr;
+std::atomic<size_t> ConsumerExecutor::attached{0};
+
+void ConsumerExecutor::begin(size_t workerCount, uint32_t stackSize) {
+  if (ready) return;
+
+  // Each attached consumer is queued at most once, so this can never fill up
+  ready = xQueueCreate(MAX_CONSUMERS, sizeof(MessageConsumer*));
+  if (!ready) {
+    Serial.println("[Executor] ❌ Failed to create ready queue");
+    return;
+  }
+
+  for (size_t i = 0; i < workerCount; ++i) {
+    char name[16];
+    snprintf(name, sizeof(name), "ConsumerWorker%u", (unsigned)i);
+    if (xTaskCreate(workerTask, name, stackSize, nullptr, 1, nullptr) != pdPASS) {
+      Serial.printf("[Executor] ❌ Failed to start worker %u\n", (unsigned)i);
+    }
+  }
+  LOG_DEBUG("[Executor] Started %u worker(s)", (unsigned)workerCount);
+}
+
+bool ConsumerExecutor::attach() {
+  size_t count = attached.load();
+  do {
+    if (count >= MAX_CONSUMERS) {
+      Serial.printf("[Executor] ❌ Consumer limit (%u) reached\n", (unsigned)MAX_CONSUMERS);
+      return false;
+    }
+  } while (!attached.compare_exchange_weak(count, count + 1));
+  return true;
+}
+
+void ConsumerExecutor::detach() {
+  attached.fetch_sub(1);
+}
+
+bool ConsumerExecutor::schedule(MessageConsumer* consumer) {
+  if (!ready || xQueueSend(ready, &consumer, 0) != pdTRUE) {
+    Serial.println("[Executor] ❌ Ready queue unavailable, consumer not scheduled");
+    return false;
+  }
+  return true;
+}
+
+void ConsumerExecutor::workerTask(void*) {
+  MessageConsumer* consumer;
+  for (;;) {
+    if (xQueueReceive(ready, &consumer, portMAX_DELAY)) {
+      consumer->drain(DRAIN_BUDGET);
+    }
+  }
+}
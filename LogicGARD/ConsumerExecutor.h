@@ -0,0 +1,45 @@
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "BaseComponent.h"
+
+class MessageConsumer;
+
+// Small fixed pool of worker tasks shared by all MessageConsumers.
+//
+// A consumer with pending messages is put on the ready queue once (its
+// `scheduled` flag guards against duplicates), so at most one worker runs
+// a given consumer at a time and its messages stay in order. A worker
+// processes at most DRAIN_BUDGET messages before re-queueing the consumer
+// behind the others, so one busy sensor cannot starve the rest.
+//
+// The ready queue holds one slot per consumer, so consumers must attach()
+// in begin(); past MAX_CONSUMERS the consumer is refused rather than left
+// to fail scheduling later. A consumer that goes away detach()es in end().
+class ConsumerExecutor {
+public:
+  static constexpr LogTag logTag = LogTag::Consumer;
+
+  static constexpr size_t MAX_CONSUMERS = 64;
+  static constexpr size_t DRAIN_BUDGET = 4;
+
+  static void begin(size_t workerCount = 2, uint32_t stackSize = 6144);
+
+  // Claims a ready-queue slot for a new consumer; false once all are taken
+  static bool attach();
+  // Returns a slot; the consumer must no longer be on the ready queue
+  static void detach();
+  static size_t consumerCount() { return attached.load(); }
+
+  // Queues a consumer for a worker. Callers must own its scheduled flag.
+  static bool schedule(MessageConsumer* consumer);
+
+private:
+  static void workerTask(void* param);
+
+  static QueueHandle_t ready;
+  static std::atomic<size_t> attached;
+};
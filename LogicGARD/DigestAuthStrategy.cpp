@@ -1,43 +1,61 @@
 #include "DigestAuthStrategy.h"
 #include <MD5Builder.h>
 
-DigestAuthStrategy::DigestAuthStrategy(const AuthCredentials& creds)
-  : AuthStrategy(creds) {}
+DigestAuthStrategy::DigestAuthStrategy(const AuthCredentials& creds,
+                                       std::shared_ptr<HttpConnectionPool> pool)
+  : AuthStrategy(creds, pool) {}
 
-bool DigestAuthStrategy::post(const String& payload, String* responseOut, const ApiConfig& config) {
+bool DigestAuthStrategy::postOn(HttpConnectionPool::Lease& connection, const String& payload,
+                                String* responseOut, const ApiConfig& config) {
   String url = config.fullUrl();
-  String challengeResponse;
-
-  int challengeCode = httpClient->performPost(url, "", "", &challengeResponse);
-  String authHeader = httpClient->get().header("WWW-Authenticate");
 
-  if (authHeader.isEmpty()) {
-    BaseComponent::debugLog("Error: Challenge failed or header missing.");
+  if (nonce.isEmpty() && !requestChallenge(connection, url)) {
     return false;
   }
 
-  parseChallenge(authHeader);
+  int finalCode = connection->performPost(url, payload, getAuthHeader("POST", config.path), responseOut);
 
-  if (realm.isEmpty() || nonce.isEmpty() || qop.isEmpty()) {
-    BaseComponent::debugLog("Error: Missing required digest fields.");
-    return false;
-  }
+  if (finalCode == 401) {
+    // Expired (stale) or unknown nonce: take the fresh challenge from this
+    // reply, or ask for one, and retry once.
+    LOG_DEBUG("Digest: 401 with cached nonce, re-challenging");
+    bool rechallenged = parseChallenge(connection->get().header("WWW-Authenticate")) ||
+                        requestChallenge(connection, url);
+    if (!rechallenged) return false;
 
-  String digestHeader = getAuthHeader("POST", config.path);
-  int finalCode = httpClient->performPost(url, payload, digestHeader, responseOut);
+    finalCode = connection->performPost(url, payload, getAuthHeader("POST", config.path), responseOut);
+  }
 
   if (finalCode != 200) {
-    BaseComponent::debugLog("Error: Final response code = " + String(finalCode));
+    LOG_DEBUG("Error: Final response code = %d", finalCode);
+    if (finalCode == 401) nonce = String();
   }
 
   return finalCode == 200;
 }
 
+bool DigestAuthStrategy::requestChallenge(HttpConnectionPool::Lease& connection, const String& url) {
+  String challengeResponse;
+  connection->performPost(url, "", "", &challengeResponse);
+
+  String authHeader = connection->get().header("WWW-Authenticate");
+  if (authHeader.isEmpty()) {
+    LOG_DEBUG("Error: Challenge failed or header missing.");
+    return false;
+  }
+
+  if (!parseChallenge(authHeader)) {
+    LOG_DEBUG("Error: Missing required digest fields.");
+    return false;
+  }
+  return true;
+}
+
 String DigestAuthStrategy::getAuthHeader(String method, String uri) {
-  String nc = "00000001";
+  char nc[9];
+  snprintf(nc, sizeof(nc), "%08lx", static_cast<unsigned long>(++nonceCount));
   String cnonce = String(random(100000, 999999), HEX);
 
-  String ha1 = md5(credentials.username + ":" + realm + ":" + credentials.password);
   String ha2 = md5(method + ":" + uri);
   String response = md5(ha1 + ":" + nonce + ":" + nc + ":" + cnonce + ":" + qop + ":" + ha2);
 
@@ -54,21 +72,26 @@ String DigestAuthStrategy::getAuthHeader(String method, String uri) {
     header += ", opaque=\"" + opaque + "\"";
   }
 
-  BaseComponent::debugLog("Generated Digest header: " + header);
+  LOG_DEBUG("Generated Digest header: %s", header.c_str());
   return header;
 }
 
-void DigestAuthStrategy::parseChallenge(String header) {
+// Returns true when the header held a usable challenge, which then
+// replaces the cached one.
+bool DigestAuthStrategy::parseChallenge(String header) {
   int idx = header.indexOf("Digest ");
   if (idx == -1) {
-    BaseComponent::debugLog("Error: No Digest prefix found.");
-    return;
+    LOG_DEBUG("Error: No Digest prefix found.");
+    return false;
   }
 
+  String newRealm, newNonce, newQop, newOpaque;
+  bool stale = false;
+
   String digestPart = header.substring(idx + 7);
   digestPart.trim();
 
-  int pos = 0;
+  unsigned int pos = 0;
   while (pos < digestPart.length()) {
     int eq = digestPart.indexOf('=', pos);
     if (eq == -1) break;
@@ -80,6 +103,7 @@ void DigestAuthStrategy::parseChallenge(String header) {
     if (digestPart.charAt(valStart) == '"') {
       valStart++;
       int valEnd = digestPart.indexOf('"', valStart);
+      if (valEnd == -1) break;
       value = digestPart.substring(valStart, valEnd);
       pos = valEnd + 1;
     } else {
@@ -91,10 +115,11 @@ void DigestAuthStrategy::parseChallenge(String header) {
 
     key.toLowerCase();
 
-    if (key == "realm") realm = value;
-    else if (key == "nonce") nonce = value;
-    else if (key == "qop") qop = value;
-    else if (key == "opaque") opaque = value;
+    if (key == "realm") newRealm = value;
+    else if (key == "nonce") newNonce = value;
+    else if (key == "qop") newQop = value;
+    else if (key == "opaque") newOpaque = value;
+    else if (key == "stale") stale = value.equalsIgnoreCase("true");
 
     while (pos < digestPart.length() &&
            (digestPart.charAt(pos) == ',' || digestPart.charAt(pos) == ' ')) {
@@ -102,7 +127,45 @@ void DigestAuthStrategy::parseChallenge(String header) {
     }
   }
 
-  BaseComponent::debugLog("Parsed challenge: realm=" + realm + ", nonce=" + nonce + ", qop=" + qop + ", opaque=" + opaque);
+  if (newRealm.isEmpty() || newNonce.isEmpty() || newQop.isEmpty()) {
+    return false;
+  }
+
+  // Servers may offer "auth,auth-int"; only auth is implemented
+  if (!offersQopAuth(newQop)) {
+    LOG_DEBUG("Error: Server offers qop=%s, only auth is supported", newQop.c_str());
+    return false;
+  }
+  newQop = "auth";
+
+  if (newRealm != realm || ha1.isEmpty()) {
+    ha1 = md5(credentials.username + ":" + newRealm + ":" + credentials.password);
+  }
+
+  realm = newRealm;
+  nonce = newNonce;
+  qop = newQop;
+  opaque = newOpaque;
+  nonceCount = 0;
+
+  LOG_DEBUG("Parsed challenge: realm=%s, nonce=%s, qop=%s, opaque=%s, stale=%d",
+            realm.c_str(), nonce.c_str(), qop.c_str(), opaque.c_str(), stale);
+  return true;
+}
+
+// qop is a comma-separated list of tokens; "auth" must be one of them, not
+// merely a prefix of one such as "auth-int"
+bool DigestAuthStrategy::offersQopAuth(const String& qopOptions) {
+  int start = 0;
+  while (start <= static_cast<int>(qopOptions.length())) {
+    int end = qopOptions.indexOf(',', start);
+    if (end == -1) end = qopOptions.length();
+    String token = qopOptions.substring(start, end);
+    token.trim();
+    if (token == "auth") return true;
+    start = end + 1;
+  }
+  return false;
 }
 
 String DigestAuthStrategy::md5(String input) {
@@ -1,18 +1,27 @@
 #pragma once
 #include "AuthStrategy.h"
-#include "HttpClientWrapper.h"
+#include "HttpConnectionPool.h"
 #include "Types.h"
 
 class DigestAuthStrategy : public AuthStrategy {
 public:
-  DigestAuthStrategy(const AuthCredentials& creds);
+  DigestAuthStrategy(const AuthCredentials& creds,
+                     std::shared_ptr<HttpConnectionPool> pool = nullptr);
 
-  bool post(const String& payload, String* responseOut, const ApiConfig& config);
+protected:
+  bool postOn(HttpConnectionPool::Lease& connection, const String& payload,
+              String* responseOut, const ApiConfig& config) override;
 
 private:
   String getAuthHeader(String method, String uri);
-  void parseChallenge(String header);
+  bool requestChallenge(HttpConnectionPool::Lease& connection, const String& url);
+  bool parseChallenge(String header);
+  static bool offersQopAuth(const String& qopOptions);
   String md5(String input);
 
+  // Challenge state reused across requests (RFC 7616 §3.4): a new nonce
+  // is fetched only when the server answers 401, e.g. with stale=true.
   String realm, nonce, qop, opaque;
+  String ha1;               // MD5(username:realm:password), per realm
+  uint32_t nonceCount = 0;  // Requests sent with the current nonce
 };
\ No newline at end of file
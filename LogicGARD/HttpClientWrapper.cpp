@@ -1,56 +1,69 @@
 #include "HttpClientWrapper.h"
 
 HttpClientWrapper::HttpClientWrapper() {
-  client = std::make_unique<HTTPClient>();
-  mutex = xSemaphoreCreateMutex();
-  if (!mutex) {
-    BaseComponent::debugLog("[HttpClientWrapper] ❌ Failed to create mutex");
-  }
+  client.setReuse(true);
+  // No CA is configured for cameras, so https is encrypted but not
+  // verified, the same as HTTPClient::begin(url) without a certificate
+  tls.setInsecure();
 }
 
 HTTPClient& HttpClientWrapper::get() {
-  if (!client) {
-    client = std::make_unique<HTTPClient>();
-    usageCount = 0;
-  }
-  return *client;
+  return client;
+}
+
+bool HttpClientWrapper::isValid() const {
+  return !failed || millis() - lastFailure >= FAILURE_BACKOFF_MS;
+}
+
+WiFiClient& HttpClientWrapper::transportFor(const String& url) {
+  WiFiClient& transport = url.startsWith("https://") ? static_cast<WiFiClient&>(tls) : tcp;
+  if (active && active != &transport) active->stop();
+  active = &transport;
+  return transport;
 }
 
 int HttpClientWrapper::performPost(const String& url, const String& payload, const String& authHeader, String* responseOut) {
-  if (!client) {
-    client = std::make_unique<HTTPClient>();
-    usageCount = 0;
+  WiFiClient& transport = transportFor(url);
+  if (transport.connected() && millis() - lastUsed > IDLE_TIMEOUT_MS) {
+    LOG_DEBUG("[HttpClientWrapper] ⏱️ Closing idle connection");
+    transport.stop();
   }
 
-  BaseComponent::debugLog("[HttpClientWrapper] ➡️ Performing POST to: " + url);
+  bool reused = transport.connected();
+  if (!reused) ++opened;
+
+  LOG_DEBUG("[HttpClientWrapper] ➡️ Performing POST to: %s (%s connection)", url.c_str(), reused ? "reused" : "new");
 
-  client->begin(url);
-  client->addHeader("Content-Type", "application/json");
+  // Passing our own client keeps the socket alive across end()
+  client.begin(transport, url);
+  client.addHeader("Content-Type", "application/json");
   
-  if (authHeader.isEmpty()) {
-    const char* headersToCollect[] = { "WWW-Authenticate" };
-    client->collectHeaders(headersToCollect, 1);
-  } else {
-    client->addHeader("Authorization", authHeader);
+  // Collected on authenticated requests too: a 401 carries the new challenge
+  const char* headersToCollect[] = { "WWW-Authenticate" };
+  client.collectHeaders(headersToCollect, 1);
+  if (!authHeader.isEmpty()) {
+    client.addHeader("Authorization", authHeader);
   }
 
-  int code = client->POST(payload);
-  String response = client->getString();
-  client->end();
+  int code = client.POST(payload);
+  // Reading the whole body is what leaves the connection reusable
+  String response = client.getString();
+  client.end();
 
-  usageCount++;
   lastUsed = millis();
 
-  if (code <= 0 || code >= 500 || usageCount >= MAX_USAGE) {
-    client.reset();
-    usageCount = 0;
-    BaseComponent::debugLog("[HttpClientWrapper] 🔄 httpClient has been reset");
+  // Negative codes are connect/transport errors, not HTTP responses
+  failed = code <= 0;
+  if (failed) lastFailure = lastUsed;
+
+  if (code <= 0 || code >= 500) {
+    transport.stop();
+    LOG_DEBUG("[HttpClientWrapper] 🔄 Connection dropped after code %d", code);
   }
 
   if (responseOut) {
     *responseOut = response;
   }
 
-  xSemaphoreGive(mutex);
   return code;
-}
\ No newline at end of file
+}
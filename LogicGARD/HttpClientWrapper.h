@@ -1,23 +1,40 @@
 #pragma once
 #include <Arduino.h>
 #include <HTTPClient.h>
-#include <memory>
-#include <freertos/FreeRTOS.h>
-#include <freertos/semphr.h>
+#include <WiFiClient.h>
+#include <WiFiClientSecure.h>
 #include "BaseComponent.h"
 
+// One keep-alive HTTP connection. Not thread-safe on its own: callers get
+// exclusive use through an HttpConnectionPool lease.
 class HttpClientWrapper : public BaseComponent {
 public:
+  static constexpr LogTag logTag = LogTag::Http;
+
+  // Cameras drop idle keep-alive sockets after a few seconds; reconnect
+  // ourselves rather than find out from a failed write.
+  static constexpr uint32_t IDLE_TIMEOUT_MS = 10000;
+  static constexpr uint32_t FAILURE_BACKOFF_MS = 2000;
+
   HttpClientWrapper();
   HTTPClient& get();
+  // False after a transport failure until the backoff has passed, so
+  // callers fail fast instead of blocking on connect timeouts
   bool isValid() const;
 
   int performPost(const String& url, const String& payload, const String& authHeader = "", String* responseOut = nullptr);
 
+  uint32_t connectionsOpened() const { return opened; }
+
 private:
-  std::unique_ptr<HTTPClient> client;
-  SemaphoreHandle_t mutex;
+  WiFiClient& transportFor(const String& url);
+
+  WiFiClient tcp;
+  WiFiClientSecure tls;         // Used for https:// URLs
+  WiFiClient* active = nullptr; // Transport of the last request
+  HTTPClient client;
   uint32_t lastUsed = 0;
-  int usageCount = 0;
-  static constexpr int MAX_USAGE = 10;
-};
\ No newline at end of file
+  uint32_t opened = 0;
+  uint32_t lastFailure = 0;
+  bool failed = false;
+};
@@ -0,0 +1,76 @@
+#include "HttpConnectionPool.h"
+#include <freertos/semphr.h>
+
+namespace {
+struct PoolEntry {
+  String key;
+  std::weak_ptr<HttpConnectionPool> pool;
+};
+
+std::vector<PoolEntry> pools;
+
+SemaphoreHandle_t poolsLock() {
+  static SemaphoreHandle_t lock = xSemaphoreCreateMutex();
+  return lock;
+}
+}
+
+HttpConnectionPool::HttpConnectionPool(size_t size) {
+  available = xQueueCreate(size, sizeof(uint8_t));
+  if (!available) {
+    Serial.println("[Http] ❌ Failed to create connection pool queue");
+    return;
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    connections.push_back(std::make_unique<HttpClientWrapper>());
+    uint8_t index = static_cast<uint8_t>(i);
+    xQueueSend(available, &index, 0);
+  }
+}
+
+HttpConnectionPool::~HttpConnectionPool() {
+  if (available) vQueueDelete(available);
+}
+
+HttpConnectionPool::Lease HttpConnectionPool::acquire() {
+  uint8_t index;
+  if (!available || xQueueReceive(available, &index, portMAX_DELAY) != pdTRUE) {
+    return Lease(nullptr, 0);
+  }
+  return Lease(this, index);
+}
+
+void HttpConnectionPool::release(uint8_t index) {
+  xQueueSend(available, &index, 0);
+}
+
+std::shared_ptr<HttpConnectionPool> HttpConnectionPool::forHost(const String& scheme, const String& host, uint16_t port) {
+  String key = scheme + "://" + host + ":" + String(port);
+  std::shared_ptr<HttpConnectionPool> pool;
+
+  SemaphoreHandle_t lock = poolsLock();
+  if (!lock || !xSemaphoreTake(lock, portMAX_DELAY)) {
+    return std::make_shared<HttpConnectionPool>();
+  }
+
+  for (auto& entry : pools) {
+    if (entry.key == key) {
+      pool = entry.pool.lock();
+      if (!pool) {
+        pool = std::make_shared<HttpConnectionPool>();
+        entry.pool = pool;
+      }
+      break;
+    }
+  }
+
+  if (!pool) {
+    pool = std::make_shared<HttpConnectionPool>();
+    pools.push_back({ key, pool });
+    LOG_DEBUG("[Http] Created connection pool for %s", key.c_str());
+  }
+
+  xSemaphoreGive(lock);
+  return pool;
+}
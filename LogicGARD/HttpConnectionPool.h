@@ -0,0 +1,50 @@
+#pragma once
+#include <Arduino.h>
+#include <memory>
+#include <vector>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "HttpClientWrapper.h"
+#include "BaseComponent.h"
+
+// Fixed set of keep-alive connections to one host. acquire() blocks until
+// a connection is free and returns a lease that hands it back when
+// destroyed, so a request sequence (e.g. Digest challenge then post) runs
+// on one socket without interleaving with other users.
+class HttpConnectionPool : public BaseComponent {
+public:
+  static constexpr LogTag logTag = LogTag::Http;
+
+  static constexpr size_t DEFAULT_SIZE = 2;
+
+  class Lease {
+  public:
+    Lease(HttpConnectionPool* pool, uint8_t index) : pool(pool), index(index) {}
+    Lease(Lease&& other) : pool(other.pool), index(other.index) { other.pool = nullptr; }
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    ~Lease() { if (pool) pool->release(index); }
+
+    explicit operator bool() const { return pool != nullptr; }
+    HttpClientWrapper* operator->() const { return pool->connections[index].get(); }
+
+  private:
+    HttpConnectionPool* pool;
+    uint8_t index;
+  };
+
+  explicit HttpConnectionPool(size_t size = DEFAULT_SIZE);
+  ~HttpConnectionPool();
+
+  Lease acquire();
+
+  // Returns the pool shared by every client of scheme://host:port,
+  // creating it on first use.
+  static std::shared_ptr<HttpConnectionPool> forHost(const String& scheme, const String& host, uint16_t port);
+
+private:
+  void release(uint8_t index);
+
+  std::vector<std::unique_ptr<HttpClientWrapper>> connections;
+  QueueHandle_t available = nullptr;   // Indices of idle connections
+};
@@ -0,0 +1,88 @@
+#include "I2cBus.h"
+
+std::unique_ptr<I2cBus> I2cBus::buses[MAX_BUSES];
+
+I2cBus::Lock::Lock(I2cBus& bus)
+  : bus(bus), held(bus.mutex && xSemaphoreTake(bus.mutex, pdMS_TO_TICKS(LOCK_TIMEOUT_MS)) == pdTRUE) {
+  if (!held) ++bus.lockTimeouts;
+}
+
+I2cBus::Lock::~Lock() {
+  if (held) xSemaphoreGive(bus.mutex);
+}
+
+I2cBus::I2cBus(TwoWire& wire, int sdaPin, int sclPin)
+  : wire(wire), sdaPin(sdaPin), sclPin(sclPin), mutex(xSemaphoreCreateMutex()) {
+  wire.begin(sdaPin, sclPin);
+}
+
+I2cBus* I2cBus::forPins(int sdaPin, int sclPin) {
+  static TwoWire* const controllers[MAX_BUSES] = { &Wire, &Wire1 };
+
+  for (size_t i = 0; i < MAX_BUSES; ++i) {
+    if (!buses[i]) {
+      buses[i].reset(new I2cBus(*controllers[i], sdaPin, sclPin));
+      LOG_DEBUG("[I2C] Bus %u started on SDA=%d SCL=%d", (unsigned)i, sdaPin, sclPin);
+      return buses[i].get();
+    }
+    if (buses[i]->sdaPin == sdaPin && buses[i]->sclPin == sclPin) {
+      return buses[i].get();
+    }
+  }
+
+  Serial.printf("[I2C] ❌ No free I2C controller for SDA=%d SCL=%d\r\n", sdaPin, sclPin);
+  return nullptr;
+}
+
+bool I2cBus::claim(uint8_t address) {
+  if (address > 0x7F) return false;
+  uint32_t bit = 1u << (address & 31);
+  uint32_t& word = claimed[address >> 5];
+  if (word & bit) return false;
+  word |= bit;
+  return true;
+}
+
+bool I2cBus::writeRegister(uint8_t address, uint8_t reg, uint8_t value) {
+  Lock lock(*this);
+  if (!lock) return false;
+
+  wire.beginTransmission(address);
+  wire.write(reg);
+  wire.write(value);
+  bool ok = wire.endTransmission() == 0;
+  recordResult(ok);
+  return ok;
+}
+
+// Register pointer write, repeated start, then one burst read
+bool I2cBus::readRegisters(uint8_t address, uint8_t reg, uint8_t* out, size_t len) {
+  Lock lock(*this);
+  if (!lock) return false;
+
+  wire.beginTransmission(address);
+  wire.write(reg);
+  bool ok = wire.endTransmission(false) == 0 &&
+            wire.requestFrom(address, static_cast<uint8_t>(len)) == len;
+  for (size_t i = 0; ok && i < len; ++i) {
+    out[i] = static_cast<uint8_t>(wire.read());
+  }
+  recordResult(ok);
+  return ok;
+}
+
+// Only called with the bus mutex held
+void I2cBus::recordResult(bool ok) {
+  ++transactions;
+  if (!ok) ++errors;
+}
+
+void I2cBus::logStats() {
+  for (size_t i = 0; i < MAX_BUSES; ++i) {
+    const I2cBus* bus = buses[i].get();
+    if (!bus) continue;
+    LOG_INFO("[I2C] Bus %u (SDA=%d SCL=%d): %lu transactions, %lu errors, %lu lock timeouts",
+             (unsigned)i, bus->sdaPin, bus->sclPin, (unsigned long)bus->transactions,
+             (unsigned long)bus->errors, (unsigned long)bus->lockTimeouts.load());
+  }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <Arduino.h>
+#include <Wire.h>
+#include <atomic>
+#include <memory>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "BaseComponent.h"
+
+// One physical I2C bus, shared by every device wired to the same SDA/SCL
+// pair. The ESP32 has two controllers, so forPins() hands the first two
+// distinct pairs Wire and Wire1. A mutex serializes transactions from the
+// sensor scheduler, the RTC and anything else: simple drivers use the
+// register helpers, library-backed ones hold a Lock around their calls.
+// Failed transactions and lock timeouts are counted for logStats().
+class I2cBus : public BaseComponent {
+public:
+  static constexpr LogTag logTag = LogTag::Sensor;
+
+  static constexpr size_t MAX_BUSES = 2;
+  static constexpr uint32_t LOCK_TIMEOUT_MS = 100;
+
+  class Lock {
+  public:
+    explicit Lock(I2cBus& bus);
+    Lock(const Lock&) = delete;
+    Lock& operator=(const Lock&) = delete;
+    ~Lock();
+
+    explicit operator bool() const { return held; }
+    TwoWire& wire() const { return bus.wire; }
+
+  private:
+    I2cBus& bus;
+    bool held;
+  };
+
+  // Returns the bus on these pins, starting its controller on first use,
+  // or nullptr once both controllers are taken. Call during setup.
+  static I2cBus* forPins(int sdaPin, int sclPin);
+  static void logStats();
+
+  // Reserves an address for one driver; false if another already has it
+  bool claim(uint8_t address);
+
+  bool writeRegister(uint8_t address, uint8_t reg, uint8_t value);
+  bool readRegisters(uint8_t address, uint8_t reg, uint8_t* out, size_t len);
+
+  // For Lock holders that talk to the device through a library
+  void recordResult(bool ok);
+
+  int getSdaPin() const { return sdaPin; }
+  int getSclPin() const { return sclPin; }
+
+private:
+  I2cBus(TwoWire& wire, int sdaPin, int sclPin);
+
+  TwoWire& wire;
+  int sdaPin;
+  int sclPin;
+  SemaphoreHandle_t mutex;
+  uint32_t claimed[4] = {};      // Bit per 7-bit address
+  uint32_t transactions = 0;     // Counted with the mutex held
+  uint32_t errors = 0;
+  std::atomic<uint32_t> lockTimeouts{0};   // Counted by callers that failed to get it
+
+  static std::unique_ptr<I2cBus> buses[MAX_BUSES];
+};
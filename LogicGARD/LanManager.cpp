@@ -11,7 +11,7 @@
 
 void LanManager::begin(const NetworkConfig& config) {
   netConfig = config;
-  BaseComponent::debugLog("LanManager::begin - Connection type: " + config.connectionTypeName());
+  LOG_DEBUG("LanManager::begin - Connection type: %s", config.connectionTypeName().c_str());
 
   if (transportClient) {
     delete transportClient;
@@ -23,11 +23,11 @@ void LanManager::begin(const NetworkConfig& config) {
   } else if (config.connectionType == ConnectionType::WIFI) {
     setupWiFi();
   } else {
-    BaseComponent::debugLog("LanManager::begin - ❌ Unknown connection type.");
+    LOG_DEBUG("LanManager::begin - ❌ Unknown connection type.");
   }
 
   IPAddress ip = getLocalIP();
-  BaseComponent::debugLog("LanManager::begin - Final IP: " + ip.toString());
+  LOG_DEBUG("LanManager::begin - Final IP: %s", ip.toString().c_str());
 
   int waitAttempts = 0;
   while ((ip == IPAddress(0, 0, 0, 0) || ip == IPAddress(255, 255, 255, 255)) && waitAttempts < 20) {
@@ -39,12 +39,12 @@ void LanManager::begin(const NetworkConfig& config) {
   delay(3000);  // Allow LWIP internals to settle
 
   if (!checkInternetConnectivity()) {
-    BaseComponent::debugLog("[LanManager] ❌ No internet. Restarting...");
+    LOG_DEBUG("[LanManager] ❌ No internet. Restarting...");
     delay(1000);
     ESP.restart();
   }
 
-  BaseComponent::debugLog("[LanManager] ✅ Internet connectivity verified.");
+  LOG_DEBUG("[LanManager] ✅ Internet connectivity verified.");
 }
 
 bool LanManager::isConnected() const {
@@ -65,7 +65,7 @@ Client* LanManager::getClient() const {
 }
 
 void LanManager::setupLAN() {
-  BaseComponent::debugLog("LanManager::setupLAN - Initializing native Ethernet (LAN8720)");
+  LOG_DEBUG("LanManager::setupLAN - Initializing native Ethernet (LAN8720)");
 
   ETH.begin();  // Uses default PHY config from defines
 
@@ -80,14 +80,14 @@ void LanManager::setupLAN() {
 
   if (connected) {
     transportClient = new WiFiClient();  // Works for both WiFi and native ETH
-    BaseComponent::debugLog("LanManager::setupLAN - ✅ Connected. IP: " + ip.toString());
+    LOG_DEBUG("LanManager::setupLAN - ✅ Connected. IP: %s", ip.toString().c_str());
   } else {
-    BaseComponent::debugLog("LanManager::setupLAN - ❌ Failed to connect via LAN. IP: " + ip.toString());
+    LOG_DEBUG("LanManager::setupLAN - ❌ Failed to connect via LAN. IP: %s", ip.toString().c_str());
   }
 }
 
 void LanManager::setupWiFi() {
-  BaseComponent::debugLog("LanManager::setupWiFi - Connecting to SSID: " + netConfig.ssid);
+  LOG_DEBUG("LanManager::setupWiFi - Connecting to SSID: %s", netConfig.ssid.c_str());
   WiFi.mode(WIFI_STA);
   WiFi.begin(netConfig.ssid.c_str(), netConfig.password.c_str());
 
@@ -102,9 +102,9 @@ void LanManager::setupWiFi() {
 
   if (connected) {
     transportClient = new WiFiClient();
-    BaseComponent::debugLog("LanManager::setupWiFi - ✅ Connected. IP: " + WiFi.localIP().toString());
+    LOG_DEBUG("LanManager::setupWiFi - ✅ Connected. IP: %s", WiFi.localIP().toString().c_str());
   } else {
-    BaseComponent::debugLog("LanManager::setupWiFi - ❌ Failed to connect to WiFi.");
+    LOG_DEBUG("LanManager::setupWiFi - ❌ Failed to connect to WiFi.");
   }
 }
 
@@ -114,21 +114,21 @@ bool LanManager::checkInternetConnectivity() {
   const int maxAttempts = 3;
   const int delayMs = 500;
 
-  BaseComponent::debugLog("[Network] 🌐 Checking internet connectivity via TCP to example.com");
+  LOG_DEBUG("[Network] 🌐 Checking internet connectivity via TCP to example.com");
 
   for (int i = 0; i < maxAttempts; ++i) {
     transportClient->setTimeout(5000);
 
     if (transportClient->connect(host, port)) {
       transportClient->stop();
-      BaseComponent::debugLog("[Network] ✅ TCP connection succeeded");
+      LOG_DEBUG("[Network] ✅ TCP connection succeeded");
       return true;
     }
 
-    BaseComponent::debugLog("[Network] ❌ TCP connection to example.com failed (attempt " + String(i + 1) + ")");
+    LOG_DEBUG("[Network] ❌ TCP connection to example.com failed (attempt %d)", i + 1);
     delay(delayMs);
   }
 
-  BaseComponent::debugLog("[Network] ❌ All attempts to connect to example.com failed");
+  LOG_DEBUG("[Network] ❌ All attempts to connect to example.com failed");
   return false;
 }
\ No newline at end of file
@@ -7,6 +7,8 @@
 
 class LanManager : public BaseComponent {
 public:
+  static constexpr LogTag logTag = LogTag::Network;
+
   void begin(const NetworkConfig& config);
   bool isConnected() const;
   IPAddress getLocalIP() const;
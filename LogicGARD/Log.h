@@ -0,0 +1,64 @@
+#pragma once
+#include <stdint.h>
+
+// ─────────────────────────────────────────────────────────────
+// Levels (compile-time stripping via LOG_COMPILE_LEVEL)
+// ─────────────────────────────────────────────────────────────
+
+#define LOG_LEVEL_NONE   0
+#define LOG_LEVEL_ERROR  1
+#define LOG_LEVEL_WARN   2
+#define LOG_LEVEL_INFO   3
+#define LOG_LEVEL_DEBUG  4
+
+// Build with -DLOG_COMPILE_LEVEL=LOG_LEVEL_INFO to drop all debug call sites.
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+// ─────────────────────────────────────────────────────────────
+// Components (runtime level per tag)
+// ─────────────────────────────────────────────────────────────
+
+enum class LogTag : uint8_t {
+  Core,
+  Config,
+  Network,
+  Time,
+  Sensor,
+  Dispatcher,
+  Consumer,
+  Mqtt,
+  Camera,
+  Overlay,
+  Http,
+  Ota,
+  Count
+};
+
+// Default tag for code outside a BaseComponent. Classes shadow it with their
+// own static logTag member, which the LOG_* macros pick up by name lookup.
+constexpr LogTag logTag = LogTag::Core;
+
+// Never called; lets the compiler check format strings against arguments,
+// which the variadic template in BaseComponent::log cannot do on its own.
+inline void logFormatCheck(const char*, ...) __attribute__((format(printf, 1, 2)));
+inline void logFormatCheck(const char*, ...) {}
+
+// ─────────────────────────────────────────────────────────────
+// Macros — arguments are only evaluated when the level is enabled
+// ─────────────────────────────────────────────────────────────
+
+#define LOG_AT(level, fmt, ...)                                          \
+  do {                                                                   \
+    if ((level) <= LOG_COMPILE_LEVEL &&                                  \
+        BaseComponent::logEnabled(logTag, (level))) {                    \
+      if (false) logFormatCheck(fmt, ##__VA_ARGS__);                     \
+      BaseComponent::log(logTag, (level), fmt, ##__VA_ARGS__);           \
+    }                                                                    \
+  } while (0)
+
+#define LOG_ERROR(fmt, ...) LOG_AT(LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#define LOG_WARN(fmt, ...)  LOG_AT(LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#define LOG_INFO(fmt, ...)  LOG_AT(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(fmt, ...) LOG_AT(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
@@ -0,0 +1,177 @@
+#include "LogRing.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+LogRing::Cell LogRing::cells[LOG_RING_SLOTS];
+std::atomic<uint32_t> LogRing::enqueuePos{0};
+uint32_t LogRing::dequeuePos = 0;
+std::atomic<uint32_t> LogRing::dropped{0};
+bool LogRing::running = false;
+
+namespace {
+const char* const levelPrefixes[] = { "", "[Error] ", "[Warn] ", "[Info] ", "[Debug] " };
+
+// Appends src to out at *pos without overflowing cap.
+void append(char* out, size_t cap, size_t& pos, const char* src, size_t len) {
+  if (pos + 1 >= cap) return;
+  size_t room = cap - 1 - pos;
+  if (len > room) len = room;
+  memcpy(out + pos, src, len);
+  pos += len;
+  out[pos] = '\0';
+}
+}
+
+size_t LogEvent::render(char* out, size_t cap) const {
+  if (!cap) return 0;
+  out[0] = '\0';
+
+  size_t pos = 0;
+  uint8_t next = 0;
+  const char* p = fmt;
+
+  while (*p) {
+    if (*p != '%') {
+      const char* start = p;
+      while (*p && *p != '%') ++p;
+      append(out, cap, pos, start, p - start);
+      continue;
+    }
+
+    if (p[1] == '%') {
+      append(out, cap, pos, "%", 1);
+      p += 2;
+      continue;
+    }
+
+    // Rebuild the conversion spec with the length modifier normalised to
+    // the width the argument was captured at.
+    char spec[16];
+    size_t s = 0;
+    spec[s++] = *p++;
+    while (*p && strchr("-+ #0", *p) && s < 8) spec[s++] = *p++;
+    while (*p && ((*p >= '0' && *p <= '9') || *p == '.') && s < 12) spec[s++] = *p++;
+    while (*p && strchr("hlLzjt", *p)) ++p;
+    char conv = *p;
+    if (!conv) break;
+    ++p;
+
+    char piece[64];
+    int written = 0;
+
+    if (next >= argc) {
+      written = snprintf(piece, sizeof(piece), "<?>");
+    } else if (strchr("diouxXc", conv)) {
+      if (conv == 'c') {
+        spec[s++] = 'c'; spec[s] = '\0';
+        written = snprintf(piece, sizeof(piece), spec, static_cast<int>(args[next].i));
+      } else {
+        spec[s++] = 'l'; spec[s++] = 'l'; spec[s++] = conv; spec[s] = '\0';
+        if (conv == 'd' || conv == 'i') {
+          long long v = types[next] == Unsigned ? static_cast<long long>(args[next].u) : args[next].i;
+          written = snprintf(piece, sizeof(piece), spec, v);
+        } else {
+          unsigned long long v = types[next] == Signed ? static_cast<unsigned long long>(args[next].i) : args[next].u;
+          written = snprintf(piece, sizeof(piece), spec, v);
+        }
+      }
+    } else if (strchr("fFeEgGaA", conv)) {
+      spec[s++] = conv; spec[s] = '\0';
+      written = snprintf(piece, sizeof(piece), spec, args[next].d);
+    } else if (conv == 'p') {
+      written = snprintf(piece, sizeof(piece), "%p", args[next].p);
+    } else if (conv == 's') {
+      // Strings may be longer than the scratch piece; copy directly.
+      const char* str = types[next] == Text ? text + args[next].textOffset : "<?>";
+      append(out, cap, pos, str, strlen(str));
+      ++next;
+      continue;
+    } else {
+      written = snprintf(piece, sizeof(piece), "<?>");
+    }
+
+    ++next;
+    if (written > 0) {
+      append(out, cap, pos, piece, strnlen(piece, sizeof(piece)));
+    }
+  }
+
+  return pos;
+}
+
+void LogRing::begin(uint32_t stackSize) {
+  if (running) return;
+  running = true;
+
+  for (uint32_t i = 0; i < LOG_RING_SLOTS; ++i) {
+    cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  enqueuePos.store(0, std::memory_order_relaxed);
+  dequeuePos = 0;
+
+  xTaskCreate(drainTask, "LogDrainTask", stackSize, nullptr, tskIDLE_PRIORITY, nullptr);
+}
+
+LogEvent* LogRing::claim(uint32_t& ticket) {
+  uint32_t pos = enqueuePos.load(std::memory_order_relaxed);
+  Cell* cell;
+
+  for (;;) {
+    cell = &cells[pos & (LOG_RING_SLOTS - 1)];
+    uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+    int32_t diff = static_cast<int32_t>(seq - pos);
+
+    if (diff == 0) {
+      if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+    } else if (diff < 0) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    } else {
+      pos = enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  ticket = pos;
+  return &cell->event;
+}
+
+void LogRing::commit(uint32_t ticket) {
+  cells[ticket & (LOG_RING_SLOTS - 1)].sequence.store(ticket + 1, std::memory_order_release);
+}
+
+// Writes the oldest committed event, if any, and frees its slot
+bool LogRing::drainOne() {
+  Cell* cell = &cells[dequeuePos & (LOG_RING_SLOTS - 1)];
+  uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+  if (static_cast<int32_t>(seq - (dequeuePos + 1)) < 0) return false;
+
+  write(cell->event);
+  cell->sequence.store(dequeuePos + LOG_RING_SLOTS, std::memory_order_release);
+  ++dequeuePos;
+  return true;
+}
+
+void LogRing::write(const LogEvent& event) {
+  char line[256];
+  event.render(line, sizeof(line));
+  uint8_t level = event.level <= LOG_LEVEL_DEBUG ? event.level : LOG_LEVEL_DEBUG;
+  Serial.print(levelPrefixes[level]);
+  Serial.println(line);
+}
+
+void LogRing::drainTask(void*) {
+  uint32_t reportedDrops = 0;
+
+  for (;;) {
+    while (drainOne()) {
+    }
+
+    uint32_t drops = droppedCount();
+    if (drops != reportedDrops) {
+      Serial.printf("[Log] ⚠️ %u log messages dropped (ring full)\n", drops - reportedDrops);
+      reportedDrops = drops;
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include "Log.h"
+
+#ifndef LOG_RING_SLOTS
+#define LOG_RING_SLOTS 32          // Must be a power of two
+#endif
+
+#ifndef LOG_RING_TEXT_BYTES
+#define LOG_RING_TEXT_BYTES 128    // Per-event storage for copied string arguments
+#endif
+
+// A captured log call: the format string (a literal with static lifetime)
+// plus its arguments in binary form. String arguments are copied into
+// `text`, since the caller's buffer may be gone by the time we format.
+struct LogEvent {
+  static constexpr uint8_t MAX_ARGS = 8;
+
+  enum ArgType : uint8_t { Signed, Unsigned, Float, Text, Pointer, Truncated };
+
+  const char* fmt;
+  LogTag tag;
+  uint8_t level;
+  uint8_t argc;
+  uint8_t textUsed;
+  uint8_t types[MAX_ARGS];
+  union {
+    int64_t i;
+    uint64_t u;
+    double d;
+    uint8_t textOffset;
+    const void* p;
+  } args[MAX_ARGS];
+  char text[LOG_RING_TEXT_BYTES];
+
+  // Earlier string arguments may have used up `text`; a string with no
+  // room left at all is marked Truncated and renders as "<?>".
+  void add(const char* s) {
+    if (argc >= MAX_ARGS) return;
+    if (!s) s = "(null)";
+    size_t room = sizeof(text) - textUsed;
+    if (room == 0) {
+      types[argc++] = Truncated;
+      return;
+    }
+    size_t len = 0;
+    while (len < room - 1 && s[len]) ++len;
+    types[argc] = Text;
+    args[argc].textOffset = textUsed;
+    memcpy(text + textUsed, s, len);
+    text[textUsed + len] = '\0';
+    textUsed += len + 1;
+    ++argc;
+  }
+
+  void add(char* s) { add(static_cast<const char*>(s)); }
+
+  template<typename T>
+  typename std::enable_if<std::is_integral<T>::value>::type add(T v) {
+    if (argc >= MAX_ARGS) return;
+    if (std::is_signed<T>::value) {
+      types[argc] = Signed;
+      args[argc].i = static_cast<int64_t>(v);
+    } else {
+      types[argc] = Unsigned;
+      args[argc].u = static_cast<uint64_t>(v);
+    }
+    ++argc;
+  }
+
+  template<typename T>
+  typename std::enable_if<std::is_floating_point<T>::value>::type add(T v) {
+    if (argc >= MAX_ARGS) return;
+    types[argc] = Float;
+    args[argc].d = static_cast<double>(v);
+    ++argc;
+  }
+
+  template<typename T>
+  void add(T* p) {
+    if (argc >= MAX_ARGS) return;
+    types[argc] = Pointer;
+    args[argc].p = p;
+    ++argc;
+  }
+
+  // Formats the event into out (always NUL-terminated); returns length written.
+  size_t render(char* out, size_t cap) const;
+};
+
+static_assert(LOG_RING_TEXT_BYTES <= 255, "LogEvent text offsets are stored in a uint8_t");
+
+// Lock-free multi-producer / single-consumer ring of LogEvents. Producers
+// never block: when the ring is full the event is dropped and counted. A
+// low-priority drain task formats events and writes them to Serial.
+//
+// Producers build the event in place (claim, fill, commit) and the drain
+// task formats straight from the slot, so no task carries a LogEvent on
+// its stack once the ring is running.
+class LogRing {
+public:
+  static void begin(uint32_t stackSize = 4096);
+  static bool isRunning() { return running; }
+
+  // Reserves the next slot for the caller to fill, then hand back with
+  // commit(ticket). Returns nullptr (and counts a drop) when the ring is
+  // full.
+  static LogEvent* claim(uint32_t& ticket);
+  static void commit(uint32_t ticket);
+
+  static uint32_t droppedCount() { return dropped.load(std::memory_order_relaxed); }
+
+  // Formats and prints one event synchronously (used before begin()).
+  static void write(const LogEvent& event);
+
+private:
+  static_assert((LOG_RING_SLOTS & (LOG_RING_SLOTS - 1)) == 0, "LOG_RING_SLOTS must be a power of two");
+
+  struct Cell {
+    std::atomic<uint32_t> sequence;
+    LogEvent event;
+  };
+
+  static bool drainOne();
+  static void drainTask(void* param);
+
+  static Cell cells[LOG_RING_SLOTS];
+  static std::atomic<uint32_t> enqueuePos;
+  static uint32_t dequeuePos;
+  static std::atomic<uint32_t> dropped;
+  static bool running;
+};
@@ -24,6 +24,10 @@
 #include "LanManager.h"
 #include "OtaManager.h"
 #include "IpDisplay.h"
+#include "LogRing.h"
+#include "PipelineStats.h"
+#include "ConsumerExecutor.h"
+#include "I2cBus.h"
 
 #define BOOT_BUTTON 0
 
@@ -106,6 +110,13 @@ void initializeSensorManager() {
 void initializeCameraManager() {
   cameraList = userConfig.getCameraConfigList();
 
+  QueueConfig overlayQueue = adminConfig.getOverlayQueueConfig();
+  for (auto& cam : cameraList) {
+    for (auto& overlay : cam.overlays) {
+      overlay.queue = overlayQueue;
+    }
+  }
+
   for (const auto& cam : cameraList) {
     if (!cam.enabled) {
       Serial.printf("⚠️ Skipping disabled camera '%s'\r\n", cam.api.host.c_str());
@@ -138,7 +149,11 @@ void initializeMqttManager() {
   }
 
   mqtt = std::make_unique<MqttManager>(mqttConfig.sensorId, *netClient);
-  mqtt->begin(mqttConfig, identity);
+  if (!mqtt->begin(mqttConfig, identity)) {
+    Serial.println("❌ MqttManager failed to start");
+    mqtt.reset();
+    return;
+  }
   dispatcher.registerConsumer(mqtt.get());
 
   Serial.println("✅ MqttManager initialized");
@@ -211,6 +226,7 @@ void updateDiagnosticsDisplay() {
 void setup() {
   Serial.begin(115200);
   delay(1000);
+  LogRing::begin();
 
   initializeButtons();
   initializeFilesystem();
@@ -226,6 +242,7 @@ void setup() {
   
   if (determineSystemMode() == SystemMode::Setup) return;
   
+  ConsumerExecutor::begin();
   initializeCameraManager();
   initializeMqttManager();
   initializeSensorManager();
@@ -234,6 +251,8 @@ void setup() {
 
 unsigned long lastDiagUpdate = 0;
 const unsigned long diagInterval = 3000;
+unsigned long lastStatsReport = 0;
+const unsigned long statsInterval = 60000;
 
 void loop() {
   unsigned long now = millis();
@@ -242,7 +261,6 @@ void loop() {
     webServer.loop();
   } else {
     monitorBootButton();
-    if (mqtt) mqtt->loop();
     if (otaManager) otaManager->loop();
     delay(3000);
   }
@@ -251,4 +269,12 @@ void loop() {
     updateDiagnosticsDisplay();
     lastDiagUpdate = now;
   }
+
+  if (now - lastStatsReport >= statsInterval) {
+    PipelineStats::logSummary();
+    dispatcher.logQueueStats();
+    if (sensorManager) sensorManager->logStats();
+    I2cBus::logStats();
+    lastStatsReport = now;
+  }
 }
\ No newline at end of file
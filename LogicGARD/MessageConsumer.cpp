@@ -1,46 +1,195 @@
 #include <cstring>
+#include <new>
 #include "MessageConsumer.h"
+#include "PipelineStats.h"
+#include "ConsumerExecutor.h"
 
 MessageConsumer::MessageConsumer(const String& sensorId)
-    : sensorId(sensorId) {
-        BaseComponent::debugLog("MessageConsumer constructor reached for sensorId: " + sensorId);
+    : sensorId(sensorId),
+      wildcard(sensorId == "*"),
+      sensorHandle(wildcard ? SensorRegistry::INVALID : SensorRegistry::intern(sensorId)) {
+        LOG_DEBUG("MessageConsumer constructor reached for sensorId: %s", sensorId.c_str());
       }
 
-void MessageConsumer::begin() {
-  BaseComponent::debugLog("MessageConsumer::begin - Creating message queue...");
-  queue = xQueueCreate(10, sizeof(TemperatureMessage));
-  if (queue == nullptr) {
-    BaseComponent::debugLog("MessageConsumer::begin - Error: failed to create queue.");
+MessageConsumer::~MessageConsumer() {
+  end();
+}
+
+void MessageConsumer::begin(const QueueConfig& queueConfig) {
+  this->queueConfig = queueConfig;
+  ending.store(false);
+
+  // Without a ready-queue slot the consumer stays inert: enqueue() drops
+  if (!ConsumerExecutor::attach()) {
+    Serial.printf("[Consumer] ❌ No executor slot for [%s]\n", sensorId.c_str());
     return;
   }
+  attached = true;
 
-  BaseComponent::debugLog("MessageConsumer::begin - Launching task...");
-  xTaskCreate(
-    taskEntry, "MsgConsumerTask",
-    6144, this, 1, nullptr
-  );
-  BaseComponent::debugLog("MessageConsumer::begin - Task launched.");
+  if (queueConfig.policy == OverflowPolicy::CoalesceLatest) {
+    LOG_DEBUG("MessageConsumer::begin - Allocating coalescing slots...");
+    latest.reset(new (std::nothrow) SensorMessage[SensorRegistry::MAX_SENSORS]);
+    if (!latest) {
+      LOG_DEBUG("MessageConsumer::begin - Error: failed to allocate coalescing slots.");
+      return;
+    }
+  } else {
+    LOG_DEBUG("MessageConsumer::begin - Creating message queue (depth %u)...", (unsigned)queueConfig.depth);
+    queue = xQueueCreate(queueConfig.depth, sizeof(SensorMessage));
+    if (queue == nullptr) {
+      LOG_DEBUG("MessageConsumer::begin - Error: failed to create queue.");
+      return;
+    }
+  }
+
+  LOG_DEBUG("MessageConsumer::begin - Mailbox ready.");
 }
 
-void MessageConsumer::enqueue(const TemperatureMessage& msg) {
-  xQueueSend(queue, &msg, 0);
+void MessageConsumer::end() {
+  if (!attached) return;
+  ending.store(true);
+  // A worker holding this consumer finds nothing left to take and lets go
+  while (scheduled.load()) vTaskDelay(1);
+
+  if (queue) {
+    vQueueDelete(queue);
+    queue = nullptr;
+  }
+  latest.reset();
+  pending = 0;
+  ConsumerExecutor::detach();
+  attached = false;
+  LOG_DEBUG("MessageConsumer::end - [%s] detached", sensorId.c_str());
 }
 
-void MessageConsumer::taskEntry(void* param) {
-  static_cast<MessageConsumer*>(param)->run();
+void MessageConsumer::enqueue(const SensorMessage& msg) {
+  if (latest) {
+    enqueueCoalesced(msg);
+    return;
+  }
+  if (!queue) return;
+
+  if (xQueueSend(queue, &msg, 0) != pdTRUE) {
+    if (queueConfig.policy == OverflowPolicy::DropOldest) {
+      SensorMessage oldest;
+      if (xQueueReceive(queue, &oldest, 0) == pdTRUE) {
+        countDropped();
+      }
+      if (xQueueSend(queue, &msg, 0) == pdTRUE) {
+        countEnqueued(uxQueueMessagesWaiting(queue));
+        requestDrain();
+        return;
+      }
+    }
+    countDropped();
+    return;
+  }
+  countEnqueued(uxQueueMessagesWaiting(queue));
+  requestDrain();
 }
 
-void MessageConsumer::run() {
-  BaseComponent::debugLog("MessageConsumer::run - Task started, waiting for messages...");
-  TemperatureMessage msg;
-  for (;;) {
-    if (xQueueReceive(queue, &msg, portMAX_DELAY)) {
-      BaseComponent::debugLog("MessageConsumer::run - Message received.");
-      BaseComponent::debugLog("MessageConsumer::run - { temperature: " + String(msg.temperature) +
-               ", timestamp: " + String(msg.timestamp) +
-               ", sensorId: " + msg.sensorId + " }");
+void MessageConsumer::enqueueCoalesced(const SensorMessage& msg) {
+  if (msg.sensor >= SensorRegistry::MAX_SENSORS) return;
 
-      process(msg);
+  uint32_t bit = 1UL << msg.sensor;
+  bool overwritten;
+  uint32_t depth;
+
+  portENTER_CRITICAL(&lock);
+  overwritten = pending & bit;
+  latest[msg.sensor] = msg;
+  pending |= bit;
+  depth = __builtin_popcount(pending);
+  portEXIT_CRITICAL(&lock);
+
+  if (overwritten) countDropped();
+  countEnqueued(depth);
+  requestDrain();
+}
+
+void MessageConsumer::countEnqueued(uint32_t depth) {
+  portENTER_CRITICAL(&lock);
+  ++stats.enqueued;
+  if (depth > stats.maxDepth) stats.maxDepth = depth;
+  portEXIT_CRITICAL(&lock);
+  PipelineStats::recordQueueDepth(depth);
+}
+
+void MessageConsumer::countDropped() {
+  portENTER_CRITICAL(&lock);
+  ++stats.dropped;
+  portEXIT_CRITICAL(&lock);
+  PipelineStats::recordDropped();
+}
+
+MessageConsumer::QueueStats MessageConsumer::getQueueStats() const {
+  portENTER_CRITICAL(&lock);
+  QueueStats snapshot = stats;
+  portEXIT_CRITICAL(&lock);
+  return snapshot;
+}
+
+void MessageConsumer::logQueueStats() const {
+  static const char* const policyNames[] = { "dropNewest", "dropOldest", "coalesce" };
+  QueueStats snapshot = getQueueStats();
+  LOG_INFO("[Queue] %s (%s, depth %u): enqueued %lu, dropped %lu, max depth %lu",
+           sensorId.c_str(), policyNames[static_cast<int>(queueConfig.policy)],
+           (unsigned)queueConfig.depth, (unsigned long)snapshot.enqueued,
+           (unsigned long)snapshot.dropped, (unsigned long)snapshot.maxDepth);
+}
+
+void MessageConsumer::requestDrain() {
+  if (!scheduled.exchange(true)) {
+    if (!ConsumerExecutor::schedule(this)) {
+      scheduled.store(false);
     }
   }
-}
\ No newline at end of file
+}
+
+void MessageConsumer::drain(size_t budget) {
+  SensorMessage msg;
+  for (size_t i = 0; i < budget && take(msg); ++i) {
+    PipelineStats::recordLatency(PipelineStage::Queue, msg.createdUs);
+    LOG_DEBUG("MessageConsumer::drain - { channels: 0x%x, timestamp: %lu, sensorId: %s }",
+              (unsigned)msg.channels, (unsigned long)msg.timestamp, msg.sensorId());
+
+    process(msg);
+  }
+  PipelineStats::recordTaskResources(PipelineStage::Queue);
+
+  // A message enqueued after the last take() saw scheduled still set and
+  // did not reschedule, so check again once the flag is clear.
+  scheduled.store(false);
+  if (hasPending()) requestDrain();
+}
+
+// With CoalesceLatest, yields the latest reading of each sensor that
+// changed; readings that arrived in between were overwritten in enqueue().
+bool MessageConsumer::take(SensorMessage& msg) {
+  if (ending.load()) return false;
+  if (!latest) {
+    return queue && xQueueReceive(queue, &msg, 0) == pdTRUE;
+  }
+
+  bool found = false;
+  portENTER_CRITICAL(&lock);
+  if (pending) {
+    size_t slot = __builtin_ctz(pending);
+    pending &= ~(1UL << slot);
+    msg = latest[slot];
+    found = true;
+  }
+  portEXIT_CRITICAL(&lock);
+  return found;
+}
+
+bool MessageConsumer::hasPending() const {
+  if (ending.load()) return false;
+  if (!latest) {
+    return queue && uxQueueMessagesWaiting(queue) > 0;
+  }
+  portENTER_CRITICAL(&lock);
+  bool any = pending != 0;
+  portEXIT_CRITICAL(&lock);
+  return any;
+}
@@ -1,6 +1,9 @@
 #pragma once
 #include <Arduino.h>
-#include "TemperatureMessage.h"
+#include <memory>
+#include <atomic>
+#include "SensorMessage.h"
+#include "Types.h"
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
 #include <freertos/task.h>
@@ -8,18 +11,60 @@
 
 class MessageConsumer : public BaseComponent {
 public:
+  static constexpr LogTag logTag = LogTag::Consumer;
+
+  struct QueueStats {
+    uint32_t enqueued;
+    uint32_t dropped;    // Readings discarded or overwritten by the overflow policy
+    uint32_t maxDepth;
+  };
+
   explicit MessageConsumer(const String& sensorId);
-  virtual void begin();
-  void enqueue(const TemperatureMessage& msg);
+  virtual ~MessageConsumer();
+  virtual void begin(const QueueConfig& queueConfig = QueueConfig());
+  // Drops queued readings, waits for a worker still draining this
+  // consumer, then frees the queue and the executor slot. The dispatcher
+  // must no longer deliver to it. Subclasses call it from their own
+  // destructor, while process() is still theirs to run.
+  virtual void end();
+  void enqueue(const SensorMessage& msg);
   const String& getSensorId() const { return sensorId; }
+  SensorHandle getSensorHandle() const { return sensorHandle; }
+  bool isWildcard() const { return wildcard; }
+
+  QueueStats getQueueStats() const;
+  void logQueueStats() const;
 
 protected:
-  virtual void process(const TemperatureMessage& msg) = 0;
+  virtual void process(const SensorMessage& msg) = 0;
 
 private:
-  void run();
-  static void taskEntry(void* param);
+  friend class ConsumerExecutor;
+
+  // Called by a ConsumerExecutor worker; processes up to budget messages
+  void drain(size_t budget);
+  void requestDrain();
+  bool take(SensorMessage& msg);
+  bool hasPending() const;
+  void enqueueCoalesced(const SensorMessage& msg);
+  void countEnqueued(uint32_t depth);
+  void countDropped();
 
   const String sensorId;
+  const bool wildcard;
+  const SensorHandle sensorHandle;
+  QueueConfig queueConfig;
   QueueHandle_t queue = nullptr;
-};
\ No newline at end of file
+  bool attached = false;                // Holds an executor slot
+  std::atomic<bool> scheduled{false};   // True while queued on or run by a worker
+  std::atomic<bool> ending{false};      // Set by end(): take() yields nothing more
+
+  // CoalesceLatest keeps one slot per sensor instead of a FIFO; a set bit
+  // in `pending` marks a slot the task has not processed yet.
+  std::unique_ptr<SensorMessage[]> latest;
+  uint32_t pending = 0;
+  static_assert(SensorRegistry::MAX_SENSORS <= sizeof(pending) * 8, "pending needs a bit per sensor slot");
+
+  QueueStats stats = {};
+  mutable portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+};
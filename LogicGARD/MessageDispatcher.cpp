@@ -1,40 +1,55 @@
 #include "MessageDispatcher.h"
+#include "PipelineStats.h"
 
 void MessageDispatcher::registerConsumer(MessageConsumer* consumer) {
-  if (consumerCount < MAX_CONSUMERS) {
-    consumers[consumerCount] = consumer;
-
-    BaseComponent::debugLog("MessageDispatcher::registerConsumer - Registered consumer [" + String(consumerCount) + "]");
-    BaseComponent::debugLog("MessageDispatcher::registerConsumer - Consumer [" + String(consumerCount) + "] sensorId: [" + consumer->getSensorId() + "]");
-    BaseComponent::debugLog("MessageDispatcher::registerConsumer - Consumer [" + String(consumerCount) + "] pointer: 0x" + String((uintptr_t)consumer, HEX));
+  if (!consumer) {
+    LOG_DEBUG("MessageDispatcher::registerConsumer - Error: null consumer.");
+    return;
+  }
 
-    ++consumerCount;
+  if (consumer->isWildcard()) {
+    wildcardConsumers.push_back(consumer);
   } else {
-    BaseComponent::debugLog("MessageDispatcher::registerConsumer - Error: max consumer limit reached.");
+    SensorHandle handle = consumer->getSensorHandle();
+    if (handle == SensorRegistry::INVALID) {
+      LOG_DEBUG("MessageDispatcher::registerConsumer - Error: no sensor handle for [%s]", consumer->getSensorId().c_str());
+      return;
+    }
+
+    if (routes.size() <= handle) {
+      routes.resize(handle + 1);
+    }
+    routes[handle].push_back(consumer);
+  }
+
+  LOG_DEBUG("MessageDispatcher::registerConsumer - Registered consumer [%u]", (unsigned)consumerCount);
+  LOG_DEBUG("MessageDispatcher::registerConsumer - Consumer [%u] sensorId: [%s]", (unsigned)consumerCount, consumer->getSensorId().c_str());
+  LOG_DEBUG("MessageDispatcher::registerConsumer - Consumer [%u] pointer: %p", (unsigned)consumerCount, consumer);
+
+  ++consumerCount;
+}
+
+void MessageDispatcher::publish(const SensorMessage& msg) {
+  PipelineStats::recordPublished();
+
+  if (msg.sensor < routes.size()) {
+    for (MessageConsumer* consumer : routes[msg.sensor]) {
+      consumer->enqueue(msg);
+    }
+  }
+
+  for (MessageConsumer* consumer : wildcardConsumers) {
+    consumer->enqueue(msg);
   }
 }
 
-void MessageDispatcher::publish(const TemperatureMessage& msg) {
-  BaseComponent::debugLog("MessageDispatcher::publish - Publishing message: { temperature: " +
-           String(msg.temperature) + ", timestamp: " + String(msg.timestamp) +
-           ", sensorId: " + msg.sensorId + " }");
-
-  for (size_t i = 0; i < consumerCount; ++i) {
-    if (consumers[i]) {
-      const String& consumerSensorId = consumers[i]->getSensorId();
-
-      BaseComponent::debugLog("MessageDispatcher::publish - Checking consumer [" + String(i) + "]");
-      BaseComponent::debugLog("Comparing msg.sensorId: [" + msg.sensorId + "] vs consumer.sensorId: [" + consumerSensorId + "]");
-      BaseComponent::debugLog("Equality result: " + String(msg.sensorId == consumerSensorId));
-
-      if (msg.sensorId == consumerSensorId || consumerSensorId == "*") {
-        BaseComponent::debugLog("MessageDispatcher::publish - Match found. Dispatching to consumer [" + String(i) + "]");
-        consumers[i]->enqueue(msg);
-      } else {
-        BaseComponent::debugLog("MessageDispatcher::publish - Skipped consumer [" + String(i) + "] due to sensorId mismatch.");
-      }
-    } else {
-      BaseComponent::debugLog("MessageDispatcher::publish - Warning: consumer[" + String(i) + "] is null.");
+void MessageDispatcher::logQueueStats() const {
+  for (const auto& consumers : routes) {
+    for (const MessageConsumer* consumer : consumers) {
+      consumer->logQueueStats();
     }
   }
-}
\ No newline at end of file
+  for (const MessageConsumer* consumer : wildcardConsumers) {
+    consumer->logQueueStats();
+  }
+}
@@ -1,15 +1,22 @@
 #pragma once
+#include <vector>
 #include "MessageConsumer.h"
 #include "BaseComponent.h"
 
 class MessageDispatcher : public BaseComponent {
 public:
+  static constexpr LogTag logTag = LogTag::Dispatcher;
+
   void registerConsumer(MessageConsumer* consumer);
-  void publish(const TemperatureMessage& msg);
+  void publish(const SensorMessage& msg);
+  void logQueueStats() const;
   void start();
 
 private:
-  static constexpr size_t MAX_CONSUMERS = 8;
-  MessageConsumer* consumers[MAX_CONSUMERS] = {};
+  // Routing table built at registration time, indexed by SensorHandle.
+  // Consumers register during setup before any sensor task publishes, so
+  // publish() only reads these and needs no lock.
+  std::vector<std::vector<MessageConsumer*>> routes;
+  std::vector<MessageConsumer*> wildcardConsumers;
   size_t consumerCount = 0;
-};
\ No newline at end of file
+};
@@ -0,0 +1,213 @@
+#include "MqttBatchSerializer.h"
+#include <cstring>
+#include <new>
+
+namespace {
+const char JSON_FOOTER[] = "]}";
+constexpr size_t JSON_FOOTER_LEN = sizeof(JSON_FOOTER) - 1;
+constexpr size_t MSGPACK_ARRAY32_LEN = 5;
+}
+
+bool MqttBatchSerializer::begin(size_t capacity, const DeviceIdentity& identity, MqttFormat format) {
+  this->format = format;
+
+  // One extra byte keeps JSON payloads NUL-terminated for logging.
+  buffer.reset(new (std::nothrow) char[capacity + 1]);
+  this->capacity = buffer ? capacity : 0;
+  used = 0;
+  if (!buffer) return false;
+
+  // Render the device block once into the buffer, then keep a copy of it.
+  if (format == MqttFormat::MsgPack) {
+    const char* fields[][2] = {
+      { "clientId",   identity.clientId.c_str() },
+      { "locationId", identity.locationId.c_str() },
+      { "unitId",     identity.unitId.c_str() },
+      { "version",    identity.version.c_str() },
+      { "board",      identity.board.c_str() }
+    };
+    bool ok = packMap(4) && packStr("device") && packMap(5);
+    for (const auto& field : fields) {
+      ok = ok && packStr(field[0]) && packStr(field[1]);
+    }
+    if (!ok) return false;
+  } else {
+    String json = "{\"device\":" + identity.toJson() + ",\"messages\":[";
+    if (!append(json.c_str(), json.length())) return false;
+  }
+
+  header.assign(buffer.get(), buffer.get() + used);
+  used = 0;
+  return true;
+}
+
+size_t MqttBatchSerializer::serialize(const SensorMessage* messages, size_t count) {
+  used = 0;
+  if (!buffer || !append(header.data(), header.size())) return 0;
+
+  return format == MqttFormat::MsgPack
+    ? serializeMsgPack(messages, count)
+    : serializeJson(messages, count);
+}
+
+size_t MqttBatchSerializer::serializeJson(const SensorMessage* messages, size_t count) {
+  size_t consumed = 0;
+  while (consumed < count) {
+    size_t mark = used;
+    bool ok = (consumed == 0 || append(",", 1)) &&
+              appendJsonMessage(messages[consumed]) &&
+              used + JSON_FOOTER_LEN <= capacity;
+    if (!ok) {
+      used = mark;
+      break;
+    }
+    ++consumed;
+  }
+
+  // The footer always fits: every message above was accepted with room for it.
+  append(JSON_FOOTER, JSON_FOOTER_LEN);
+  return consumed;
+}
+
+size_t MqttBatchSerializer::serializeMsgPack(const SensorMessage* messages, size_t count) {
+  if (count == 0) return 0;
+
+  bool ok = packStr("sensors") && packArray(SensorRegistry::count());
+  for (size_t i = 0; ok && i < SensorRegistry::count(); ++i) {
+    ok = packStr(SensorRegistry::name(static_cast<SensorHandle>(i)));
+  }
+  ok = ok && packStr("base") && packUint(messages[0].timestamp) && packStr("messages");
+
+  // The message count is only known once the buffer fills, so reserve a
+  // fixed-width array32 header and patch it afterwards.
+  size_t countPos = used;
+  if (!ok || used + MSGPACK_ARRAY32_LEN > capacity) return 0;
+  used += MSGPACK_ARRAY32_LEN;
+
+  size_t consumed = 0;
+  uint32_t previous = messages[0].timestamp;
+  while (consumed < count) {
+    const SensorMessage& msg = messages[consumed];
+    int32_t delta = static_cast<int32_t>(msg.timestamp - previous);
+
+    size_t mark = used;
+    bool ok = packArray(3 + __builtin_popcount(msg.channels)) &&
+              packUint(msg.sensor) && packInt(delta) && packUint(msg.channels);
+    for (size_t i = 0; ok && i < SensorMessage::CHANNELS; ++i) {
+      if (msg.has(static_cast<Channel>(i))) ok = packInt(msg.values[i]);
+    }
+    if (!ok) {
+      used = mark;
+      break;
+    }
+    previous = msg.timestamp;
+    ++consumed;
+  }
+
+  uint8_t* header32 = reinterpret_cast<uint8_t*>(buffer.get()) + countPos;
+  header32[0] = 0xdd;
+  header32[1] = static_cast<uint8_t>(consumed >> 24);
+  header32[2] = static_cast<uint8_t>(consumed >> 16);
+  header32[3] = static_cast<uint8_t>(consumed >> 8);
+  header32[4] = static_cast<uint8_t>(consumed);
+
+  return consumed;
+}
+
+bool MqttBatchSerializer::append(const char* text, size_t len) {
+  if (used + len > capacity) return false;
+  memcpy(buffer.get() + used, text, len);
+  used += len;
+  buffer[used] = '\0';
+  return true;
+}
+
+bool MqttBatchSerializer::appendEscaped(const char* text) {
+  for (const char* p = text; *p; ++p) {
+    char c = *p;
+    if (c == '"' || c == '\\') {
+      char escaped[2] = { '\\', c };
+      if (!append(escaped, 2)) return false;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[7];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      if (!append(escaped, 6)) return false;
+    } else if (!append(&c, 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MqttBatchSerializer::appendJsonMessage(const SensorMessage& msg) {
+  if (!append("{", 1)) return false;
+
+  char field[40];
+  for (size_t i = 0; i < SensorMessage::CHANNELS; ++i) {
+    Channel channel = static_cast<Channel>(i);
+    if (!msg.has(channel)) continue;
+    int len = snprintf(field, sizeof(field), "\"%s\":", channelName(channel));
+    len += formatFixed(field + len, sizeof(field) - len, msg.values[i]);
+    if (static_cast<size_t>(len) >= sizeof(field) - 1) return false;
+    field[len++] = ',';
+    if (!append(field, len)) return false;
+  }
+
+  int len = snprintf(field, sizeof(field), "\"timestamp\":%lu,\"sensorId\":\"",
+                     static_cast<unsigned long>(msg.timestamp));
+  if (len <= 0 || static_cast<size_t>(len) >= sizeof(field)) return false;
+
+  return append(field, len) &&
+         appendEscaped(msg.sensorId()) &&
+         append("\"}", 2);
+}
+
+// ─────────────────────────────────────────────────────────────
+// MessagePack primitives (big-endian, smallest encoding)
+// ─────────────────────────────────────────────────────────────
+
+bool MqttBatchSerializer::packMap(uint32_t size) {
+  if (size < 16) return appendByte(0x80 | size);
+  uint8_t bytes[] = { 0xde, static_cast<uint8_t>(size >> 8), static_cast<uint8_t>(size) };
+  return size <= 0xffff && append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+bool MqttBatchSerializer::packArray(uint32_t size) {
+  if (size < 16) return appendByte(0x90 | size);
+  uint8_t bytes[] = { 0xdc, static_cast<uint8_t>(size >> 8), static_cast<uint8_t>(size) };
+  return size <= 0xffff && append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+bool MqttBatchSerializer::packStr(const char* text, size_t len) {
+  bool ok;
+  if (len < 32) {
+    ok = appendByte(0xa0 | len);
+  } else if (len <= 0xff) {
+    ok = appendByte(0xd9) && appendByte(len);
+  } else {
+    ok = len <= 0xffff && appendByte(0xda) && appendByte(len >> 8) && appendByte(len);
+  }
+  return ok && append(text, len);
+}
+
+bool MqttBatchSerializer::packUint(uint32_t value) {
+  if (value < 0x80) return appendByte(value);
+  if (value <= 0xff) return appendByte(0xcc) && appendByte(value);
+  if (value <= 0xffff) return appendByte(0xcd) && appendByte(value >> 8) && appendByte(value);
+  uint8_t bytes[] = { 0xce, static_cast<uint8_t>(value >> 24), static_cast<uint8_t>(value >> 16),
+                      static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value) };
+  return append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+bool MqttBatchSerializer::packInt(int32_t value) {
+  if (value >= 0) return packUint(static_cast<uint32_t>(value));
+  if (value >= -32) return appendByte(static_cast<uint8_t>(value));
+  if (value >= -128) return appendByte(0xd0) && appendByte(static_cast<uint8_t>(value));
+  if (value >= -32768) {
+    return appendByte(0xd1) && appendByte(static_cast<uint8_t>(value >> 8)) && appendByte(static_cast<uint8_t>(value));
+  }
+  uint32_t raw = static_cast<uint32_t>(value);
+  uint8_t bytes[] = { 0xd2, static_cast<uint8_t>(raw >> 24), static_cast<uint8_t>(raw >> 16),
+                      static_cast<uint8_t>(raw >> 8), static_cast<uint8_t>(raw) };
+  return append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
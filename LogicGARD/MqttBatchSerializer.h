@@ -0,0 +1,59 @@
+#pragma once
+#include <Arduino.h>
+#include <memory>
+#include <vector>
+#include "SensorMessage.h"
+#include "Types.h"
+
+// Writes a batch of SensorMessages into a buffer allocated once in
+// begin(). A batch larger than the buffer is split: each serialize() call
+// fills one payload and reports how many messages it consumed, so the caller
+// publishes and calls again.
+//
+// MqttFormat::Json (only the channels a reading carries, two decimals):
+//   {"device":{...},"messages":[{"temperature":72.50,"humidity":41.20,
+//     "pressure":1013.25,"timestamp":..,"sensorId":".."},...]}
+//
+// MqttFormat::MsgPack (one map, keys as below):
+//   { "device":   {clientId, locationId, unitId, version, board},
+//     "sensors":  [name, ...],            // index == sensor handle
+//     "base":     first timestamp,
+//     "messages": [[sensor, dt, channels, value, ...], ...] }
+//   where dt is the signed delta from the previous message's timestamp
+//   (the first message's dt is relative to "base"), channels is the
+//   SensorMessage bitmask and the values follow in Channel order as
+//   fixed-point integers (hundredths).
+class MqttBatchSerializer {
+public:
+  bool begin(size_t capacity, const DeviceIdentity& identity, MqttFormat format = MqttFormat::Json);
+
+  // Serializes as many of messages[0..count) as fit. Returns the number
+  // consumed; 0 means not even one message fits the capacity.
+  size_t serialize(const SensorMessage* messages, size_t count);
+
+  const char* data() const { return buffer.get(); }
+  size_t length() const { return used; }
+  MqttFormat getFormat() const { return format; }
+
+private:
+  size_t serializeJson(const SensorMessage* messages, size_t count);
+  size_t serializeMsgPack(const SensorMessage* messages, size_t count);
+
+  bool append(const char* text, size_t len);
+  bool appendEscaped(const char* text);
+  bool appendJsonMessage(const SensorMessage& msg);
+
+  bool appendByte(uint8_t b) { return append(reinterpret_cast<const char*>(&b), 1); }
+  bool packMap(uint32_t size);
+  bool packArray(uint32_t size);
+  bool packStr(const char* text, size_t len);
+  bool packStr(const char* text) { return packStr(text, strlen(text)); }
+  bool packUint(uint32_t value);
+  bool packInt(int32_t value);
+
+  std::unique_ptr<char[]> buffer;
+  size_t capacity = 0;
+  size_t used = 0;
+  MqttFormat format = MqttFormat::Json;
+  std::vector<char> header;
+};
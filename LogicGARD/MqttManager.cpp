@@ -1,190 +1,339 @@
 #include "MqttManager.h"
-#include "TimeUtils.h"
+#include "PipelineStats.h"
+#include <new>
+#include <algorithm>
+
+namespace {
+// PubSubClient reserves room for the largest fixed header in its buffer
+constexpr size_t MQTT_FIXED_HEADER_BYTES = 5;
+// CONNECT variable header: protocol name, level, flags, keepalive
+constexpr size_t MQTT_CONNECT_HEADER_BYTES = 10;
+}
 
 MqttManager::MqttManager(const String& sensorId, Client& netClient)
   : MessageConsumer(sensorId), mqttClient(netClient) {
   msgLock = xSemaphoreCreateMutex();
-  retryLock = xSemaphoreCreateMutex();
-  BaseComponent::debugLog("[MQTT] MqttManager constructed for sensorId: " + sensorId);
-  if (!msgLock || !retryLock) {
+  clientLock = xSemaphoreCreateMutex();
+  LOG_DEBUG("[MQTT] MqttManager constructed for sensorId: %s", sensorId.c_str());
+  if (!msgLock || !clientLock) {
     Serial.println("[MQTT] ❌ Mutex creation failed");
   }
 }
 
-void MqttManager::begin(const MqttConfig& config, const DeviceIdentity& identity) {
+MqttManager::~MqttManager() {
+  end();
+  if (msgLock) vSemaphoreDelete(msgLock);
+  if (clientLock) vSemaphoreDelete(clientLock);
+}
+
+void MqttManager::end() {
+  // No process() calls after this, so the task is the last user of the client
+  MessageConsumer::end();
+  if (!ioTask) return;
+
+  stopping.store(true);
+  xTaskNotifyGive(ioTask);
+  while (!ioStopped.load()) vTaskDelay(1);
+  ioTask = nullptr;
+
+  mqttClient.disconnect();
+  state = ConnectionState::Disconnected;
+  LOG_DEBUG("[MQTT] Stopped");
+}
+
+bool MqttManager::begin(const MqttConfig& config, const DeviceIdentity& identity) {
   this->config = config;
   this->identity = identity;
 
-  BaseComponent::debugLog("[MQTT] begin() called with clientId: " + config.clientId +
-           ", broker: " + config.broker + ", port: " + String(config.port));
-
-  MessageConsumer::begin();
+  LOG_DEBUG("[MQTT] begin() called with clientId: %s, broker: %s, port: %d",
+            config.clientId.c_str(), config.broker.c_str(), config.port);
 
   if (!config.enabled) {
     Serial.println("[MQTT] Disabled in config");
-    return;
+    return false;
   }
 
   if (!identity.isValid()) {
     Serial.println("[MQTT] ❌ Invalid device identity");
-    return;
+    return false;
+  }
+
+  pendingMessages.reserve(config.batchSize);
+  flushingMessages.reserve(config.batchSize);
+
+  // Without the serializer nothing could ever be published or spooled
+  if (!serializer.begin(config.bufferSize, identity, config.format)) {
+    Serial.printf("[MQTT] ❌ Failed to set up a %d-byte payload buffer, MQTT not started\n", config.bufferSize);
+    return false;
+  }
+
+  replayBuffer.reset(new (std::nothrow) char[config.bufferSize]);
+  if (!replayBuffer || !spool.begin(config.spoolMaxBytes, config.bufferSize)) {
+    Serial.println("[MQTT] ❌ Failed to open store-and-forward spool");
   }
 
-  mqttClient.setBufferSize(config.bufferSize);
+  if (!mqttClient.setBufferSize(clientBufferSize())) {
+    Serial.println("[MQTT] ❌ Failed to allocate client buffer");
+    return false;
+  }
   mqttClient.setServer(config.broker.c_str(), config.port);
-  connectToBroker();
+  mqttClient.setSocketTimeout(CONNECT_TIMEOUT_S);
+
+  // Only once nothing else can fail: a manager that returns false is
+  // usually dropped, and must not keep an executor slot and queue
+  MessageConsumer::begin(config.queue);
+
+  // The first connect attempt happens on the MQTT task
+  state = ConnectionState::Disconnected;
+  failedAttempts = 0;
   lastFlushTime = millis();
+  stopping.store(false);
+  ioStopped.store(false);
+
+  if (xTaskCreate(ioTaskEntry, "MqttTask", 6144, this, 2, &ioTask) != pdPASS) {
+    Serial.println("[MQTT] ❌ Failed to start MQTT task");
+    ioTask = nullptr;
+    MessageConsumer::end();
+    return false;
+  }
+  return true;
 }
 
-void MqttManager::connectToBroker() {
-  BaseComponent::debugLog("[MQTT] Connecting to broker: " + config.broker + ":" + String(config.port));
+// Payloads stream through beginPublish/write/endPublish, so PubSubClient's
+// own buffer only ever holds the CONNECT packet or a publish header.
+uint16_t MqttManager::clientBufferSize() const {
+  size_t connect = MQTT_FIXED_HEADER_BYTES + MQTT_CONNECT_HEADER_BYTES + 2 + config.clientId.length();
+  if (!config.username.isEmpty()) connect += 2 + config.username.length();
+  if (!config.password.isEmpty()) connect += 2 + config.password.length();
+  size_t publishHeader = MQTT_FIXED_HEADER_BYTES + 2 + config.topic.length();
+  return static_cast<uint16_t>(std::max(connect, publishHeader));
+}
 
-  while (!mqttClient.connected()) {
-    BaseComponent::debugLog("[MQTT] Attempting connection as clientId: " + config.clientId);
+void MqttManager::ioTaskEntry(void* param) {
+  MqttManager* self = static_cast<MqttManager*>(param);
+  self->runIo();
+  self->ioStopped.store(true);
+  vTaskDelete(nullptr);
+}
 
-    if (mqttClient.connect(config.clientId.c_str(), config.username.c_str(), config.password.c_str())) {
-      BaseComponent::debugLog("[MQTT] ✅ Connected");
-      connected = true;
-      flag = 1;  // Success
-    } else {
-      Serial.println("[MQTT] ❌ Failed, rc=" + String(mqttClient.state()));
-      flag = -1; // Failure
-      delay(2000);
+// Sleeps until process() signals a full batch, the flush interval ends or
+// the next keepalive/backoff poll is due, whichever comes first.
+void MqttManager::runIo() {
+  LOG_DEBUG("[MQTT] Task started");
+  uint32_t waitMs = 0;
+  for (;;) {
+    bool sizeTrigger = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs)) > 0;
+    if (stopping.load()) return;
+    if (xSemaphoreTake(clientLock, portMAX_DELAY)) {
+      waitMs = service(sizeTrigger);
+      xSemaphoreGive(clientLock);
     }
   }
 }
 
-void MqttManager::loop() {
-  if (!config.enabled || !connected) {
-    BaseComponent::debugLog("[MQTT] Skipping loop—MQTT disabled or not connected.");
-    return;
+// Advances the connection state machine by at most one connect attempt
+void MqttManager::updateConnection() {
+  switch (state) {
+    case ConnectionState::Connected:
+      if (mqttClient.connected()) return;
+      Serial.println("[MQTT] ⚠️ Connection lost, rc=" + String(mqttClient.state()));
+      flag = -1;
+      scheduleReconnect();
+      return;
+
+    case ConnectionState::Backoff:
+      if (millis() - backoffStart < backoffDelay) return;
+      state = ConnectionState::Disconnected;
+      // fall through
+
+    case ConnectionState::Disconnected:
+    case ConnectionState::Connecting:
+      connectToBroker();
+      return;
   }
+}
 
-  mqttClient.loop();
-
-  uint32_t now = millis();
-  uint32_t elapsed = now - lastFlushTime;
-  int32_t remaining = static_cast<int32_t>(config.flushIntervalMs) - static_cast<int32_t>(elapsed);
-
-  BaseComponent::debugLog("[MQTT] Time since last flush: " + String(elapsed) + " ms");
-  BaseComponent::debugLog("[MQTT] Time remaining until next flush: " + String(remaining) + " ms");
+void MqttManager::connectToBroker() {
+  state = ConnectionState::Connecting;
+  LOG_DEBUG("[MQTT] Connecting to broker %s:%d as clientId: %s (attempt %u)",
+            config.broker.c_str(), config.port, config.clientId.c_str(), (unsigned)failedAttempts + 1);
+
+  // PubSubClient sends a credential field for any non-null pointer, even an
+  // empty one; clientBufferSize() only counts the ones that are set
+  const char* user = config.username.isEmpty() ? nullptr : config.username.c_str();
+  const char* pass = config.password.isEmpty() ? nullptr : config.password.c_str();
+  if (mqttClient.connect(config.clientId.c_str(), user, pass)) {
+    LOG_DEBUG("[MQTT] ✅ Connected");
+    state = ConnectionState::Connected;
+    failedAttempts = 0;
+    flag = 1;  // Success
+  } else {
+    Serial.println("[MQTT] ❌ Failed, rc=" + String(mqttClient.state()));
+    flag = -1; // Failure
+    scheduleReconnect();
+  }
+}
 
-  bool timeTrigger = config.flushIntervalMs > 0 && elapsed >= config.flushIntervalMs;
+void MqttManager::scheduleReconnect() {
+  uint32_t ceiling = RECONNECT_MIN_MS;
+  for (uint8_t i = 0; i < failedAttempts && ceiling < RECONNECT_MAX_MS; i++) {
+    ceiling *= 2;
+  }
+  ceiling = std::min(ceiling, RECONNECT_MAX_MS);
+  if (failedAttempts < UINT8_MAX) failedAttempts++;
 
-  bool sizeTrigger = false;
-  size_t pendingSize = 0;
+  backoffDelay = ceiling / 2 + random(ceiling / 2 + 1);
+  backoffStart = millis();
+  state = ConnectionState::Backoff;
+  LOG_DEBUG("[MQTT] Next connect attempt in %lu ms", (unsigned long)backoffDelay);
+}
 
-  if (xSemaphoreTake(msgLock, portMAX_DELAY)) {
-    pendingSize = pendingMessages.size();
-    sizeTrigger = config.batchSize > 0 && pendingSize >= config.batchSize;
-    BaseComponent::debugLog("[MQTT] Pending message count: " + String(pendingSize));
-    BaseComponent::debugLog("[MQTT] Size trigger threshold: " + String(config.batchSize));
-    xSemaphoreGive(msgLock);
+// One pass of the MQTT task; returns how long it may sleep afterwards
+uint32_t MqttManager::service(bool sizeTrigger) {
+  updateConnection();
+  if (state == ConnectionState::Connected) {
+    mqttClient.loop();
   }
 
-  String flushTimeStr = TimeUtils::formatIsoTimestamp(lastFlushTime);
-  BaseComponent::debugLog("[MQTT] Last flush timestamp: " + flushTimeStr);
+  uint32_t now = millis();
+  uint32_t elapsed = now - lastFlushTime;
+  bool timeTrigger = config.flushIntervalMs > 0 && elapsed >= config.flushIntervalMs;
+
+  LOG_DEBUG("[MQTT] Time since last flush: %lu ms", (unsigned long)elapsed);
 
   if (timeTrigger || sizeTrigger) {
-    String triggerReason = String(timeTrigger ? "time" : "") +
-                           String((timeTrigger && sizeTrigger) ? " & " : "") +
-                           String(sizeTrigger ? "size" : "");
-    BaseComponent::debugLog("[MQTT] 🚀 Flush triggered by " + triggerReason);
+    LOG_DEBUG("[MQTT] 🚀 Flush triggered by %s%s%s",
+              timeTrigger ? "time" : "",
+              (timeTrigger && sizeTrigger) ? " & " : "",
+              sizeTrigger ? "size" : "");
     flushMessages();
     lastFlushTime = now;
-    BaseComponent::debugLog("[MQTT] Flush completed. Updated lastFlushTime to: " + String(now));
+    elapsed = 0;
+    LOG_DEBUG("[MQTT] Flush completed. Updated lastFlushTime to: %lu", (unsigned long)now);
+  }
+
+  uint32_t waitMs = POLL_INTERVAL_MS;
+  if (config.flushIntervalMs > 0) {
+    waitMs = std::min(waitMs, config.flushIntervalMs - elapsed);
   }
+  if (state == ConnectionState::Backoff) {
+    // Nothing to poll until the backoff ends
+    uint32_t backoffRemaining = backoffDelay - std::min(backoffDelay, millis() - backoffStart);
+    waitMs = config.flushIntervalMs > 0
+      ? std::min(backoffRemaining, config.flushIntervalMs - elapsed)
+      : backoffRemaining;
+  }
+  return waitMs;
 }
 
-void MqttManager::process(const TemperatureMessage& msg) {
+void MqttManager::process(const SensorMessage& msg) {
+  bool batchFull = false;
   if (xSemaphoreTake(msgLock, portMAX_DELAY)) {
-    BaseComponent::debugLog("[MQTT] Received message: " + msg.toJson());
+    LOG_DEBUG("[MQTT] Received message: %s", msg.toJson().c_str());
     pendingMessages.push_back(msg);
+    batchFull = config.batchSize > 0 && pendingMessages.size() >= config.batchSize;
     xSemaphoreGive(msgLock);
   }
+
+  // Wake the MQTT task now rather than at its next timeout
+  if (batchFull && ioTask) {
+    LOG_DEBUG("[MQTT] Batch threshold %u reached, notifying MQTT task", (unsigned)config.batchSize);
+    xTaskNotifyGive(ioTask);
+  }
 }
 
 void MqttManager::flushMessages() {
-  if (!mqttClient.connected()) {
-    Serial.println("[MQTT] ⚠️ Disconnected, reconnecting...");
-    connectToBroker();
-  }
+  // While offline, batches go straight to the spool; reconnecting is left
+  // to updateConnection() so a dead broker never stalls the flush.
+  bool online = state == ConnectionState::Connected && mqttClient.connected();
 
-  std::vector<TemperatureMessage> toPublish;
+  std::vector<SensorMessage>& toPublish = flushingMessages;
+  toPublish.clear();
 
   if (xSemaphoreTake(msgLock, portMAX_DELAY)) {
     std::swap(toPublish, pendingMessages);
     xSemaphoreGive(msgLock);
   }
 
-  BaseComponent::debugLog("[MQTT] flushMessages() - toPublish size: " + String(toPublish.size()));
+  LOG_DEBUG("[MQTT] flushMessages() - toPublish size: %u", (unsigned)toPublish.size());
 
-  if (xSemaphoreTake(retryLock, portMAX_DELAY)) {
-    BaseComponent::debugLog("[MQTT] Processing retry queue, size: " + String(retryQueue.size()));
-    for (auto it = retryQueue.begin(); it != retryQueue.end(); ) {
-      bool success = mqttClient.publish(config.topic.c_str(), it->c_str());
-      if (success) {
-        BaseComponent::debugLog("[MQTT] ✅ Retry succeeded");
-        it = retryQueue.erase(it);
-        flag = 1;
-      } else {
-        Serial.println("[MQTT] ❌ Retry failed, keeping message");
+  // Replay spooled payloads oldest-first before anything new
+  if (online && replayBuffer && !spool.isEmpty()) {
+    LOG_DEBUG("[MQTT] Replaying spool, %u bytes", (unsigned)spool.sizeBytes());
+    size_t length;
+    while ((length = spool.peek(replayBuffer.get(), config.bufferSize)) > 0) {
+      if (!publishPayload(replayBuffer.get(), length)) {
+        Serial.println("[MQTT] ❌ Replay failed, keeping spooled payloads");
         Serial.println("[MQTT] Client state: " + String(mqttClient.state()));
         flag = -1;
         break;
       }
+      spool.pop();
+      LOG_DEBUG("[MQTT] ✅ Replayed spooled payload (%u bytes)", (unsigned)length);
+      flag = 1;
     }
-    xSemaphoreGive(retryLock);
+    spool.commit();
   }
+  bool spoolDrained = spool.isEmpty();
 
   if (toPublish.empty()) {
     Serial.println("[MQTT] No new messages to publish");
     return;
   }
 
-  String payload = buildPayload(toPublish);
-  BaseComponent::debugLog("[MQTT] Publishing batch payload: " + payload);
+  // Batches larger than the payload buffer go out as several publishes
+  size_t offset = 0;
+  while (offset < toPublish.size()) {
+    size_t count = serializer.serialize(toPublish.data() + offset, toPublish.size() - offset);
+    if (count == 0) {
+      Serial.println("[MQTT] ❌ bufferSize too small for a single message, dropping batch");
+      flag = -1;
+      break;
+    }
 
-  bool success = mqttClient.publish(config.topic.c_str(), payload.c_str());
+    if (config.format == MqttFormat::Json) {
+      LOG_DEBUG("[MQTT] Publishing batch payload (%u messages, %u bytes): %s",
+                (unsigned)count, (unsigned)serializer.length(), serializer.data());
+    } else {
+      LOG_DEBUG("[MQTT] Publishing msgpack batch (%u messages, %u bytes)",
+                (unsigned)count, (unsigned)serializer.length());
+    }
 
-  if (!success) {
-    Serial.println("[MQTT] ❌ Publish failed, queuing batch");
-    flag = -1;
-    if (xSemaphoreTake(retryLock, portMAX_DELAY)) {
-      retryQueue.push_back(payload);
-      xSemaphoreGive(retryLock);
+    // Keep ordering: while older payloads are still spooled, spool new ones behind them
+    if (!online || !spoolDrained || !publishPayload(serializer.data(), serializer.length())) {
+      if (online) {
+        Serial.println("[MQTT] ❌ Publish failed, spooling batch");
+        flag = -1;
+      } else {
+        LOG_DEBUG("[MQTT] Offline, spooling batch");
+      }
+      spoolDrained = false;
+      if (!spool.append(serializer.data(), serializer.length())) {
+        Serial.println("[MQTT] ❌ Failed to spool batch, dropping it");
+      }
+    } else {
+      for (size_t i = offset; i < offset + count; ++i) {
+        PipelineStats::recordLatency(PipelineStage::Mqtt, toPublish[i].createdUs);
+      }
+      LOG_DEBUG("[MQTT] ✅ Batch published");
+      LOG_DEBUG("[MQTT] Client state: %d", mqttClient.state());
+      flag = 1;
     }
-  } else {
-    BaseComponent::debugLog("[MQTT] ✅ Batch published");
-    BaseComponent::debugLog("[MQTT] Client state: " + String(mqttClient.state()));
-    flag = 1;
-  }
-}
 
-String MqttManager::buildPayload(const std::vector<TemperatureMessage>& messages) {
-  String payload = "{";
-  payload += "\"device\":{";
-  payload += "\"clientId\":\"" + identity.clientId + "\",";
-  payload += "\"locationId\":\"" + identity.locationId + "\",";
-  payload += "\"unitId\":\"" + identity.unitId + "\",";
-  payload += "\"version\":\"" + identity.version + "\",";
-  payload += "\"board\":\"" + identity.board + "\"";
-  payload += "},";
-
-  payload += "\"messages\":[";
-  for (size_t i = 0; i < messages.size(); ++i) {
-    payload += messages[i].toJson();
-    if (i < messages.size() - 1) payload += ",";
-  }
-  payload += "]}";
-  return payload;
+    offset += count;
+  }
+  PipelineStats::recordTaskResources(PipelineStage::Mqtt);
 }
 
-void MqttManager::publishMessage(const String& payload) {
-  if (!connected || !config.enabled) return;
-  BaseComponent::debugLog("[MQTT] Direct publish: " + payload);
-  bool success = mqttClient.publish(config.topic.c_str(), payload.c_str());
-  flag = success ? 1 : -1;
+bool MqttManager::publishPayload(const char* payload, size_t length) {
+  // Streams the payload straight to the socket, so PubSubClient's internal
+  // buffer only has to hold the packet header.
+  if (!mqttClient.beginPublish(config.topic.c_str(), length, false)) return false;
+  if (mqttClient.write(reinterpret_cast<const uint8_t*>(payload), length) != length) {
+    mqttClient.endPublish();
+    return false;
+  }
+  return mqttClient.endPublish() == 1;
 }
 
 String MqttManager::getText() const {
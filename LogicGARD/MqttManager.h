@@ -2,41 +2,83 @@
 
 #include <PubSubClient.h>
 #include <Client.h>
+#include <atomic>
 #include <vector>
+#include <memory>
 #include <Arduino.h>
 #include "MessageConsumer.h"
 #include "Types.h"
-#include "TemperatureMessage.h"
+#include "SensorMessage.h"
+#include "MqttBatchSerializer.h"
+#include "MqttSpool.h"
 #include "IDisplay.h"
 
 class MqttManager : public MessageConsumer, public IDisplay {
 public:
+  static constexpr LogTag logTag = LogTag::Mqtt;
+
+  // Reconnect backoff doubles from MIN to MAX; each wait is jittered
+  // into [delay/2, delay] so devices do not reconnect in lockstep.
+  static constexpr uint32_t RECONNECT_MIN_MS = 1000;
+  static constexpr uint32_t RECONNECT_MAX_MS = 60000;
+  // PubSubClient's socket timeout: bounds the CONNACK wait and each packet
+  // read. The TCP connect before it is bounded by WiFiClient's own timeout
+  // (3 s by default) and the DNS lookup is not bounded here at all.
+  static constexpr uint16_t CONNECT_TIMEOUT_S = 3;
+  // Longest the MQTT task sleeps between keepalive/inbound polls
+  static constexpr uint32_t POLL_INTERVAL_MS = 1000;
+
+  enum class ConnectionState { Disconnected, Connecting, Connected, Backoff };
+
   MqttManager(const String& sensorId, Client& netClient);
-  void begin(const MqttConfig& config, const DeviceIdentity& identity);
-  void loop();
-  void publishMessage(const String& payload);
+  ~MqttManager() override;
+  // Starts the MQTT task, which owns the connection, keepalives and
+  // flushing. Returns false, without starting it, if MQTT is disabled or
+  // the payload buffer cannot be set up; it then holds no executor slot.
+  bool begin(const MqttConfig& config, const DeviceIdentity& identity);
+  // Stops the MQTT task and disconnects. Readings not yet flushed are lost.
+  void end() override;
+  ConnectionState getState() const { return state.load(); }
 
   // IDisplay interface implementation
   String getText() const override;
 
 protected:
-  void process(const TemperatureMessage& msg) override;
+  void process(const SensorMessage& msg) override;
 
 private:
   MqttConfig config;
   DeviceIdentity identity;
   PubSubClient mqttClient;
-  bool connected = false;
 
-  std::vector<TemperatureMessage> pendingMessages;
-  std::vector<String> retryQueue;
+  // Written by the MQTT task, read from the main loop
+  std::atomic<ConnectionState> state{ConnectionState::Disconnected};
+  uint32_t backoffStart = 0;
+  uint32_t backoffDelay = 0;
+  uint8_t failedAttempts = 0;
+
+  // Double-buffered so that steady-state process() reuses existing capacity
+  std::vector<SensorMessage> pendingMessages;
+  std::vector<SensorMessage> flushingMessages;
+  MqttBatchSerializer serializer;
+  MqttSpool spool;
+  std::unique_ptr<char[]> replayBuffer;
 
   SemaphoreHandle_t msgLock;
-  SemaphoreHandle_t retryLock;
+  SemaphoreHandle_t clientLock;   // Serializes PubSubClient access
+  TaskHandle_t ioTask = nullptr;
+  std::atomic<bool> stopping{false};    // Asks the MQTT task to exit
+  std::atomic<bool> ioStopped{false};   // Set by the task on its way out
 
   unsigned long lastFlushTime = 0;
 
+  static void ioTaskEntry(void* param);
+  void runIo();
+  uint32_t service(bool sizeTrigger);
+  void updateConnection();
   void connectToBroker();
+  void scheduleReconnect();
+  uint16_t clientBufferSize() const;
   void flushMessages();
-  String buildPayload(const std::vector<TemperatureMessage>& messages);
+  bool publishPayload(const char* payload, size_t length);
 };
\ No newline at end of file
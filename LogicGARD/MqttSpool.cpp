@@ -0,0 +1,194 @@
+#include "MqttSpool.h"
+#include <SPIFFS.h>
+#include <rom/crc.h>
+#include <algorithm>
+
+namespace {
+const char SPOOL_DIR[] = "/mqtt";
+}
+
+bool MqttSpool::begin(size_t maxBytes, size_t maxRecordBytes) {
+  this->maxBytes = maxBytes;
+  // Eight segments per spool bounds the space lost to one eviction, but a
+  // segment must still hold at least one full record.
+  segmentBytes = std::max(maxBytes / 8, maxRecordBytes + sizeof(RecordHeader));
+
+  ready = false;
+  if (!prefs.begin("mqttspool", false)) {
+    Serial.println("[MQTT] ❌ Spool: failed to open NVS namespace for the cursor");
+    return false;
+  }
+
+  segments.clear();
+  totalBytes = 0;
+
+  File dir = SPIFFS.open(SPOOL_DIR);
+  if (dir) {
+    File file = dir.openNextFile();
+    while (file) {
+      String name = file.name();
+      int slash = name.lastIndexOf('/');
+      if (slash >= 0) name = name.substring(slash + 1);
+
+      if (name.startsWith("seg_")) {
+        segments.push_back(strtoul(name.c_str() + 4, nullptr, 10));
+        totalBytes += file.size();
+      }
+      file = dir.openNextFile();
+    }
+  }
+  std::sort(segments.begin(), segments.end());
+
+  uint32_t cursorSeq = prefs.getUInt("seq", 0);
+  readOffset = prefs.getUInt("off", 0);
+
+  // Segments before the saved cursor were fully sent before the reboot
+  while (!segments.empty() && segments.front() < cursorSeq) {
+    dropFront();
+  }
+  if (segments.empty() || segments.front() != cursorSeq) {
+    readOffset = 0;
+  }
+  nextReadOffset = readOffset;
+  cursorDirty = false;
+
+  // Never append behind a possibly torn tail record from the last boot
+  writeOpen = false;
+  ready = true;
+
+  LOG_DEBUG("[MQTT] Spool opened: %u segment(s), %u bytes, cursor %lu:%lu",
+            (unsigned)segments.size(), (unsigned)totalBytes,
+            (unsigned long)(segments.empty() ? 0 : segments.front()), (unsigned long)readOffset);
+  return true;
+}
+
+String MqttSpool::segmentPath(uint32_t seq) const {
+  char path[32];
+  snprintf(path, sizeof(path), "%s/seg_%08lu", SPOOL_DIR, static_cast<unsigned long>(seq));
+  return String(path);
+}
+
+bool MqttSpool::startSegment() {
+  uint32_t seq = segments.empty() ? prefs.getUInt("seq", 0) + 1 : segments.back() + 1;
+  segments.push_back(seq);
+  writeSize = 0;
+  writeOpen = true;
+  return true;
+}
+
+bool MqttSpool::append(const char* data, size_t length) {
+  if (!ready || length == 0 || length > 0xFFFF) return false;
+
+  size_t recordBytes = sizeof(RecordHeader) + length;
+  if (recordBytes > maxBytes) return false;
+
+  while (totalBytes + recordBytes > maxBytes && !segments.empty()) {
+    evictOldest();
+  }
+
+  if (!writeOpen || segments.empty() || writeSize + recordBytes > segmentBytes) {
+    startSegment();
+  }
+
+  RecordHeader header = {
+    RECORD_MAGIC,
+    static_cast<uint16_t>(length),
+    crc32_le(0, reinterpret_cast<const uint8_t*>(data), length)
+  };
+
+  File file = SPIFFS.open(segmentPath(segments.back()), FILE_APPEND);
+  if (!file) {
+    Serial.println("[MQTT] ❌ Spool: failed to open segment for append");
+    return false;
+  }
+
+  size_t written = file.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+  written += file.write(reinterpret_cast<const uint8_t*>(data), length);
+  file.close();
+
+  writeSize += written;
+  totalBytes += written;
+
+  if (written != recordBytes) {
+    // A short write leaves a record that fails its CRC; seal the segment
+    Serial.println("[MQTT] ❌ Spool: short write, sealing segment");
+    writeOpen = false;
+    return false;
+  }
+  return true;
+}
+
+size_t MqttSpool::peek(char* buffer, size_t capacity) {
+  while (ready && !segments.empty()) {
+    uint32_t seq = segments.front();
+    File file = SPIFFS.open(segmentPath(seq), FILE_READ);
+
+    if (file && file.seek(readOffset)) {
+      RecordHeader header;
+      bool valid = file.read(reinterpret_cast<uint8_t*>(&header), sizeof(header)) == sizeof(header) &&
+                   header.magic == RECORD_MAGIC &&
+                   header.length <= capacity &&
+                   file.read(reinterpret_cast<uint8_t*>(buffer), header.length) == header.length &&
+                   crc32_le(0, reinterpret_cast<const uint8_t*>(buffer), header.length) == header.crc;
+      file.close();
+
+      if (valid) {
+        nextReadOffset = readOffset + sizeof(header) + header.length;
+        return header.length;
+      }
+    }
+
+    // End of segment, or a torn/corrupt record: nothing further in this
+    // segment can be trusted. Retiring the segment being written makes the
+    // next append start a fresh one.
+    dropFront();
+  }
+  return 0;
+}
+
+void MqttSpool::pop() {
+  if (segments.empty() || nextReadOffset <= readOffset) return;
+  readOffset = nextReadOffset;
+  cursorDirty = true;
+}
+
+void MqttSpool::commit() {
+  if (cursorDirty && !segments.empty()) saveCursor();
+}
+
+void MqttSpool::evictOldest() {
+  evicted++;
+  Serial.println("[MQTT] ⚠️ Spool full, evicting oldest segment (" + String(evicted) + " evicted so far)");
+  dropFront();
+}
+
+void MqttSpool::dropFront() {
+  uint32_t seq = segments.front();
+  String path = segmentPath(seq);
+
+  File file = SPIFFS.open(path, FILE_READ);
+  if (file) {
+    size_t size = file.size();
+    file.close();
+    totalBytes -= std::min(totalBytes, size);
+  }
+  SPIFFS.remove(path);
+
+  segments.erase(segments.begin());
+  if (segments.empty()) {
+    writeOpen = false;
+    writeSize = 0;
+  }
+
+  readOffset = 0;
+  nextReadOffset = 0;
+  cursorDirty = false;
+  prefs.putUInt("seq", segments.empty() ? seq : segments.front());
+  prefs.putUInt("off", 0);
+}
+
+void MqttSpool::saveCursor() {
+  prefs.putUInt("seq", segments.front());
+  prefs.putUInt("off", readOffset);
+  cursorDirty = false;
+}
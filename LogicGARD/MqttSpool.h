@@ -0,0 +1,69 @@
+#pragma once
+#include <Arduino.h>
+#include <FS.h>
+#include <Preferences.h>
+#include <vector>
+#include "BaseComponent.h"
+
+// Append-only store-and-forward queue for MQTT payloads on SPIFFS.
+//
+// Payloads are appended as CRC-protected records to numbered segment files
+// under /mqtt. The read cursor (segment, offset) lives in NVS. pop() only
+// moves it in RAM; it reaches flash when a segment is retired and on
+// commit(), which the caller issues once per replay batch, so NVS sees a
+// few writes per reconnect rather than one per payload. A reboot mid-batch
+// resends that batch's payloads (at-least-once). When the spool exceeds
+// maxBytes the oldest segment is evicted. A record torn by a power cut
+// fails its CRC and ends that segment; appends after boot always start a
+// fresh segment.
+class MqttSpool : public BaseComponent {
+public:
+  static constexpr LogTag logTag = LogTag::Mqtt;
+
+  // Fails if the NVS namespace holding the cursor cannot be opened
+  bool begin(size_t maxBytes, size_t maxRecordBytes);
+
+  bool append(const char* data, size_t length);
+
+  // Reads the oldest unsent payload into buffer (capacity bytes). Returns
+  // its length, or 0 when the spool is empty.
+  size_t peek(char* buffer, size_t capacity);
+
+  // Marks the payload returned by the last peek() as sent.
+  void pop();
+
+  // Persists the read cursor; call after a run of pop()s.
+  void commit();
+
+  bool isEmpty() const { return segments.empty(); }
+  size_t sizeBytes() const { return totalBytes; }
+  uint32_t evictedCount() const { return evicted; }
+
+private:
+  struct RecordHeader {
+    uint16_t magic;
+    uint16_t length;
+    uint32_t crc;
+  };
+
+  static constexpr uint16_t RECORD_MAGIC = 0x5A17;
+
+  String segmentPath(uint32_t seq) const;
+  bool startSegment();
+  void evictOldest();
+  void dropFront();
+  void saveCursor();
+
+  Preferences prefs;
+  std::vector<uint32_t> segments;   // Sequence numbers, oldest first
+  size_t maxBytes = 0;
+  size_t segmentBytes = 0;
+  size_t totalBytes = 0;
+  size_t writeSize = 0;             // Size of segments.back()
+  bool writeOpen = false;           // False until this boot's first append
+  uint32_t readOffset = 0;          // Offset into segments.front()
+  uint32_t nextReadOffset = 0;      // Offset after the last peeked record
+  bool cursorDirty = false;         // readOffset moved since the last save
+  uint32_t evicted = 0;
+  bool ready = false;
+};
@@ -18,27 +18,27 @@ OtaManager::OtaManager(const OtaConfig& config, const DeviceIdentity& identity)
 }
 
 void OtaManager::begin() {
-  BaseComponent::debugLog("[OTA] Initializing OTA state tracker");
+  LOG_DEBUG("[OTA] Initializing OTA state tracker");
   stateTracker.begin();
 }
 
 void OtaManager::loop() {
   if (!config.enabled) {
-    BaseComponent::debugLog("[OTA] Skipping loop—OTA disabled");
+    LOG_DEBUG("[OTA] Skipping loop—OTA disabled");
     flag = -1;
     return;
   }
 
   if (!shouldCheck()) {
-    BaseComponent::debugLog("[OTA] Skipping loop—check interval not reached");
+    LOG_DEBUG("[OTA] Skipping loop—check interval not reached");
     return;
   }
 
-  BaseComponent::debugLog("[OTA] Starting OTA loop");
+  LOG_DEBUG("[OTA] Starting OTA loop");
 
   FirmwareManifest manifest;
   if (!fetchManifest(manifest)) {
-    BaseComponent::debugLog("[OTA] Manifest fetch failed—skipping update check");
+    LOG_DEBUG("[OTA] Manifest fetch failed—skipping update check");
     flag = -1;
     return;
   }
@@ -46,37 +46,37 @@ void OtaManager::loop() {
   flag = 1;  // Manifest successfully fetched
 
   if (stateTracker.shouldApplyUpdate(manifest.version, manifest.mandatory)) {
-    BaseComponent::debugLog("[OTA] Update required—applying version " + manifest.version);
+    LOG_DEBUG("[OTA] Update required—applying version %s", manifest.version.c_str());
     applyUpdate(manifest);
     stateTracker.markVersionApplied(manifest.version);
-    BaseComponent::debugLog("[OTA] Update applied and version marked");
+    LOG_DEBUG("[OTA] Update applied and version marked");
   } else {
-    BaseComponent::debugLog("[OTA] No update required—version already applied or not mandatory");
+    LOG_DEBUG("[OTA] No update required—version already applied or not mandatory");
   }
 
   lastCheckTime = millis();
-  BaseComponent::debugLog("[OTA] Updated lastCheckTime to " + String(lastCheckTime));
+  LOG_DEBUG("[OTA] Updated lastCheckTime to %lu", (unsigned long)lastCheckTime);
 }
 
 bool OtaManager::shouldCheck() {
   uint32_t elapsed = millis() - lastCheckTime;
-  BaseComponent::debugLog("[OTA] Time since last check: " + String(elapsed) + " ms");
+  LOG_DEBUG("[OTA] Time since last check: %lu ms", (unsigned long)elapsed);
   return elapsed >= config.checkIntervalMs;
 }
 
 bool OtaManager::fetchManifest(FirmwareManifest& manifest) {
-  BaseComponent::debugLog("[OTA] Fetching manifest from: " + config.checkInUrl);
+  LOG_DEBUG("[OTA] Fetching manifest from: %s", config.checkInUrl.c_str());
 
   HTTPClient client;
   if (!client.begin(config.checkInUrl)) {
     Serial.println("[OTA] ❌ Failed to initialize HTTPClient with URL: " + config.checkInUrl);
-    BaseComponent::debugLog("[OTA] HTTPClient.begin() failed");
+    LOG_DEBUG("[OTA] HTTPClient.begin() failed");
     flag = -1;
     return false;
   }
 
   if (!config.credentials.username.isEmpty()) {
-    BaseComponent::debugLog("[OTA] Setting HTTP basic auth");
+    LOG_DEBUG("[OTA] Setting HTTP basic auth");
     client.setAuthorization(
       config.credentials.username.c_str(),
       config.credentials.password.c_str()
@@ -85,51 +85,51 @@ bool OtaManager::fetchManifest(FirmwareManifest& manifest) {
 
   client.addHeader("Content-Type", "application/json");
   String payload = identity.toJson();
-  BaseComponent::debugLog("[OTA] Sending identity payload: " + payload);
+  LOG_DEBUG("[OTA] Sending identity payload: %s", payload.c_str());
 
   int httpCode = client.POST(payload);
-  BaseComponent::debugLog("[OTA] HTTP POST returned code: " + String(httpCode));
+  LOG_DEBUG("[OTA] HTTP POST returned code: %d", httpCode);
 
   if (httpCode == 204) {
     Serial.println("[OTA] ✅ No update available");
-    BaseComponent::debugLog("[OTA] Server responded with 204—no update");
+    LOG_DEBUG("[OTA] Server responded with 204—no update");
     client.end();
     return false;
   }
 
   if (httpCode != 200) {
     Serial.println("[OTA] ❌ Manifest fetch failed, HTTP code: " + String(httpCode));
-    BaseComponent::debugLog("[OTA] Unexpected HTTP code: " + String(httpCode));
+    LOG_DEBUG("[OTA] Unexpected HTTP code: %d", httpCode);
     flag = -1;
     client.end();
     return false;
   }
 
   String response = client.getString();
-  BaseComponent::debugLog("[OTA] 🔍 Raw manifest response:");
-  BaseComponent::debugLog(response);
+  LOG_DEBUG("[OTA] 🔍 Raw manifest response:");
+  LOG_DEBUG("%s", response.c_str());
   client.end();
 
   if (!manifest.parse(response)) {
-    BaseComponent::debugLog("[OTA] ❌ Failed to parse manifest");
+    LOG_DEBUG("[OTA] ❌ Failed to parse manifest");
     flag = -1;
     return false;
   }
 
-  BaseComponent::debugLog("[OTA] ✅ Manifest parsed:");
-  BaseComponent::debugLog("  version: " + manifest.version);
-  BaseComponent::debugLog("  url: " + manifest.url);
-  BaseComponent::debugLog("  configUrl: " + manifest.configUrl);
-  BaseComponent::debugLog("  checksum: " + manifest.checksum);
-  BaseComponent::debugLog("  description: " + manifest.description);
-  BaseComponent::debugLog("  mandatory: " + String(manifest.mandatory ? "true" : "false"));
-  BaseComponent::debugLog("  updateType: " + String(static_cast<int>(manifest.updateType)));
+  LOG_DEBUG("[OTA] ✅ Manifest parsed:");
+  LOG_DEBUG("  version: %s", manifest.version.c_str());
+  LOG_DEBUG("  url: %s", manifest.url.c_str());
+  LOG_DEBUG("  configUrl: %s", manifest.configUrl.c_str());
+  LOG_DEBUG("  checksum: %s", manifest.checksum.c_str());
+  LOG_DEBUG("  description: %s", manifest.description.c_str());
+  LOG_DEBUG("  mandatory: %s", manifest.mandatory ? "true" : "false");
+  LOG_DEBUG("  updateType: %d", static_cast<int>(manifest.updateType));
 
   return true;
 }
 
 void OtaManager::applyUpdate(const FirmwareManifest& manifest) {
-  BaseComponent::debugLog("[OTA] Applying update for version: " + manifest.version);
+  LOG_DEBUG("[OTA] Applying update for version: %s", manifest.version.c_str());
 
   if ((manifest.updateType == UpdateType::Binary || manifest.updateType == UpdateType::All) &&
       !manifest.url.isEmpty()) {
@@ -138,25 +138,25 @@ void OtaManager::applyUpdate(const FirmwareManifest& manifest) {
 
   if ((manifest.updateType == UpdateType::User || manifest.updateType == UpdateType::All) &&
       !manifest.configUrl.isEmpty()) {
-    BaseComponent::debugLog("[OTA] Fetching user config from: " + manifest.configUrl);
+    LOG_DEBUG("[OTA] Fetching user config from: %s", manifest.configUrl.c_str());
     fetchAndApplyConfig(manifest.configUrl, userConfig, "User");
   }
 
   if ((manifest.updateType == UpdateType::Admin || manifest.updateType == UpdateType::All) &&
       !manifest.configUrl.isEmpty()) {
-    BaseComponent::debugLog("[OTA] Fetching admin config from: " + manifest.configUrl);
+    LOG_DEBUG("[OTA] Fetching admin config from: %s", manifest.configUrl.c_str());
     fetchAndApplyConfig(manifest.configUrl, adminConfig, "Admin");
   }
 
   if (manifest.updateType == UpdateType::DebugEnable) {
     Serial.println("[OTA] 🐞 Enabling debug logging as per manifest");
-    BaseComponent::debugLog("[OTA] Enabling debug logging");
+    LOG_DEBUG("[OTA] Enabling debug logging");
     BaseComponent::enableDebug(true);
   }
 
   if (manifest.updateType == UpdateType::DebugDisable) {
     Serial.println("[OTA] 🐞 Disabling debug logging as per manifest");
-    BaseComponent::debugLog("[OTA] Disabling debug logging");
+    LOG_DEBUG("[OTA] Disabling debug logging");
     BaseComponent::enableDebug(false);
   }
 }
@@ -167,7 +167,7 @@ void OtaManager::performFirmwareUpdate(const FirmwareManifest& manifest) {
   HTTPClient client;
   if (!client.begin(manifest.url)) {
     Serial.println("[OTA] ❌ Failed to initialize HTTPClient with firmware URL");
-    BaseComponent::debugLog("[OTA] HTTPClient.begin() failed for URL: " + manifest.url);
+    LOG_DEBUG("[OTA] HTTPClient.begin() failed for URL: %s", manifest.url.c_str());
     flag = -1;
     return;
   }
@@ -175,7 +175,7 @@ void OtaManager::performFirmwareUpdate(const FirmwareManifest& manifest) {
   client.setTimeout(20000);
 
   if (!config.credentials.username.isEmpty()) {
-    BaseComponent::debugLog("[OTA] Setting HTTP basic auth");
+    LOG_DEBUG("[OTA] Setting HTTP basic auth");
     client.setAuthorization(
       config.credentials.username.c_str(),
       config.credentials.password.c_str()
@@ -190,19 +190,19 @@ void OtaManager::performFirmwareUpdate(const FirmwareManifest& manifest) {
       Serial.println("[OTA] ❌ Update failed");
       Serial.println("[OTA] Error code: " + String(httpUpdate.getLastError()));
       Serial.println("[OTA] Error message: " + httpUpdate.getLastErrorString());
-      BaseComponent::debugLog("[OTA] Update failed with error: " + httpUpdate.getLastErrorString());
+      LOG_DEBUG("[OTA] Update failed with error: %s", httpUpdate.getLastErrorString().c_str());
       flag = -1;
       break;
 
     case HTTP_UPDATE_NO_UPDATES:
       Serial.println("[OTA] ⚠️ No updates available");
-      BaseComponent::debugLog("[OTA] Server responded but no update was provided");
+      LOG_DEBUG("[OTA] Server responded but no update was provided");
       flag = -1;
       break;
 
     case HTTP_UPDATE_OK:
       Serial.println("[OTA] ✅ Update successful. Rebooting ...");
-      BaseComponent::debugLog("[OTA] Firmware update completed. Triggering manual reboot.");
+      LOG_DEBUG("[OTA] Firmware update completed. Triggering manual reboot.");
       flag = 1;
       delay(100);
       ESP.restart();
@@ -211,18 +211,18 @@ void OtaManager::performFirmwareUpdate(const FirmwareManifest& manifest) {
 }
 
 void OtaManager::fetchAndApplyConfig(const String& url, ConfigBase& fileConfig, const String& label) {
-  BaseComponent::debugLog("[OTA] Fetching " + label + " config from: " + url);
+  LOG_DEBUG("[OTA] Fetching %s config from: %s", label.c_str(), url.c_str());
 
   HTTPClient client;
   if (!client.begin(url)) {
     Serial.println("[OTA] ❌ Failed to initialize HTTPClient for " + label + " config");
-    BaseComponent::debugLog("[OTA] HTTPClient.begin() failed for " + label + " config");
+    LOG_DEBUG("[OTA] HTTPClient.begin() failed for %s config", label.c_str());
     flag = -1;
     return;
   }
 
   if (!config.credentials.username.isEmpty()) {
-    BaseComponent::debugLog("[OTA] Setting HTTP basic auth for " + label + " config");
+    LOG_DEBUG("[OTA] Setting HTTP basic auth for %s config", label.c_str());
     client.setAuthorization(
       config.credentials.username.c_str(),
       config.credentials.password.c_str()
@@ -230,28 +230,28 @@ void OtaManager::fetchAndApplyConfig(const String& url, ConfigBase& fileConfig,
   }
 
   int httpCode = client.GET();
-  BaseComponent::debugLog("[OTA] HTTP GET returned code: " + String(httpCode));
+  LOG_DEBUG("[OTA] HTTP GET returned code: %d", httpCode);
 
   if (httpCode != 200) {
     Serial.println("[OTA] ❌ " + label + " config fetch failed, HTTP code: " + String(httpCode));
-    BaseComponent::debugLog("[OTA] Failed to fetch " + label + " config—HTTP code: " + String(httpCode));
+    LOG_DEBUG("[OTA] Failed to fetch %s config—HTTP code: %d", label.c_str(), httpCode);
     flag = -1;
     client.end();
     return;
   }
 
   String configJson = client.getString();
-  BaseComponent::debugLog("[OTA] Received " + label + " config JSON:");
-  BaseComponent::debugLog(configJson);
+  LOG_DEBUG("[OTA] Received %s config JSON:", label.c_str());
+  LOG_DEBUG("%s", configJson.c_str());
   client.end();
 
   if (!fileConfig.updateFromJsonString(configJson)) {
     Serial.println("[OTA] ❌ Failed to apply " + label + " config");
-    BaseComponent::debugLog("[OTA] Failed to apply " + label + " config");
+    LOG_DEBUG("[OTA] Failed to apply %s config", label.c_str());
     flag = -1;
   } else {
     Serial.println("[OTA] ✅ " + label + " config applied successfully");
-    BaseComponent::debugLog("[OTA] " + label + " config applied successfully, restarting ...");
+    LOG_DEBUG("[OTA] %s config applied successfully, restarting ...", label.c_str());
     flag = 1;
     delay(3000);
     ESP.restart();
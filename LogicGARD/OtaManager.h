@@ -6,6 +6,8 @@
 
 class OtaManager : public BaseComponent, public IDisplay {
 public:
+  static constexpr LogTag logTag = LogTag::Ota;
+
   OtaManager(const OtaConfig& config, const DeviceIdentity& identity);
   void begin();
   void loop();
@@ -0,0 +1,89 @@
+#include "OverlayBatcher.h"
+#include "OverlayManager.h"
+
+OverlayBatcher::OverlayBatcher(std::shared_ptr<SecureHttpClient> client)
+  : client(client) {
+  mutex = xSemaphoreCreateMutex();
+  sendMutex = xSemaphoreCreateMutex();
+  if (!mutex || !sendMutex) {
+    Serial.println("[Overlay] ❌ Batcher mutex creation failed");
+  }
+}
+
+bool OverlayBatcher::begin(uint32_t stackSize) {
+  if (flushTask) return true;
+  if (xTaskCreate(flushTaskEntry, "OverlayFlush", stackSize, this, 1, &flushTask) != pdPASS) {
+    Serial.println("[Overlay] ❌ Failed to start batch flush task, posting inline");
+    flushTask = nullptr;
+    return false;
+  }
+  return true;
+}
+
+// Sleeps until a submit opens a window, lets the window run, then posts
+// the batch. Only this task uses the client, so batches never overlap.
+void OverlayBatcher::flushTaskEntry(void* param) {
+  OverlayBatcher* self = static_cast<OverlayBatcher*>(param);
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    vTaskDelay(pdMS_TO_TICKS(WINDOW_MS));
+    self->flush();
+  }
+}
+
+void OverlayBatcher::submit(OverlayManager* overlay, const String& payload, int identity, uint32_t createdUs) {
+  if (!mutex || !sendMutex || !xSemaphoreTake(mutex, portMAX_DELAY)) return;
+
+  bool replaced = false;
+  for (Pending& entry : pending) {
+    if (entry.overlay == overlay) {
+      entry.payload = payload;
+      entry.identity = identity;
+      entry.createdUs = createdUs;
+      replaced = true;
+      break;
+    }
+  }
+  if (!replaced) {
+    pending.push_back({ overlay, payload, identity, createdUs });
+  }
+
+  bool lead = !windowOpen;
+  windowOpen = true;
+  xSemaphoreGive(mutex);
+
+  if (!lead) return;
+
+  if (flushTask) {
+    xTaskNotifyGive(flushTask);
+  } else {
+    flush();
+  }
+}
+
+void OverlayBatcher::flush() {
+  std::vector<Pending> sending;
+  if (!xSemaphoreTake(mutex, portMAX_DELAY)) return;
+  std::swap(sending, pending);
+  windowOpen = false;
+  xSemaphoreGive(mutex);
+
+  // Without the flush task, a later window's submitter may get here while
+  // this batch is still being sent; keep the shared client single-user.
+  if (!xSemaphoreTake(sendMutex, portMAX_DELAY)) return;
+
+  std::vector<HttpBatchItem> items;
+  items.reserve(sending.size());
+  for (const Pending& entry : sending) {
+    items.push_back({ entry.payload, String(), false });
+  }
+
+  LOG_DEBUG("OverlayBatcher::flush - Posting %u overlay update(s)", (unsigned)items.size());
+  client->postBatch(items);
+  xSemaphoreGive(sendMutex);
+
+  for (size_t i = 0; i < sending.size(); ++i) {
+    const Pending& entry = sending[i];
+    entry.overlay->onPosted(entry.payload, entry.identity, items[i].ok, items[i].response, entry.createdUs);
+  }
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <Arduino.h>
+#include <memory>
+#include <vector>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include "SecureHttpClient.h"
+#include "BaseComponent.h"
+
+class OverlayManager;
+
+// Camera-level batching of overlay updates. The Axis overlay API has no
+// multi-update call, so a batch is sent as consecutive requests on one
+// keep-alive connection.
+//
+// submit() only queues the payload and returns, so consumer workers never
+// wait on the camera. The first submit of a window wakes the batcher's
+// flush task, which waits WINDOW_MS for the camera's other overlays to
+// submit and then posts everything that is pending. A second submit from
+// the same overlay replaces its first.
+class OverlayBatcher : public BaseComponent {
+public:
+  static constexpr LogTag logTag = LogTag::Overlay;
+
+  static constexpr uint32_t WINDOW_MS = 250;
+
+  explicit OverlayBatcher(std::shared_ptr<SecureHttpClient> client);
+
+  // Starts the flush task; without it submit() posts inline
+  bool begin(uint32_t stackSize = 6144);
+
+  // identity is the one the payload was built for (0 for addText)
+  void submit(OverlayManager* overlay, const String& payload, int identity, uint32_t createdUs);
+
+private:
+  struct Pending {
+    OverlayManager* overlay;
+    String payload;
+    int identity;
+    uint32_t createdUs;
+  };
+
+  static void flushTaskEntry(void* param);
+  void flush();
+
+  std::shared_ptr<SecureHttpClient> client;
+  std::vector<Pending> pending;
+  bool windowOpen = false;
+  SemaphoreHandle_t mutex;
+  SemaphoreHandle_t sendMutex;   // Only contended when posting inline
+  TaskHandle_t flushTask = nullptr;
+};
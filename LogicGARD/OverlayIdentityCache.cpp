@@ -0,0 +1,121 @@
+#include <ArduinoJson.h>
+#include "OverlayIdentityCache.h"
+
+namespace {
+// What the filtered list keeps in the worst case we support: MAX_OVERLAYS
+// overlays whose indicators are at most MAX_INDICATOR_LEN characters. The
+// rest of each overlay (text, position, colors...) is filtered out and
+// costs nothing, however long it is.
+constexpr size_t MAX_OVERLAYS = 32;
+constexpr size_t MAX_INDICATOR_LEN = 32;
+constexpr size_t LIST_DOC_SIZE =
+  JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(4) +                // "data"
+  JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(12) +               // "textOverlays"
+  JSON_ARRAY_SIZE(MAX_OVERLAYS) +
+  MAX_OVERLAYS * (JSON_OBJECT_SIZE(2) + JSON_STRING_SIZE(MAX_INDICATOR_LEN)) +
+  JSON_STRING_SIZE(9) + JSON_STRING_SIZE(8);                 // "indicator", "identity"
+}
+
+OverlayIdentityCache::OverlayIdentityCache() {
+  mutex = xSemaphoreCreateMutex();
+  if (!mutex) {
+    Serial.println("[Overlay] ❌ Identity cache mutex creation failed");
+  }
+}
+
+int OverlayIdentityCache::lookup(const String& indicator, SecureHttpClient& client) {
+  if (!mutex || !xSemaphoreTake(mutex, portMAX_DELAY)) return -1;
+
+  // Holding the lock while listing lets sibling overlays wait for this
+  // one list call instead of issuing their own.
+  int identity = -1;
+  if (loaded || refresh(client)) {
+    identity = 0;
+    for (const auto& entry : entries) {
+      if (entry.first == indicator) {
+        identity = entry.second;
+        break;
+      }
+    }
+  }
+
+  xSemaphoreGive(mutex);
+  LOG_DEBUG("OverlayIdentityCache::lookup - %s → %d", indicator.c_str(), identity);
+  return identity;
+}
+
+void OverlayIdentityCache::store(const String& indicator, int identity) {
+  if (!mutex || !xSemaphoreTake(mutex, portMAX_DELAY)) return;
+
+  bool updated = false;
+  for (auto& entry : entries) {
+    if (entry.first == indicator) {
+      entry.second = identity;
+      updated = true;
+      break;
+    }
+  }
+  if (!updated) {
+    entries.emplace_back(indicator, identity);
+  }
+
+  xSemaphoreGive(mutex);
+}
+
+void OverlayIdentityCache::invalidate() {
+  if (!mutex || !xSemaphoreTake(mutex, portMAX_DELAY)) return;
+  LOG_DEBUG("OverlayIdentityCache::invalidate - Dropping %u cached identities", (unsigned)entries.size());
+  entries.clear();
+  loaded = false;
+  xSemaphoreGive(mutex);
+}
+
+bool OverlayIdentityCache::refresh(SecureHttpClient& client) {
+  LOG_DEBUG("OverlayIdentityCache::refresh - Listing camera overlays");
+
+  String listPayload = R"({
+    "apiVersion": "1.0",
+    "method": "list",
+    "params": {}
+  })";
+
+  String response;
+  int code = client.postWithResponse(listPayload, response);
+
+  if (code <= 0) {
+    LOG_DEBUG("OverlayIdentityCache::refresh - Error: failed to fetch overlay list");
+    return false;
+  }
+
+  // Only indicator and identity are kept, so the parsed document stays
+  // within LIST_DOC_SIZE however much else the camera reports.
+  StaticJsonDocument<128> filter;
+  filter["data"]["textOverlays"][0]["indicator"] = true;
+  filter["data"]["textOverlays"][0]["identity"] = true;
+
+  DynamicJsonDocument doc(LIST_DOC_SIZE);
+  DeserializationError err = deserializeJson(doc, response, DeserializationOption::Filter(filter));
+  if (err == DeserializationError::NoMemory) {
+    Serial.printf("[Overlay] ❌ Overlay list exceeds %u overlays with %u-character indicators\n",
+                  (unsigned)MAX_OVERLAYS, (unsigned)MAX_INDICATOR_LEN);
+    return false;
+  }
+  if (err) {
+    LOG_DEBUG("OverlayIdentityCache::refresh - Error: JSON parse failed: %s", err.c_str());
+    return false;
+  }
+
+  entries.clear();
+  JsonArray overlays = doc["data"]["textOverlays"].as<JsonArray>();
+  for (JsonObject overlay : overlays) {
+    String indicator = overlay["indicator"] | "";
+    int identity = overlay["identity"] | 0;
+    if (!indicator.isEmpty() && identity > 0) {
+      entries.emplace_back(indicator, identity);
+    }
+  }
+
+  loaded = true;
+  LOG_DEBUG("OverlayIdentityCache::refresh - Cached %u overlay identities", (unsigned)entries.size());
+  return true;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <Arduino.h>
+#include <vector>
+#include <utility>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "SecureHttpClient.h"
+#include "BaseComponent.h"
+
+// Indicator → overlay identity map for one camera, shared by all of its
+// OverlayManagers. The first lookup fills it with a single `list` call;
+// it is refilled only after invalidate(), which OverlayManager calls when
+// the camera rejects a setText for an unknown identity.
+class OverlayIdentityCache : public BaseComponent {
+public:
+  static constexpr LogTag logTag = LogTag::Overlay;
+
+  OverlayIdentityCache();
+
+  // Returns the identity for indicator, 0 if the camera has no such
+  // overlay, or -1 if the overlay list could not be fetched.
+  int lookup(const String& indicator, SecureHttpClient& client);
+
+  // Records the identity of an overlay created with addText.
+  void store(const String& indicator, int identity);
+
+  void invalidate();
+
+private:
+  bool refresh(SecureHttpClient& client);
+
+  std::vector<std::pair<String, int>> entries;
+  bool loaded = false;
+  SemaphoreHandle_t mutex;
+};
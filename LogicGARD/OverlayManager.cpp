@@ -4,103 +4,157 @@
 
 #include "OverlayManager.h"
 #include "OverlayPayloadBuilder.h"
+#include "PipelineStats.h"
 #include "TimeUtils.h"
 
-OverlayManager::OverlayManager(const OverlayConfig& config, std::shared_ptr<SecureHttpClient> client)
+OverlayManager::OverlayManager(const OverlayConfig& config, std::shared_ptr<SecureHttpClient> client,
+                               std::shared_ptr<OverlayIdentityCache> identities,
+                               std::shared_ptr<OverlayBatcher> batcher)
   : MessageConsumer(config.sensorId),
     config(config),
-    client(client) {
-  BaseComponent::debugLog("OverlayManager::constructor - 🛠 Creating OverlayManager instance...");
-
-  BaseComponent::debugLog("  sensor: [" + config.sensorId + "]");
-  BaseComponent::debugLog("  identity: [" + String(config.identity) + "]");
-  BaseComponent::debugLog("  camera: [" + String(config.camera) + "]");
-  BaseComponent::debugLog("  indicator: [" + config.indicator + "]");
-  BaseComponent::debugLog("  text: [" + config.text + "]");
-  BaseComponent::debugLog("  position: [" + config.position + "]");
-  BaseComponent::debugLog("  fontSize: [" + String(config.fontSize) + "]");
-  BaseComponent::debugLog("  textColor: [" + config.textColor + "]");
+    client(client),
+    identities(identities),
+    batcher(batcher),
+    textTemplate(config.text) {
+  stateLock = xSemaphoreCreateMutex();
+  LOG_DEBUG("OverlayManager::constructor - 🛠 Creating OverlayManager instance...");
+
+  LOG_DEBUG("  sensor: [%s]", config.sensorId.c_str());
+  LOG_DEBUG("  identity: [%d]", config.identity);
+  LOG_DEBUG("  camera: [%d]", config.camera);
+  LOG_DEBUG("  indicator: [%s]", config.indicator.c_str());
+  LOG_DEBUG("  text: [%s]", config.text.c_str());
+  LOG_DEBUG("  position: [%s]", config.position.c_str());
+  LOG_DEBUG("  fontSize: [%d]", config.fontSize);
+  LOG_DEBUG("  textColor: [%s]", config.textColor.c_str());
+  LOG_DEBUG("  unit: [%s]", unitSymbol(config.unit));
 
   flag = 0;  // neutral until first update
 }
 
 void OverlayManager::begin(MessageDispatcher& dispatcher) {
-  BaseComponent::debugLog("OverlayManager::begin - Registering with dispatcher...");
-  MessageConsumer::begin();
+  LOG_DEBUG("OverlayManager::begin - Registering with dispatcher...");
+  MessageConsumer::begin(config.queue);
   dispatcher.registerConsumer(this);
-  BaseComponent::debugLog("OverlayManager::begin - Registration complete.");
+  LOG_DEBUG("OverlayManager::begin - Registration complete.");
 }
 
-void OverlayManager::process(const TemperatureMessage& msg) {
-  BaseComponent::debugLog("OverlayManager::process - Received temperature message.");
+void OverlayManager::process(const SensorMessage& msg) {
+  LOG_DEBUG("OverlayManager::process - Received temperature message.");
 
   auto identity = config.identity;
 
   if (identity == 0) {
-    identity = resolveIdentity(config.indicator);
-    BaseComponent::debugLog("OverlayManager::process - Resolved identity: " + String(identity));
+    // 0 from the cache means the overlay does not exist yet: addText
+    identity = identities->lookup(config.indicator, *client);
+    LOG_DEBUG("OverlayManager::process - Resolved identity: %d", identity);
   }
 
   if (identity < 0) {
-    BaseComponent::debugLog("OverlayManager::process - Error: invalid identity, aborting overlay update.");
+    LOG_DEBUG("OverlayManager::process - Error: invalid identity, aborting overlay update.");
     flag = -1;
     return;
   }
 
-  String payload = OverlayPayloadBuilder::buildTextPayload(
-    config, identity, msg.timestamp, msg.temperature);
+  OverlayValues values;
+  values.timestamp = msg.timestamp;
+  if (msg.has(Channel::Temperature)) {
+    int32_t temperature = msg.wholeTemperature(config.unit);
+    if (!haveRange || temperature < minTemperature) minTemperature = temperature;
+    if (!haveRange || temperature > maxTemperature) maxTemperature = temperature;
+    haveRange = true;
+
+    values.hasTemperature = true;
+    values.temperature = temperature;
+    values.minTemperature = minTemperature;
+    values.maxTemperature = maxTemperature;
+  }
+  values.hasHumidity = msg.has(Channel::Humidity);
+  values.humidity = msg.whole(Channel::Humidity);
+  values.hasPressure = msg.has(Channel::Pressure);
+  values.pressure = msg.whole(Channel::Pressure);
+  values.sensor = msg.sensorId();
+  values.unit = unitSymbol(config.unit);
+  if (textTemplate.render(textBuffer, sizeof(textBuffer), values) >= sizeof(textBuffer)) {
+    LOG_DEBUG("OverlayManager::process - Error: text for overlay '%s' exceeds %u bytes", config.indicator.c_str(),
+              (unsigned)(sizeof(textBuffer) - 1));
+    flag = -1;
+    return;
+  }
 
-  if (payload.isEmpty()) {
-    BaseComponent::debugLog("OverlayManager::process - Error: failed to build payload for overlay '" + config.indicator + "'");
+  const char* payload = payloadBuffer;
+  if (OverlayPayloadBuilder::buildTextPayload(payloadBuffer, sizeof(payloadBuffer), config, identity, textBuffer) == 0) {
+    LOG_DEBUG("OverlayManager::process - Error: failed to build payload for overlay '%s'", config.indicator.c_str());
     flag = -1;
     return;
   }
 
-  BaseComponent::debugLog("OverlayManager::process - Posting payload: " + payload);
-  bool success = client->post(payload.c_str());
+  bool unchanged = false;
+  if (stateLock && xSemaphoreTake(stateLock, portMAX_DELAY)) {
+    unchanged = payload == lastPosted && millis() - lastPostedMs < UNCHANGED_REFRESH_MS;
+    if (unchanged) ++skippedPosts;
+    xSemaphoreGive(stateLock);
+  }
+
+  if (unchanged) {
+    LOG_DEBUG("OverlayManager::process - Text unchanged, skipping post (%lu skipped)", (unsigned long)skippedPosts);
+    return;
+  }
 
-  flag = success ? 1 : -1;
+  LOG_DEBUG("OverlayManager::process - Queuing payload for camera batch: %s", payload);
+  batcher->submit(this, payload, identity, msg.createdUs);
 }
 
-int OverlayManager::resolveIdentity(String indicator) {
-  BaseComponent::debugLog("OverlayManager::resolveIdentity - Resolving identity for indicator: " + indicator);
-
-  String listPayload = R"({
-    "apiVersion": "1.0",
-    "method": "list",
-    "params": {}
-  })";
+void OverlayManager::onPosted(const String& payload, int identity, bool success,
+                              const String& response, uint32_t createdUs) {
+  success = success && handleResponse(identity, response);
 
-  String response;
-  int code = client->postWithResponse(listPayload, response);
+  if (success) {
+    PipelineStats::recordLatency(PipelineStage::Overlay, createdUs);
+    PipelineStats::recordTaskResources(PipelineStage::Overlay);
+  }
 
-  if (code <= 0) {
-    BaseComponent::debugLog("OverlayManager::resolveIdentity - Error: failed to fetch overlay list");
-    flag = -1;
-    return -1;
+  if (stateLock && xSemaphoreTake(stateLock, portMAX_DELAY)) {
+    lastPosted = success ? payload : String();
+    lastPostedMs = millis();
+    xSemaphoreGive(stateLock);
   }
 
-  BaseComponent::debugLog("OverlayManager::resolveIdentity - Received response: " + response);
+  flag = success ? 1 : -1;
+}
 
-  DynamicJsonDocument doc(8192);
+// Checks the JSON-RPC reply. addText replies carry the new identity, which
+// is cached; a setText rejected for its identity drops the cache, so the
+// next reading lists again and re-creates the overlay if it is gone.
+bool OverlayManager::handleResponse(int identity, const String& response) {
+  StaticJsonDocument<384> doc;
   DeserializationError err = deserializeJson(doc, response);
   if (err) {
-    BaseComponent::debugLog("OverlayManager::resolveIdentity - Error: JSON parse failed: " + String(err.c_str()));
-    flag = -1;
-    return -2;
+    LOG_DEBUG("OverlayManager::handleResponse - Error: JSON parse failed: %s", err.c_str());
+    return false;
   }
 
-  JsonArray overlays = doc["data"]["textOverlays"].as<JsonArray>();
-  for (JsonObject overlay : overlays) {
-    String found = overlay["indicator"];
-    int id = overlay["identity"];
-    if (found == indicator) {
-      BaseComponent::debugLog("OverlayManager::resolveIdentity - Match found: " + found + " → ID " + String(id));
-      return id;
+  JsonVariantConst error = doc["error"];
+  if (!error.isNull()) {
+    String message = error["message"] | "";
+    LOG_DEBUG("OverlayManager::handleResponse - Camera error %d: %s", error["code"] | 0, message.c_str());
+
+    message.toLowerCase();
+    if (identity > 0 && config.identity == 0 && message.indexOf("identity") >= 0) {
+      identities->invalidate();
     }
+    return false;
   }
 
-  BaseComponent::debugLog("OverlayManager::resolveIdentity - Error: no matching indicator found");
-  flag = -1;
-  return 0;
-}
\ No newline at end of file
+  if (identity == 0) {
+    int created = doc["data"]["identity"] | 0;
+    if (created > 0) {
+      LOG_DEBUG("OverlayManager::handleResponse - Created overlay '%s' with ID %d", config.indicator.c_str(), created);
+      identities->store(config.indicator, created);
+    } else {
+      // Without the new ID the next reading would add a duplicate; relist
+      identities->invalidate();
+    }
+  }
+  return true;
+}
@@ -4,22 +4,54 @@
 #include "Types.h"
 #include "MessageConsumer.h"
 #include "SecureHttpClient.h"
-#include "TemperatureMessage.h"
+#include "OverlayIdentityCache.h"
+#include "OverlayBatcher.h"
+#include "OverlayTemplate.h"
+#include "SensorMessage.h"
 #include "MessageDispatcher.h"
 
 class OverlayManager : public MessageConsumer {
 public:
-OverlayManager(const OverlayConfig& config, std::shared_ptr<SecureHttpClient> client);
+  static constexpr LogTag logTag = LogTag::Overlay;
+
+  // An unchanged overlay is still re-posted this often, in case the
+  // camera restarted and lost it.
+  static constexpr uint32_t UNCHANGED_REFRESH_MS = 5 * 60 * 1000;
+
+OverlayManager(const OverlayConfig& config, std::shared_ptr<SecureHttpClient> client,
+               std::shared_ptr<OverlayIdentityCache> identities,
+               std::shared_ptr<OverlayBatcher> batcher);
 
   void begin(MessageDispatcher& dispatcher);
   int flag;
 
+  // Result of a payload sent by the camera's OverlayBatcher
+  void onPosted(const String& payload, int identity, bool success,
+                const String& response, uint32_t createdUs);
+
 protected:
-  void process(const TemperatureMessage& msg) override;
+  void process(const SensorMessage& msg) override;
   
 private:
   OverlayConfig config;
   std::shared_ptr<SecureHttpClient> client;
+  std::shared_ptr<OverlayIdentityCache> identities;
+  std::shared_ptr<OverlayBatcher> batcher;
+
+  // config.text compiled once; process() renders into fixed buffers
+  OverlayTemplate textTemplate;
+  char textBuffer[128];
+  char payloadBuffer[512];
+  int32_t minTemperature = 0;
+  int32_t maxTemperature = 0;
+  bool haveRange = false;
+
+  // Last payload the camera accepted, to skip posting identical text.
+  // Written by the batch flusher, which may run on another worker.
+  String lastPosted;
+  uint32_t lastPostedMs = 0;
+  uint32_t skippedPosts = 0;
+  SemaphoreHandle_t stateLock;
 
-  int resolveIdentity(String indicator);
+  bool handleResponse(int identity, const String& response);
 };
\ No newline at end of file
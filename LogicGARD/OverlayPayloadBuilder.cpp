@@ -1,56 +1,79 @@
-#include <ArduinoJson.h>
+#include <cstring>
 #include "OverlayPayloadBuilder.h"
 
-String OverlayPayloadBuilder::buildTextPayload(const OverlayConfig& config, int identity, time_t timestamp, int temp) {
-  StaticJsonDocument<512> doc;
-  doc["apiVersion"] = "1.0";
-  JsonObject params = doc.createNestedObject("params");
+namespace {
+// Bounded JSON writer over a caller buffer; `ok` turns false on overflow.
+struct JsonWriter {
+  char* out;
+  size_t cap;
+  size_t pos = 0;
+  bool ok = true;
 
-  String text = OverlayPayloadBuilder::formatOverlay(config.text, timestamp, temp);
+  JsonWriter(char* out, size_t cap) : out(out), cap(cap) {}
 
-  if (identity > 0) {
-    doc["method"] = "setText";
-    params["identity"] = identity;
-    params["text"] = text;
-  } else {
-    doc["method"] = "addText";
-    params["camera"] = config.camera;
-    params["indicator"] = config.indicator;
-    params["text"] = text;
-    params["position"] = config.position;
-    params["fontSize"] = config.fontSize;
-    params["textColor"] = config.textColor;
+  void raw(const char* s, size_t len) {
+    if (!ok || pos + len >= cap) { ok = false; return; }
+    memcpy(out + pos, s, len);
+    pos += len;
+    out[pos] = '\0';
   }
 
-  char buffer[512];
-  size_t len = serializeJson(doc, buffer, sizeof(buffer));
+  void raw(const char* s) { raw(s, strlen(s)); }
 
-  return String(buffer, len);
-}
-
-String OverlayPayloadBuilder::formatOverlay(String templateStr, time_t timestamp, int temp) {
-  struct tm* timeinfo = localtime(&timestamp);
-  
-  if (!timeinfo) {
-    Serial.println("[OverlayPayloadBuilder] Failed to parse timestamp");
-    return templateStr;
+  void number(long value) {
+    char digits[16];
+    int len = snprintf(digits, sizeof(digits), "%ld", value);
+    raw(digits, len);
   }
 
-  int timeStart = templateStr.indexOf("{time:");
-  int timeEnd = templateStr.indexOf("}", timeStart);
-  if (timeStart != -1 && timeEnd != -1) {
-    String formatSpec = templateStr.substring(timeStart + 6, timeEnd);
+  void string(const char* s) {
+    raw("\"", 1);
+    for (; *s && ok; ++s) {
+      char c = *s;
+      if (c == '"' || c == '\\') {
+        char escaped[2] = { '\\', c };
+        raw(escaped, 2);
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        char escaped[7];
+        snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+        raw(escaped, 6);
+      } else {
+        raw(&c, 1);
+      }
+    }
+    raw("\"", 1);
+  }
+};
+}
 
-    char timeBuf[64];
-    strftime(timeBuf, sizeof(timeBuf), formatSpec.c_str(), timeinfo);
+size_t OverlayPayloadBuilder::buildTextPayload(char* out, size_t cap, const OverlayConfig& config, int identity, const char* text) {
+  if (!cap) return 0;
+  JsonWriter json(out, cap);
 
-    String formattedTime = String(timeBuf);
-    templateStr.replace(templateStr.substring(timeStart, timeEnd + 1), formattedTime);
+  if (identity > 0) {
+    json.raw("{\"apiVersion\":\"1.0\",\"method\":\"setText\",\"params\":{\"identity\":");
+    json.number(identity);
+    json.raw(",\"text\":");
+    json.string(text);
   } else {
-    Serial.println("[OverlayPayloadBuilder] No valid time token found.");
+    json.raw("{\"apiVersion\":\"1.0\",\"method\":\"addText\",\"params\":{\"camera\":");
+    json.number(config.camera);
+    json.raw(",\"indicator\":");
+    json.string(config.indicator.c_str());
+    json.raw(",\"text\":");
+    json.string(text);
+    json.raw(",\"position\":");
+    json.string(config.position.c_str());
+    json.raw(",\"fontSize\":");
+    json.number(config.fontSize);
+    json.raw(",\"textColor\":");
+    json.string(config.textColor.c_str());
   }
+  json.raw("}}");
 
-  templateStr.replace("{temp}", String(temp));
-
-  return templateStr;
-}
\ No newline at end of file
+  if (!json.ok) {
+    out[0] = '\0';
+    return 0;
+  }
+  return json.pos;
+}
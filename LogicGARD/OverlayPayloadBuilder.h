@@ -4,7 +4,7 @@
 
 class OverlayPayloadBuilder {
 public:
-  static String buildTextPayload(const OverlayConfig& config, int identity, time_t timestamp, int temp);
-private:
-  static String formatOverlay(String templateStr, time_t timestamp, int temp);
-};
\ No newline at end of file
+  // Writes the setText (identity > 0) or addText request for an already
+  // rendered text into out. Returns its length, or 0 if it does not fit.
+  static size_t buildTextPayload(char* out, size_t cap, const OverlayConfig& config, int identity, const char* text);
+};
@@ -0,0 +1,128 @@
+#include "OverlayTemplate.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+// Indexed by OverlayTemplate::TokenType, skipping Literal and Time
+const char* const tokenNames[] = { "temp", "min", "max", "humidity", "pressure", "sensor", "unit" };
+
+// pos counts every byte asked for, written or not, so it ends up as the
+// untruncated length
+void appendBytes(char* out, size_t cap, size_t& pos, const char* src, size_t len) {
+  if (pos + 1 < cap) {
+    size_t fit = std::min(len, cap - 1 - pos);
+    memcpy(out + pos, src, fit);
+    out[pos + fit] = '\0';
+  }
+  pos += len;
+}
+
+void appendInt(char* out, size_t cap, size_t& pos, int32_t value) {
+  char digits[12];
+  int len = snprintf(digits, sizeof(digits), "%ld", static_cast<long>(value));
+  if (len > 0) appendBytes(out, cap, pos, digits, len);
+}
+
+void appendValue(char* out, size_t cap, size_t& pos, bool present, int32_t value) {
+  if (present) appendInt(out, cap, pos, value);
+  else appendBytes(out, cap, pos, "--", 2);
+}
+}
+
+void OverlayTemplate::addLiteral(const char* start, size_t length) {
+  if (length == 0) return;
+  if (!tokens.empty() && tokens.back().type == TokenType::Literal &&
+      tokens.back().offset + tokens.back().length == strings.size()) {
+    tokens.back().length += length;
+  } else {
+    tokens.push_back({ TokenType::Literal, static_cast<uint16_t>(strings.size()), static_cast<uint16_t>(length) });
+  }
+  strings.insert(strings.end(), start, start + length);
+}
+
+void OverlayTemplate::compile(const String& text) {
+  tokens.clear();
+  strings.clear();
+  hasTime = false;
+
+  const char* p = text.c_str();
+  while (*p) {
+    const char* open = strchr(p, '{');
+    const char* close = open ? strchr(open, '}') : nullptr;
+    if (!open || !close) {
+      addLiteral(p, strlen(p));
+      break;
+    }
+
+    addLiteral(p, open - p);
+    const char* name = open + 1;
+    size_t nameLen = close - name;
+
+    if (nameLen > 5 && strncmp(name, "time:", 5) == 0) {
+      uint16_t offset = static_cast<uint16_t>(strings.size());
+      strings.insert(strings.end(), name + 5, close);
+      strings.push_back('\0');
+      tokens.push_back({ TokenType::Time, offset, static_cast<uint16_t>(nameLen - 5) });
+      hasTime = true;
+    } else {
+      bool known = false;
+      for (size_t i = 0; i < sizeof(tokenNames) / sizeof(tokenNames[0]); ++i) {
+        if (strlen(tokenNames[i]) == nameLen && strncmp(name, tokenNames[i], nameLen) == 0) {
+          tokens.push_back({ static_cast<TokenType>(static_cast<uint8_t>(TokenType::Temp) + i), 0, 0 });
+          known = true;
+          break;
+        }
+      }
+      if (!known) addLiteral(open, close - open + 1);
+    }
+    p = close + 1;
+  }
+}
+
+size_t OverlayTemplate::render(char* out, size_t cap, const OverlayValues& values) const {
+  if (!cap) return 0;
+  out[0] = '\0';
+  size_t pos = 0;
+
+  struct tm timeinfo;
+  bool haveTime = hasTime && localtime_r(&values.timestamp, &timeinfo) != nullptr;
+
+  for (const Token& token : tokens) {
+    switch (token.type) {
+      case TokenType::Literal:
+        appendBytes(out, cap, pos, strings.data() + token.offset, token.length);
+        break;
+      case TokenType::Time:
+        if (haveTime) {
+          // strftime writes nothing usable when the result does not fit, so
+          // format aside and append like any other run
+          char formatted[64];
+          size_t len = strftime(formatted, sizeof(formatted), strings.data() + token.offset, &timeinfo);
+          appendBytes(out, cap, pos, formatted, len);
+        }
+        break;
+      case TokenType::Temp:
+        appendValue(out, cap, pos, values.hasTemperature, values.temperature);
+        break;
+      case TokenType::Min:
+        appendValue(out, cap, pos, values.hasTemperature, values.minTemperature);
+        break;
+      case TokenType::Max:
+        appendValue(out, cap, pos, values.hasTemperature, values.maxTemperature);
+        break;
+      case TokenType::Humidity:
+        appendValue(out, cap, pos, values.hasHumidity, values.humidity);
+        break;
+      case TokenType::Pressure:
+        appendValue(out, cap, pos, values.hasPressure, values.pressure);
+        break;
+      case TokenType::Sensor:
+        appendBytes(out, cap, pos, values.sensor, strlen(values.sensor));
+        break;
+      case TokenType::Unit:
+        appendBytes(out, cap, pos, values.unit, strlen(values.unit));
+        break;
+    }
+  }
+  return pos;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+#include <time.h>
+#include <vector>
+
+// Values an overlay template can show, in whole units; absent ones
+// render as "--".
+struct OverlayValues {
+  time_t timestamp = 0;
+  bool hasTemperature = false;
+  int32_t temperature = 0;   // In `unit`, as are min and max
+  int32_t minTemperature = 0;
+  int32_t maxTemperature = 0;
+  bool hasHumidity = false;
+  int32_t humidity = 0;      // Percent
+  bool hasPressure = false;
+  int32_t pressure = 0;      // hPa
+  const char* sensor = "";
+  const char* unit = "°F";
+};
+
+// An overlay text template compiled once into a token list, so rendering
+// a reading is a walk over the tokens into a caller-supplied buffer with
+// no parsing or heap allocation.
+//
+// Tokens: {temp} {min} {max} {humidity} {pressure} {sensor} {unit} {time:<strftime>}
+// Anything else, including unknown {tokens}, is copied literally.
+class OverlayTemplate {
+public:
+  OverlayTemplate() = default;
+  explicit OverlayTemplate(const String& text) { compile(text); }
+
+  void compile(const String& text);
+
+  // Writes the rendered text into out (always NUL-terminated, truncated to
+  // fit) and, like snprintf, returns the full length it needed: a result
+  // >= cap means the text was cut.
+  size_t render(char* out, size_t cap, const OverlayValues& values) const;
+
+  bool usesTime() const { return hasTime; }
+
+private:
+  enum class TokenType : uint8_t { Literal, Time, Temp, Min, Max, Humidity, Pressure, Sensor, Unit };
+
+  struct Token {
+    TokenType type;
+    uint16_t offset;   // Into `strings`, for Literal and Time
+    uint16_t length;
+  };
+
+  void addLiteral(const char* start, size_t length);
+
+  std::vector<Token> tokens;
+  std::vector<char> strings;   // Literal runs and NUL-terminated time formats
+  bool hasTime = false;
+};
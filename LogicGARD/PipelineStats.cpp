@@ -0,0 +1,121 @@
+#include "PipelineStats.h"
+#include <cstring>
+
+PipelineStats::Histogram PipelineStats::histograms[static_cast<size_t>(PipelineStage::Count)] = {};
+PipelineStats::Resources PipelineStats::resources[static_cast<size_t>(PipelineStage::Count)] = {};
+uint32_t PipelineStats::published = 0;
+uint32_t PipelineStats::dropped = 0;
+uint32_t PipelineStats::queueHighWater = 0;
+uint32_t PipelineStats::windowStartMs = 0;
+portMUX_TYPE PipelineStats::lock = portMUX_INITIALIZER_UNLOCKED;
+
+void PipelineStats::recordPublished() {
+  portENTER_CRITICAL(&lock);
+  ++published;
+  portEXIT_CRITICAL(&lock);
+}
+
+void PipelineStats::recordDropped() {
+  portENTER_CRITICAL(&lock);
+  ++dropped;
+  portEXIT_CRITICAL(&lock);
+}
+
+void PipelineStats::recordQueueDepth(uint32_t depth) {
+  portENTER_CRITICAL(&lock);
+  if (depth > queueHighWater) queueHighWater = depth;
+  portEXIT_CRITICAL(&lock);
+}
+
+void PipelineStats::recordLatency(PipelineStage stage, uint32_t createdUs) {
+  uint32_t latencyUs = micros() - createdUs;
+  size_t bucket = latencyUs == 0 ? 0 : 31 - __builtin_clz(latencyUs);
+  if (bucket >= BUCKETS) bucket = BUCKETS - 1;
+
+  Histogram& histogram = histograms[static_cast<size_t>(stage)];
+  portENTER_CRITICAL(&lock);
+  ++histogram.buckets[bucket];
+  ++histogram.count;
+  if (latencyUs > histogram.maxUs) histogram.maxUs = latencyUs;
+  portEXIT_CRITICAL(&lock);
+}
+
+void PipelineStats::recordTaskResources(PipelineStage stage) {
+  uint32_t stackFree = uxTaskGetStackHighWaterMark(nullptr);
+  uint32_t heapFree = ESP.getFreeHeap();
+
+  Resources& stageResources = resources[static_cast<size_t>(stage)];
+  portENTER_CRITICAL(&lock);
+  if (stageResources.minStackFree == 0 || stackFree < stageResources.minStackFree) {
+    stageResources.minStackFree = stackFree;
+  }
+  if (stageResources.minHeapFree == 0 || heapFree < stageResources.minHeapFree) {
+    stageResources.minHeapFree = heapFree;
+  }
+  portEXIT_CRITICAL(&lock);
+}
+
+// Upper bound of the bucket holding the given percentile
+uint32_t PipelineStats::percentileUs(const Histogram& histogram, uint32_t permille) {
+  if (histogram.count == 0) return 0;
+  uint32_t rank = (static_cast<uint64_t>(histogram.count) * permille + 999) / 1000;
+  uint32_t seen = 0;
+  for (size_t i = 0; i < BUCKETS; ++i) {
+    seen += histogram.buckets[i];
+    if (seen >= rank) {
+      return i + 1 < BUCKETS ? (1UL << (i + 1)) : histogram.maxUs;
+    }
+  }
+  return histogram.maxUs;
+}
+
+void PipelineStats::logSummary() {
+  Histogram snapshot[static_cast<size_t>(PipelineStage::Count)];
+  Resources resourceSnapshot[static_cast<size_t>(PipelineStage::Count)];
+  uint32_t windowPublished, windowDropped, highWater;
+
+  portENTER_CRITICAL(&lock);
+  memcpy(snapshot, histograms, sizeof(snapshot));
+  memcpy(resourceSnapshot, resources, sizeof(resourceSnapshot));
+  windowPublished = published;
+  windowDropped = dropped;
+  highWater = queueHighWater;
+  memset(histograms, 0, sizeof(histograms));
+  memset(resources, 0, sizeof(resources));
+  published = 0;
+  dropped = 0;
+  queueHighWater = 0;
+  portEXIT_CRITICAL(&lock);
+
+  uint32_t now = millis();
+  uint32_t windowMs = now - windowStartMs;
+  windowStartMs = now;
+
+  LOG_INFO("[Pipeline] %lu readings in %lu ms (%.2f/s), %lu dropped, queue high-water %lu",
+           (unsigned long)windowPublished, (unsigned long)windowMs,
+           windowMs ? windowPublished * 1000.0 / windowMs : 0.0,
+           (unsigned long)windowDropped, (unsigned long)highWater);
+
+  static const char* const stageNames[] = { "queue", "mqtt", "overlay" };
+  for (size_t i = 0; i < static_cast<size_t>(PipelineStage::Count); ++i) {
+    const Histogram& histogram = snapshot[i];
+    if (histogram.count == 0) continue;
+    LOG_INFO("[Pipeline] %s latency: n=%lu p50<=%lu us p99<=%lu us max=%lu us",
+             stageNames[i], (unsigned long)histogram.count,
+             (unsigned long)percentileUs(histogram, 500),
+             (unsigned long)percentileUs(histogram, 990),
+             (unsigned long)histogram.maxUs);
+  }
+
+  for (size_t i = 0; i < static_cast<size_t>(PipelineStage::Count); ++i) {
+    const Resources& stageResources = resourceSnapshot[i];
+    if (stageResources.minHeapFree == 0) continue;
+    LOG_INFO("[Pipeline] %s task: stack headroom %lu, heap free low %lu",
+             stageNames[i], (unsigned long)stageResources.minStackFree,
+             (unsigned long)stageResources.minHeapFree);
+  }
+
+  LOG_INFO("[Pipeline] Heap free %lu, min free %lu, largest block %lu",
+           (unsigned long)ESP.getFreeHeap(), (unsigned long)ESP.getMinFreeHeap(),
+           (unsigned long)ESP.getMaxAllocHeap());
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+#include "BaseComponent.h"
+
+// Stages timed from the moment a sensor produced a reading
+enum class PipelineStage : uint8_t {
+  Queue,     // Dispatcher enqueue until a consumer task picks it up
+  Mqtt,      // Until the batch carrying it was written to the broker
+  Overlay,   // Until the camera accepted the overlay update
+  Count
+};
+
+// Process-wide counters for the sensor → dispatcher → consumer → network
+// pipeline: throughput, drops, queue high-water mark, per-stage latency
+// histograms and heap low-water mark. Each stage's task also reports its
+// stack headroom and the free heap it saw, since the heap is shared and
+// cannot be split by stage. Recording is a few adds under a spinlock,
+// cheap enough for the sensor and consumer tasks.
+// logSummary() prints the current window and starts a new one.
+class PipelineStats {
+public:
+  static constexpr LogTag logTag = LogTag::Core;
+
+  static void recordPublished();
+  static void recordDropped();
+  static void recordQueueDepth(uint32_t depth);
+  static void recordLatency(PipelineStage stage, uint32_t createdUs);
+  // Samples the calling task's stack high-water mark and the free heap;
+  // called by a stage's task once per batch of work
+  static void recordTaskResources(PipelineStage stage);
+
+  static void logSummary();
+
+private:
+  // Bucket i counts latencies in [2^i, 2^(i+1)) microseconds; the last
+  // bucket collects everything above ~1 minute.
+  static constexpr size_t BUCKETS = 26;
+
+  struct Histogram {
+    uint32_t buckets[BUCKETS];
+    uint32_t count;
+    uint32_t maxUs;
+  };
+
+  // Lowest values seen in the window; zero when the stage did not report
+  struct Resources {
+    uint32_t minStackFree;
+    uint32_t minHeapFree;
+  };
+
+  static uint32_t percentileUs(const Histogram& histogram, uint32_t permille);
+
+  static Histogram histograms[static_cast<size_t>(PipelineStage::Count)];
+  static Resources resources[static_cast<size_t>(PipelineStage::Count)];
+  static uint32_t published;
+  static uint32_t dropped;
+  static uint32_t queueHighWater;
+  static uint32_t windowStartMs;
+  static portMUX_TYPE lock;
+};
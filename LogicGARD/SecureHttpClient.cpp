@@ -2,26 +2,35 @@
 
 SecureHttpClient::SecureHttpClient(std::unique_ptr<AuthStrategy> authStrategy, const ApiConfig& cfg)
   : auth(std::move(authStrategy)), config(cfg) {
-  BaseComponent::debugLog("SecureHttpClient::constructor - Initialized with API: " + config.fullUrl());
+  LOG_DEBUG("SecureHttpClient::constructor - Initialized with API: %s", config.fullUrl().c_str());
 }
 
 int SecureHttpClient::post(String payload) {
-  BaseComponent::debugLog("SecureHttpClient::post - Sending payload (no response expected):");
-  BaseComponent::debugLog("  " + payload);
+  LOG_DEBUG("SecureHttpClient::post - Sending payload (no response expected):");
+  LOG_DEBUG("  %s", payload.c_str());
 
   int code = auth->post(payload, nullptr, config);
-  BaseComponent::debugLog("SecureHttpClient::post - HTTP result code: " + String(code));
+  LOG_DEBUG("SecureHttpClient::post - HTTP result code: %d", code);
 
   return code;
 }
 
 int SecureHttpClient::postWithResponse(String payload, String& response) {
-  BaseComponent::debugLog("SecureHttpClient::postWithResponse - Sending payload:");
-  BaseComponent::debugLog("  " + payload);
+  LOG_DEBUG("SecureHttpClient::postWithResponse - Sending payload:");
+  LOG_DEBUG("  %s", payload.c_str());
 
   int code = auth->post(payload, &response, config);
-  BaseComponent::debugLog("SecureHttpClient::postWithResponse - HTTP result code: " + String(code));
-  BaseComponent::debugLog("SecureHttpClient::postWithResponse - Response body: " + response);
+  LOG_DEBUG("SecureHttpClient::postWithResponse - HTTP result code: %d", code);
+  LOG_DEBUG("SecureHttpClient::postWithResponse - Response body: %s", response.c_str());
 
   return code;
+}
+
+size_t SecureHttpClient::postBatch(std::vector<HttpBatchItem>& items) {
+  LOG_DEBUG("SecureHttpClient::postBatch - Sending %u payloads on one connection", (unsigned)items.size());
+
+  size_t succeeded = auth->postAll(items, config);
+  LOG_DEBUG("SecureHttpClient::postBatch - %u/%u succeeded", (unsigned)succeeded, (unsigned)items.size());
+
+  return succeeded;
 }
\ No newline at end of file
@@ -5,10 +5,13 @@
 
 class SecureHttpClient : public BaseComponent {
 public:
+  static constexpr LogTag logTag = LogTag::Http;
+
   SecureHttpClient(std::unique_ptr<AuthStrategy> authStrategy, const ApiConfig& cfg);
 
   int post(String payload);
   int postWithResponse(String payload, String& response);
+  size_t postBatch(std::vector<HttpBatchItem>& items);
 
 private:
   std::unique_ptr<AuthStrategy> auth;
@@ -2,9 +2,16 @@
 #include <Arduino.h>
 #include "BaseComponent.h"
 
+// A sensor is a small state machine driven by SensorManager's scheduler
+// task. begin() probes the hardware; poll() does one non-blocking step
+// (start a conversion, or collect and publish a reading) and returns how
+// many milliseconds from this step's deadline the next one is due.
 class SensorBase :  public BaseComponent {
 public:
-  virtual void begin() = 0;
+  static constexpr LogTag logTag = LogTag::Sensor;
+
+  virtual bool begin() = 0;
+  virtual uint32_t poll() = 0;
   virtual String getName() const = 0;
   virtual ~SensorBase() {}
-};
\ No newline at end of file
+};
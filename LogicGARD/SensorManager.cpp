@@ -1,12 +1,17 @@
 #include "SensorManager.h"
 #include "Sensor_I2C.h"
 #include "Sensor_1Wire.h"
+#include <algorithm>
 
 SensorManager::SensorManager(MessageDispatcher& dispatcher, const std::vector<SensorConfig>& inputConfigs)
   : dispatcher(dispatcher) {
   sensorConfigList.reserve(inputConfigs.size());
   for (const auto& cfg : inputConfigs) {
     sensorConfigList.push_back(std::make_unique<SensorConfig>(cfg));  // deep copy into unique_ptr
+    SensorRegistry::intern(cfg.name);  // messages carry the handle, not the name
+    for (const auto& probe : cfg.probes) {
+      SensorRegistry::intern(probe.name);
+    }
   }
 }
 
@@ -20,26 +25,115 @@ void SensorManager::begin() {
     const SensorConfig& config = *configPtr;
 
     if (!config.enabled) {
-      BaseComponent::debugLog("Sensor " + config.name + " is disabled, skipping...");
+      LOG_DEBUG("Sensor %s is disabled, skipping...", config.name.c_str());
       continue;
     }
 
+    std::unique_ptr<SensorBase> sensor;
     if (config.interface == "i2c") {
-      auto sensor = std::make_unique<Sensor_I2C>(dispatcher, config);
-      sensor->begin();
-      sensors.push_back(std::move(sensor));
+      sensor = std::make_unique<Sensor_I2C>(dispatcher, config);
+      if (!sensor->begin()) {
+        Serial.printf("❌ Sensor '%s' not responding, skipping\r\n", config.name.c_str());
+        continue;
+      }
       Serial.printf("✅ Initialized I2C sensor '%s' (SDA=%d, SCL=%d, Interval=%ums)\r\n",
                     config.name.c_str(), config.sdaPin, config.sclPin, config.readIntervalMs);
     } else if (config.interface == "onewire") {
-      auto sensor = std::make_unique<Sensor_1Wire>(dispatcher, config);
-      sensor->begin();
-      sensors.push_back(std::move(sensor));
-      Serial.printf("✅ Initialized 1-Wire sensor '%s' (Pin=%d, Interval=%ums)\r\n",
-                    config.name.c_str(), config.onewirePin, config.readIntervalMs);
+      auto bus = std::make_unique<Sensor_1Wire>(dispatcher, config);
+      if (!bus->begin()) {
+        Serial.printf("❌ Sensor '%s' not responding, skipping\r\n", config.name.c_str());
+        continue;
+      }
+      Serial.printf("✅ Initialized 1-Wire bus '%s' (Pin=%d, Probes=%u, Interval=%ums)\r\n",
+                    config.name.c_str(), config.onewirePin, (unsigned)bus->probeCount(), config.readIntervalMs);
+      sensor = std::move(bus);
     } else {
       Serial.printf("❌ Unsupported interface '%s' for sensor '%s'\r\n",
                     config.interface.c_str(), config.name.c_str());
       continue;
     }
+
+    sensors.push_back(std::move(sensor));
+  }
+
+  if (sensors.empty()) return;
+
+  uint32_t start = millis() + STARTUP_DELAY_MS;
+  slots.reserve(sensors.size());
+  heap.reserve(sensors.size());
+  for (size_t i = 0; i < sensors.size(); ++i) {
+    slots.push_back(Slot{ sensors[i].get(), start + static_cast<uint32_t>(i) * STAGGER_MS, 0, 0, 0 });
+    heap.push_back(static_cast<uint8_t>(i));
+  }
+  auto later = [this](uint8_t a, uint8_t b) { return earlier(b, a); };
+  std::make_heap(heap.begin(), heap.end(), later);
+
+  xTaskCreatePinnedToCore(task, "SensorScheduler", TASK_STACK, this, 1, nullptr, 1);
+  LOG_DEBUG("[Sensor] Scheduler task started for %u sensors", (unsigned)sensors.size());
+}
+
+// Wrap-safe: millis() rolls over every ~49 days
+bool SensorManager::earlier(uint8_t a, uint8_t b) const {
+  return static_cast<int32_t>(slots[a].dueMs - slots[b].dueMs) < 0;
+}
+
+void SensorManager::task(void* param) {
+  static_cast<SensorManager*>(param)->run();
+}
+
+void SensorManager::run() {
+  auto later = [this](uint8_t a, uint8_t b) { return earlier(b, a); };
+
+  while (true) {
+    Slot& slot = slots[heap.front()];
+
+    int32_t waitMs = static_cast<int32_t>(slot.dueMs - millis());
+    if (waitMs > 0) {
+      vTaskDelay(pdMS_TO_TICKS(waitMs));
+    }
+
+    uint32_t startUs = micros();
+    uint32_t nextMs = slot.sensor->poll();
+    uint32_t costUs = micros() - startUs;
+
+    portENTER_CRITICAL(&statsLock);
+    slot.steps++;
+    slot.totalUs += costUs;
+    if (costUs > slot.maxUs) slot.maxUs = costUs;
+    portEXIT_CRITICAL(&statsLock);
+
+    // Re-key the slot only once it is out of the heap: pop_heap needs the
+    // root still in order.
+    std::pop_heap(heap.begin(), heap.end(), later);
+
+    // Next deadline counts from when this step was due, not when it ran.
+    // A sensor that fell more than a step behind restarts from now
+    // instead of firing back-to-back to catch up.
+    uint32_t now = millis();
+    slot.dueMs += nextMs;
+    if (static_cast<int32_t>(now - slot.dueMs) > static_cast<int32_t>(nextMs)) {
+      LOG_DEBUG("[Sensor] %s fell %ld ms behind, resyncing",
+                slot.sensor->getName().c_str(), (long)(now - slot.dueMs));
+      slot.dueMs = now;
+    }
+    std::push_heap(heap.begin(), heap.end(), later);
+  }
+}
+
+void SensorManager::logStats() {
+  for (Slot& slot : slots) {
+    portENTER_CRITICAL(&statsLock);
+    uint32_t steps = slot.steps;
+    uint32_t totalUs = slot.totalUs;
+    uint32_t maxUs = slot.maxUs;
+    slot.steps = 0;
+    slot.totalUs = 0;
+    slot.maxUs = 0;
+    portEXIT_CRITICAL(&statsLock);
+
+    if (steps == 0) continue;
+    LOG_INFO("[Sensor] %s: %lu steps, avg %lu us, max %lu us",
+             slot.sensor->getName().c_str(), (unsigned long)steps,
+             (unsigned long)(totalUs / steps), (unsigned long)maxUs);
   }
 }
\ No newline at end of file
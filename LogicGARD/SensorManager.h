@@ -5,15 +5,43 @@
 #include "SensorBase.h"
 #include "Types.h"
 #include "MessageDispatcher.h"
+#include "SensorRegistry.h"
 #include "BaseComponent.h"
 
+// Creates the configured sensors and drives all of them from one task.
+// Each sensor has an absolute next-due time in a min-heap; the task sleeps
+// until the earliest one, runs that sensor's poll() step and reschedules
+// it relative to the deadline it was due at, so read time never adds
+// drift. Per-sensor step cost is kept for logStats().
 class SensorManager : public BaseComponent {
 public:
+  static constexpr LogTag logTag = LogTag::Sensor;
+
   SensorManager(MessageDispatcher& dispatcher, const std::vector<SensorConfig>& inputConfigs);
   void begin();
+  void logStats();
 
 private:
+  static constexpr uint32_t STARTUP_DELAY_MS = 5000;  // Allow system stabilization
+  static constexpr uint32_t STAGGER_MS = 50;          // Spread first reads apart
+  static constexpr uint32_t TASK_STACK = 4096;
+
+  struct Slot {
+    SensorBase* sensor;
+    uint32_t dueMs;
+    uint32_t steps;
+    uint32_t totalUs;
+    uint32_t maxUs;
+  };
+
+  static void task(void* param);
+  void run();
+  bool earlier(uint8_t a, uint8_t b) const;
+
   MessageDispatcher& dispatcher;
   std::vector<std::unique_ptr<SensorConfig>> sensorConfigList;
   std::vector<std::unique_ptr<SensorBase>> sensors;
-};
\ No newline at end of file
+  std::vector<Slot> slots;
+  std::vector<uint8_t> heap;          // Slot indices, earliest dueMs on top
+  portMUX_TYPE statsLock = portMUX_INITIALIZER_UNLOCKED;
+};
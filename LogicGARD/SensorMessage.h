@@ -0,0 +1,114 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <type_traits>
+#include "SensorRegistry.h"
+
+// Measurement channels a reading can carry. Every value is fixed-point
+// with two decimals (SensorMessage::SCALE): hundredths of °F, of %RH and
+// of hPa (i.e. Pa).
+enum class Channel : uint8_t {
+  Temperature,
+  Humidity,
+  Pressure,
+  Count
+};
+
+inline const char* channelName(Channel channel) {
+  static const char* const names[] = { "temperature", "humidity", "pressure" };
+  return names[static_cast<size_t>(channel)];
+}
+
+// Unit an overlay shows temperatures in. Readings are always carried in
+// °F; conversion happens at display time.
+enum class TemperatureUnit : uint8_t {
+  Fahrenheit,
+  Celsius
+};
+
+inline const char* unitSymbol(TemperatureUnit unit) {
+  return unit == TemperatureUnit::Celsius ? "°C" : "°F";
+}
+
+// Formats a fixed-point value as "-12.05"; returns the snprintf length.
+inline int formatFixed(char* out, size_t cap, int32_t value) {
+  uint32_t magnitude = value < 0 ? 0u - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+  return snprintf(out, cap, "%s%lu.%02lu", value < 0 ? "-" : "",
+                  static_cast<unsigned long>(magnitude / 100), static_cast<unsigned long>(magnitude % 100));
+}
+
+// One reading from one sensor: any subset of the channels, flagged in
+// `channels`. Copied byte-wise through FreeRTOS queues, so it must stay
+// trivially copyable: no String or other heap-owning members.
+struct SensorMessage {
+  static constexpr int32_t SCALE = 100;
+  static constexpr size_t CHANNELS = static_cast<size_t>(Channel::Count);
+
+  int32_t values[CHANNELS];
+  uint32_t timestamp;
+  uint32_t createdUs;    // micros() at read time, for PipelineStats latency
+  SensorHandle sensor;
+  uint8_t channels;      // Bit per Channel present in values
+
+  static SensorMessage make(SensorHandle sensor, uint32_t timestamp) {
+    SensorMessage msg{};
+    msg.sensor = sensor;
+    msg.timestamp = timestamp;
+    msg.createdUs = micros();
+    return msg;
+  }
+
+  void set(Channel channel, int32_t value) {
+    values[static_cast<size_t>(channel)] = value;
+    channels |= 1u << static_cast<uint8_t>(channel);
+  }
+
+  bool has(Channel channel) const {
+    return channels & (1u << static_cast<uint8_t>(channel));
+  }
+
+  int32_t get(Channel channel) const {
+    return values[static_cast<size_t>(channel)];
+  }
+
+  // Value rounded half away from zero to whole units (°F, %RH, hPa)
+  int32_t whole(Channel channel) const {
+    return roundedDiv(get(channel), SCALE);
+  }
+
+  // Temperature rounded the same way to whole degrees of unit
+  int32_t wholeTemperature(TemperatureUnit unit) const {
+    if (unit == TemperatureUnit::Fahrenheit) return whole(Channel::Temperature);
+    // °C = (°F - 32) * 5/9, kept in hundredths until the single rounding
+    return roundedDiv((get(Channel::Temperature) - 32 * SCALE) * 5, 9 * SCALE);
+  }
+
+  const char* sensorId() const {
+    return SensorRegistry::name(sensor);
+  }
+
+  String toJson() const {
+    char buffer[160];
+    size_t pos = 0;
+    pos += snprintf(buffer, sizeof(buffer), "{");
+    for (size_t i = 0; i < CHANNELS; ++i) {
+      Channel channel = static_cast<Channel>(i);
+      if (!has(channel)) continue;
+      pos += snprintf(buffer + pos, sizeof(buffer) - pos, "\"%s\":", channelName(channel));
+      pos += formatFixed(buffer + pos, sizeof(buffer) - pos, get(channel));
+      pos += snprintf(buffer + pos, sizeof(buffer) - pos, ",");
+    }
+    snprintf(buffer + pos, sizeof(buffer) - pos, "\"timestamp\":%lu,\"sensorId\":\"%s\"}",
+             static_cast<unsigned long>(timestamp), sensorId());
+    return String(buffer);
+  }
+
+private:
+  static int32_t roundedDiv(int32_t value, int32_t divisor) {
+    return value >= 0 ? (value + divisor / 2) / divisor : -((-value + divisor / 2) / divisor);
+  }
+};
+
+static_assert(std::is_trivially_copyable<SensorMessage>::value,
+              "SensorMessage must be trivially copyable for xQueueSend");
@@ -0,0 +1,55 @@
+#include "SensorRegistry.h"
+#include <cstring>
+
+char SensorRegistry::names[SensorRegistry::MAX_SENSORS][SensorRegistry::MAX_NAME_LEN] = {};
+std::atomic<size_t> SensorRegistry::used{0};
+portMUX_TYPE SensorRegistry::lock = portMUX_INITIALIZER_UNLOCKED;
+
+SensorHandle SensorRegistry::intern(const String& name) {
+  if (name.isEmpty()) return INVALID;
+
+  if (name.length() >= MAX_NAME_LEN) {
+    Serial.printf("[SensorRegistry] ❌ Name '%s' is longer than %u characters\n",
+                  name.c_str(), (unsigned)(MAX_NAME_LEN - 1));
+    return INVALID;
+  }
+
+  SensorHandle handle = INVALID;
+
+  portENTER_CRITICAL(&lock);
+  size_t count = used.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < count; ++i) {
+    if (strcmp(names[i], name.c_str()) == 0) {
+      handle = static_cast<SensorHandle>(i);
+      break;
+    }
+  }
+
+  if (handle == INVALID && count < MAX_SENSORS) {
+    strcpy(names[count], name.c_str());
+    handle = static_cast<SensorHandle>(count);
+    used.store(count + 1, std::memory_order_release);
+  }
+  portEXIT_CRITICAL(&lock);
+
+  if (handle == INVALID) {
+    Serial.printf("[SensorRegistry] ❌ Table full, cannot intern '%s'\n", name.c_str());
+  }
+  return handle;
+}
+
+SensorHandle SensorRegistry::find(const String& name) {
+  if (name.length() >= MAX_NAME_LEN) return INVALID;
+
+  size_t count = used.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; ++i) {
+    if (strcmp(names[i], name.c_str()) == 0) {
+      return static_cast<SensorHandle>(i);
+    }
+  }
+  return INVALID;
+}
+
+const char* SensorRegistry::name(SensorHandle handle) {
+  return handle < used.load(std::memory_order_acquire) ? names[handle] : "";
+}
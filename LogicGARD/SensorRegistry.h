@@ -0,0 +1,38 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+// Numeric handle for a sensor name, carried in messages instead of a String.
+using SensorHandle = uint8_t;
+
+// Fixed-size intern table mapping sensor names to handles. Names are
+// interned during setup (SensorManager, consumer construction) under a
+// lock. A slot is written before `used` is advanced past it with release
+// ordering, and readers load `used` with acquire, so find() and name()
+// from sensor and consumer tasks need no lock.
+class SensorRegistry {
+public:
+  static constexpr SensorHandle INVALID = 0xFF;
+  static constexpr size_t MAX_SENSORS = 32;
+  static constexpr size_t MAX_NAME_LEN = 32;
+
+  // Returns the handle for name, adding it to the table if not yet known.
+  // Names longer than MAX_NAME_LEN - 1 are rejected with INVALID rather
+  // than truncated, so two long names never share a handle.
+  static SensorHandle intern(const String& name);
+
+  // Returns the handle for name, or INVALID if it was never interned.
+  static SensorHandle find(const String& name);
+
+  // Returns the interned name, or "" for an unknown handle.
+  static const char* name(SensorHandle handle);
+
+  static size_t count() { return used.load(std::memory_order_acquire); }
+
+private:
+  static char names[MAX_SENSORS][MAX_NAME_LEN];
+  static std::atomic<size_t> used;
+  static portMUX_TYPE lock;
+};
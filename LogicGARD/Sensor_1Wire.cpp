@@ -1,87 +1,106 @@
 #include "Sensor_1Wire.h"
 #include "TimeUtils.h"
+#include <cstring>
 
 Sensor_1Wire::Sensor_1Wire(MessageDispatcher& dispatcher, const SensorConfig& config)
   : dispatcher(dispatcher),
     config(config),
     oneWire(config.onewirePin),
     sensors(&oneWire) {
-  BaseComponent::debugLog("[1Wire] initializing sensor name " + config.name);
+  LOG_DEBUG("[1Wire] initializing bus name %s", config.name.c_str());
 }
 
-void Sensor_1Wire::begin() {
-  BaseComponent::debugLog("[1Wire] Sensor_1Wire::begin - Initializing sensor on GPIO " + String(config.onewirePin));
+bool Sensor_1Wire::begin() {
+  LOG_DEBUG("[1Wire] Sensor_1Wire::begin - Initializing bus on GPIO %d", config.onewirePin);
 
   sensors.begin();
-  sensors.setResolution(12);
+  size_t deviceCount = sensors.getDeviceCount();
 
-  DeviceAddress addr;
-  if (!sensors.getAddress(addr, 0)) {
-    BaseComponent::debugLog("[1Wire] Sensor_1Wire::begin - ❌ No DS18B20 sensor found.");
-    return;
+  for (size_t i = 0; i < deviceCount; ++i) {
+    Probe probe;
+    if (!sensors.getAddress(probe.address, i)) continue;
+
+    String name = probeName(probe.address, deviceCount);
+    probe.handle = SensorRegistry::intern(name);
+    if (probe.handle == SensorRegistry::INVALID) continue;
+
+    sensors.setResolution(probe.address, config.resolution);
+    probes.push_back(probe);
+
+    LOG_DEBUG("[1Wire] Sensor_1Wire::begin - ✅ Found DS18B20 '%s' at address: %x %x %x %x %x %x %x %x",
+              name.c_str(),
+              probe.address[0], probe.address[1], probe.address[2], probe.address[3],
+              probe.address[4], probe.address[5], probe.address[6], probe.address[7]);
   }
 
-  String addrStr;
-  for (uint8_t i = 0; i < 8; i++) {
-    addrStr += String(addr[i], HEX) + " ";
+  if (probes.empty()) {
+    LOG_DEBUG("[1Wire] Sensor_1Wire::begin - ❌ No DS18B20 sensor found.");
+    return false;
   }
-  BaseComponent::debugLog("[1Wire] Sensor_1Wire::begin - ✅ Found DS18B20 at address: " + addrStr);
-
-  xTaskCreatePinnedToCore(
-    task,
-    "Sensor_1Wire_Task",
-    2048,
-    this,
-    1,
-    nullptr,
-    1
-  );
-
-  BaseComponent::debugLog("[1Wire] Sensor_1Wire::begin - Task created and pinned to core 1.");
+
+  // requestTemperatures() only starts the conversion; poll() comes back later
+  sensors.setWaitForConversion(false);
+  return true;
 }
 
-void Sensor_1Wire::task(void* param) {
-  Sensor_1Wire* self = static_cast<Sensor_1Wire*>(param);
-  self->BaseComponent::debugLog("[1Wire] Sensor_1Wire::task - Task started.");
+// Configured name for this ROM, else the bus name (single probe) or the
+// bus name plus the ROM ID.
+String Sensor_1Wire::probeName(const DeviceAddress& address, size_t deviceCount) const {
+  char rom[17];
+  for (size_t i = 0; i < 8; ++i) {
+    snprintf(rom + i * 2, 3, "%02X", address[i]);
+  }
 
-  vTaskDelay(pdMS_TO_TICKS(5000)); // Initial delay to allow system stabilization
+  for (const auto& probe : config.probes) {
+    if (probe.rom == rom) return probe.name;
+  }
 
-  while (true) {
-    int tempF;
-    if (self->read(&tempF)) {
-      uint32_t timestamp = TimeUtils::getEpochSeconds();
-      TemperatureMessage msg{ tempF, timestamp, self->config.name };
+  if (deviceCount == 1) return config.name;
 
-      String formattedTime = TimeUtils::formatIsoTimestamp(timestamp);
-      self->BaseComponent::debugLog("[1Wire] Sensor_1Wire::task - 📤 Publishing temperature: " + String(tempF) +
-                     "°F at " + formattedTime + " from sensor: " + self->config.name);
-      self->dispatcher.publish(msg);
-    } else {
-      self->BaseComponent::debugLog("[1Wire] Sensor_1Wire::task - ❌ Failed to read temperature from sensor.");
-    }
+  char name[SensorRegistry::MAX_NAME_LEN];
+  snprintf(name, sizeof(name), "%.*s %s",
+           static_cast<int>(SensorRegistry::MAX_NAME_LEN - sizeof(rom) - 1), config.name.c_str(), rom);
+  return String(name);
+}
 
-    self->BaseComponent::debugLog("[1Wire] Sensor " + self->config.name + " will sleep for " + String(self->config.readIntervalMs));
-    vTaskDelay(pdMS_TO_TICKS(self->config.readIntervalMs));
+// Both steps together take readIntervalMs, so the convert starts stay on a
+// fixed period whatever the resolution.
+uint32_t Sensor_1Wire::poll() {
+  uint32_t conversionMs = sensors.millisToWaitForConversion(config.resolution);
+
+  if (!converting) {
+    // One Skip ROM convert starts every probe at once; the wait is paid once
+    sensors.requestTemperatures();
+    converting = true;
+    return conversionMs;
   }
+
+  converting = false;
+  readAll();
+  return config.readIntervalMs > conversionMs ? config.readIntervalMs - conversionMs : 0;
 }
 
-bool Sensor_1Wire::read(int* tempF) {
-  sensors.requestTemperatures();
-  float tempC = sensors.getTempCByIndex(0);
+void Sensor_1Wire::readAll() {
+  uint32_t timestamp = TimeUtils::getEpochSeconds();
 
-  if (tempC == DEVICE_DISCONNECTED_C) {
-    BaseComponent::debugLog("[1Wire] Sensor_1Wire::read - Sensor disconnected.");
-    return false;
-  }
+  for (const Probe& probe : probes) {
+    float tempC = sensors.getTempC(probe.address);
 
-  float tempF_val = (tempC * 9.0 / 5.0) + 32.0;
-  *tempF = static_cast<int>(round(tempF_val));
+    if (tempC == DEVICE_DISCONNECTED_C) {
+      LOG_DEBUG("[1Wire] Sensor_1Wire::readAll - ❌ Probe %s disconnected.", SensorRegistry::name(probe.handle));
+      continue;
+    }
 
-  BaseComponent::debugLog("[1Wire] Sensor_1Wire::read - Converted temperature: " + String(tempC) +
-           "°C → " + String(*tempF) + "°F");
-  return true;
+    SensorMessage msg = SensorMessage::make(probe.handle, timestamp);
+    msg.set(Channel::Temperature, static_cast<int32_t>(lroundf(tempC * 180.0f + 3200.0f)));
+    int tempF = msg.whole(Channel::Temperature);
+
+    LOG_DEBUG("[1Wire] Sensor_1Wire::readAll - 📤 Publishing temperature: %.2f°C → %d°F at %s from sensor: %s",
+              tempC, tempF, TimeUtils::formatIsoTimestamp(timestamp).c_str(), SensorRegistry::name(probe.handle));
+    dispatcher.publish(msg);
+  }
 }
 
 String Sensor_1Wire::getName() const {
   return config.name;
-}
\ No newline at end of file
+}
@@ -2,24 +2,38 @@
 #include <Arduino.h>
 #include <OneWire.h>
 #include <DallasTemperature.h>
+#include <vector>
 
 #include "SensorBase.h"
 #include "MessageDispatcher.h"
 #include "Types.h"
 
+// All DS18B20 probes on one 1-Wire pin. begin() enumerates the bus and
+// gives each ROM ID its own sensor handle. Each cycle is two poll() steps:
+// a single broadcast convert, then — once the resolution's conversion time
+// has passed — a read of each probe by address.
 class Sensor_1Wire : public SensorBase {
 public:
   Sensor_1Wire(MessageDispatcher& dispatcher, const SensorConfig& config);
 
-  void begin() override;
+  bool begin() override;
+  uint32_t poll() override;
   String getName() const override;
+  size_t probeCount() const { return probes.size(); }
 
 private:
-  static void task(void* param);       // 👈 Added for FreeRTOS task loop
-  bool read(int* temperature);
+  struct Probe {
+    DeviceAddress address;
+    SensorHandle handle;
+  };
+
+  void readAll();
+  String probeName(const DeviceAddress& address, size_t deviceCount) const;
 
   MessageDispatcher& dispatcher;
   const SensorConfig& config;
   OneWire oneWire;
   DallasTemperature sensors;
-};
\ No newline at end of file
+  std::vector<Probe> probes;
+  bool converting = false;
+};
@@ -2,72 +2,70 @@
 #include "TimeUtils.h"
 
 Sensor_I2C::Sensor_I2C(MessageDispatcher& dispatcher, const SensorConfig& config)
-  : dispatcher(dispatcher), config(config) {}
+  : dispatcher(dispatcher), config(config), handle(SensorRegistry::intern(config.name)) {}
 
-void Sensor_I2C::begin() {
-  BaseComponent::debugLog("[I2C] Sensor_I2C::begin - 📟 SensorConfig:");
-  BaseComponent::debugLog("[I2C]   SDA Pin: " + String(config.sdaPin));
-  BaseComponent::debugLog("[I2C]   SCL Pin: " + String(config.sclPin));
-  BaseComponent::debugLog("[I2C]   Sensor ID: " + config.name);
+bool Sensor_I2C::begin() {
+  LOG_DEBUG("[I2C] Sensor_I2C::begin - 📟 SensorConfig:");
+  LOG_DEBUG("[I2C]   SDA Pin: %d", config.sdaPin);
+  LOG_DEBUG("[I2C]   SCL Pin: %d", config.sclPin);
+  LOG_DEBUG("[I2C]   Address: 0x%02X", config.i2cAddress);
+  LOG_DEBUG("[I2C]   Sensor ID: %s", config.name.c_str());
 
-  Wire.begin(config.sdaPin, config.sclPin);
+  I2cBus* bus = I2cBus::forPins(config.sdaPin, config.sclPin);
+  if (!bus) return false;
 
-  if (!bme.begin(0x76, &Wire)) {
-    BaseComponent::debugLog("[I2C] Sensor_I2C::begin - ❌ Could not find a valid BME280 sensor, check wiring!");
-    return;
+  if (!bus->claim(config.i2cAddress)) {
+    Serial.printf("[I2C] ❌ Address 0x%02X on SDA=%d SCL=%d is already used by another device\r\n",
+                  config.i2cAddress, config.sdaPin, config.sclPin);
+    return false;
   }
 
-  BaseComponent::debugLog("[I2C] Sensor_I2C::begin - ✅ BME280 initialized on sensor " + config.name);
-
-  xTaskCreatePinnedToCore(
-    task,
-    "Sensor_I2C_Task",
-    4096,
-    this,
-    1,
-    nullptr,
-    1
-  );
+  if (!bme.begin(*bus, config.i2cAddress)) {
+    LOG_DEBUG("[I2C] Sensor_I2C::begin - ❌ Could not find a valid BME280 sensor, check wiring!");
+    return false;
+  }
 
-  BaseComponent::debugLog("[I2C] Sensor_I2C::begin - Task created and pinned to core 1.");
+  LOG_DEBUG("[I2C] Sensor_I2C::begin - ✅ BME280 initialized on sensor %s", config.name.c_str());
+  return true;
 }
 
-void Sensor_I2C::task(void* param) {
-  auto* self = static_cast<Sensor_I2C*>(param);
-  self->BaseComponent::debugLog("[I2C] Sensor_I2C::task - Task started.");
-
-  vTaskDelay(pdMS_TO_TICKS(5000)); // Initial delay to allow system stabilization
-
-  while (true) {
-    int tempF;
-    if (self->read(&tempF)) {
-      uint32_t timestamp = TimeUtils::getEpochSeconds();
-      TemperatureMessage msg{ tempF, timestamp, self->config.name };
-
-      self->BaseComponent::debugLog("[I2C] Sensor_I2C::task - Read temperature: " + String(tempF) +
-                     "°F at timestamp: " + String(timestamp));
-      self->dispatcher.publish(msg);
-    } else {
-      self->BaseComponent::debugLog("[I2C] Sensor_I2C::task - ❌ Failed to read temperature.");
+// Both steps together take readIntervalMs, so triggers stay on a fixed period.
+uint32_t Sensor_I2C::poll() {
+  if (!measuring) {
+    if (!bme.trigger()) {
+      LOG_DEBUG("[I2C] Sensor_I2C::poll - ❌ Failed to start a measurement.");
+      return config.readIntervalMs;
     }
-
-    vTaskDelay(pdMS_TO_TICKS(self->config.readIntervalMs));
+    measuring = true;
+    return Bme280::MEASURE_MS;
   }
+
+  measuring = false;
+  publish();
+  return config.readIntervalMs > Bme280::MEASURE_MS ? config.readIntervalMs - Bme280::MEASURE_MS : 0;
 }
 
-bool Sensor_I2C::read(int* temperature) {
-  float tempC = bme.readTemperature();
-  if (isnan(tempC)) {
-    BaseComponent::debugLog("[I2C] Sensor_I2C::read - Sensor returned NaN.");
-    return false;
+void Sensor_I2C::publish() {
+  Bme280::Reading reading;
+  if (!bme.read(reading)) {
+    LOG_DEBUG("[I2C] Sensor_I2C::publish - ❌ Failed to read measurement.");
+    return;
   }
 
-  float tempF = tempC * 1.8f + 32.0f;
-  *temperature = static_cast<int>(roundf(tempF));
+  // °C × 1.8 + 32, kept in hundredths and rounded half away from zero
+  int32_t scaled = reading.centiCelsius * 9;
+  int32_t centiF = (scaled >= 0 ? scaled + 2 : scaled - 2) / 5 + 3200;
 
-  BaseComponent::debugLog("[I2C] Sensor_I2C::read - Converted temperature: " + String(tempC) +
-           "°C → " + String(*temperature) + "°F");
-  return true;
+  SensorMessage msg = SensorMessage::make(handle, TimeUtils::getEpochSeconds());
+  msg.set(Channel::Temperature, centiF);
+  msg.set(Channel::Humidity, static_cast<int32_t>(reading.centiHumidity));
+  msg.set(Channel::Pressure, static_cast<int32_t>(reading.pressurePa));
+
+  LOG_DEBUG("[I2C] Sensor_I2C::publish - Read %ld.%02ld°C, %lu.%02lu%%RH, %lu Pa",
+            (long)(reading.centiCelsius / 100), (long)abs(reading.centiCelsius % 100),
+            (unsigned long)(reading.centiHumidity / 100), (unsigned long)(reading.centiHumidity % 100),
+            (unsigned long)reading.pressurePa);
+  dispatcher.publish(msg);
 }
 
 String Sensor_I2C::getName() const {
@@ -1,25 +1,28 @@
 #pragma once
 #include <Arduino.h>
-#include <Wire.h>
-#include <Adafruit_Sensor.h>
-#include <Adafruit_BME280.h>
-
+#include "Bme280.h"
 #include "SensorBase.h"
 #include "MessageDispatcher.h"
 #include "TimeUtils.h"
 #include "Types.h"
 
+// A BME280 in forced mode at config.i2cAddress on the bus shared by every
+// device on the same SDA/SCL pins. Each cycle is two poll() steps: trigger one
+// conversion of all channels, then burst-read and publish temperature,
+// humidity and pressure as a single message.
 class Sensor_I2C : public SensorBase {
 public:
   Sensor_I2C(MessageDispatcher& dispatcher, const SensorConfig& config);
-  void begin() override;
+  bool begin() override;
+  uint32_t poll() override;
   String getName() const override;
 
 private:
-  static void task(void* param);       // 👈 Added for FreeRTOS task loop
-  bool read(int* temperature);
+  void publish();
 
   MessageDispatcher& dispatcher;
   const SensorConfig& config;
-  Adafruit_BME280 bme;
-};
\ No newline at end of file
+  const SensorHandle handle;
+  Bme280 bme;
+  bool measuring = false;
+};
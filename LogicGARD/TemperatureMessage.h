@@ -1,15 +0,0 @@
-#pragma once
-#include <Arduino.h>
-#include <stdint.h>
-
-struct TemperatureMessage {
-  int temperature;       // Stored as Fahrenheit
-  uint32_t timestamp;
-  String sensorId;
-
-  String toJson() const {
-    return "{\"temperature\":" + String(temperature) +
-           ",\"timestamp\":" + String(timestamp) +
-           ",\"sensorId\":\"" + sensorId + "\"}";
-  }
-};
\ No newline at end of file
@@ -1,68 +1,82 @@
 #include "TimeProvider.h"
-#include <Wire.h>
 #include <time.h>
 #include "TimeUtils.h"
 
 TimeProvider::TimeProvider(TimeProviderType providerType, const NtpConfig& ntpConfig, const RtcConfig& rtcConfig)
   : providerType(providerType), ntpConfig(ntpConfig), rtcConfig(rtcConfig), rtcInitialized(false) {
-  BaseComponent::debugLog("[TimeProvider] Constructor called");
-  BaseComponent::debugLog("[TimeProvider] Provider type: " + String(providerType == TimeProviderType::RTC ? "RTC" : "NTP"));
+  LOG_DEBUG("[TimeProvider] Constructor called");
+  LOG_DEBUG("[TimeProvider] Provider type: %s", providerType == TimeProviderType::RTC ? "RTC" : "NTP");
 
   // Debug NTP config
-  BaseComponent::debugLog("[TimeProvider] NtpConfig:");
-  BaseComponent::debugLog("  enabled: " + String(ntpConfig.enabled));
-  BaseComponent::debugLog("  url: " + ntpConfig.url);
-  BaseComponent::debugLog("  gmtOffset: " + String(ntpConfig.gmtOffset));
-  BaseComponent::debugLog("  dstOffset: " + String(ntpConfig.dstOffset));
+  LOG_DEBUG("[TimeProvider] NtpConfig:");
+  LOG_DEBUG("  enabled: %d", ntpConfig.enabled);
+  LOG_DEBUG("  url: %s", ntpConfig.url.c_str());
+  LOG_DEBUG("  gmtOffset: %d", ntpConfig.gmtOffset);
+  LOG_DEBUG("  dstOffset: %d", ntpConfig.dstOffset);
 
   // Debug RTC config
-  BaseComponent::debugLog("[TimeProvider] RtcConfig:");
-  BaseComponent::debugLog("  sdaPin: " + String(rtcConfig.sdaPin));
-  BaseComponent::debugLog("  sclPin: " + String(rtcConfig.sclPin));
-  BaseComponent::debugLog("  timeAdjust.enabled: " + String(rtcConfig.timeAdjust.enabled));
+  LOG_DEBUG("[TimeProvider] RtcConfig:");
+  LOG_DEBUG("  sdaPin: %d", rtcConfig.sdaPin);
+  LOG_DEBUG("  sclPin: %d", rtcConfig.sclPin);
+  LOG_DEBUG("  timeAdjust.enabled: %d", rtcConfig.timeAdjust.enabled);
   if (rtcConfig.timeAdjust.enabled) {
-    BaseComponent::debugLog("  timeAdjust.year: " + String(rtcConfig.timeAdjust.year));
-    BaseComponent::debugLog("  timeAdjust.month: " + String(rtcConfig.timeAdjust.month));
-    BaseComponent::debugLog("  timeAdjust.day: " + String(rtcConfig.timeAdjust.day));
-    BaseComponent::debugLog("  timeAdjust.hour: " + String(rtcConfig.timeAdjust.hour));
-    BaseComponent::debugLog("  timeAdjust.minute: " + String(rtcConfig.timeAdjust.minute));
-    BaseComponent::debugLog("  timeAdjust.second: " + String(rtcConfig.timeAdjust.second));
+    LOG_DEBUG("  timeAdjust.year: %d", rtcConfig.timeAdjust.year);
+    LOG_DEBUG("  timeAdjust.month: %d", rtcConfig.timeAdjust.month);
+    LOG_DEBUG("  timeAdjust.day: %d", rtcConfig.timeAdjust.day);
+    LOG_DEBUG("  timeAdjust.hour: %d", rtcConfig.timeAdjust.hour);
+    LOG_DEBUG("  timeAdjust.minute: %d", rtcConfig.timeAdjust.minute);
+    LOG_DEBUG("  timeAdjust.second: %d", rtcConfig.timeAdjust.second);
   }
 }
 
 void TimeProvider::begin() {
-  BaseComponent::debugLog("[TimeProvider] begin() called");
+  LOG_DEBUG("[TimeProvider] begin() called");
 
   if (providerType == TimeProviderType::RTC) {
-    BaseComponent::debugLog("[TimeProvider] Initializing RTC...");
+    LOG_DEBUG("[TimeProvider] Initializing RTC...");
     setupRtc();
   } else if (providerType == TimeProviderType::NTP) {
-    BaseComponent::debugLog("[TimeProvider] Initializing NTP...");
+    LOG_DEBUG("[TimeProvider] Initializing NTP...");
     setupNtp();
   } else {
-    BaseComponent::debugLog("[TimeProvider] ❌ Unknown provider type");
+    LOG_DEBUG("[TimeProvider] ❌ Unknown provider type");
   }
 
   time_t currentTime = getCurrentTime();
   String formattedTime = TimeUtils::formatIsoTimestamp(currentTime);
-  BaseComponent::debugLog("[TimeProvider] Current time: " + formattedTime);
+  LOG_DEBUG("[TimeProvider] Current time: %s", formattedTime.c_str());
 }
 
 void TimeProvider::setupRtc() {
-  BaseComponent::debugLog("[RTC] setupRtc() called");
+  LOG_DEBUG("[RTC] setupRtc() called");
 
-  Wire.begin(rtcConfig.sdaPin, rtcConfig.sclPin);
+  rtcBus = I2cBus::forPins(rtcConfig.sdaPin, rtcConfig.sclPin);
+  if (!rtcBus) return;
 
-  if (!rtc.begin()) {
-    BaseComponent::debugLog("[RTC] ❌ RTC not found");
+  if (!rtcBus->claim(RTC_ADDRESS)) {
+    LOG_DEBUG("[RTC] ❌ Address 0x%02X already used by another device", RTC_ADDRESS);
+    return;
+  }
+
+  // RTClib drives Wire itself, so hold the bus for the whole setup
+  I2cBus::Lock lock(*rtcBus);
+  if (!lock) {
+    LOG_DEBUG("[RTC] ❌ I2C bus busy");
+    return;
+  }
+
+  bool found = rtc.begin(&lock.wire());
+  rtcBus->recordResult(found);
+  if (!found) {
+    LOG_DEBUG("[RTC] ❌ RTC not found");
     return;
   }
 
   if (rtc.lostPower()) {
-    BaseComponent::debugLog("[RTC] ⚠️ RTC lost power");
+    LOG_DEBUG("[RTC] ⚠️ RTC lost power");
 
     if (rtcConfig.timeAdjust.enabled) {
-      BaseComponent::debugLog("[RTC] ⏱️ Setting RTC time from config");
+      LOG_DEBUG("[RTC] ⏱️ Setting RTC time from config");
       rtc.adjust(DateTime(
         rtcConfig.timeAdjust.year,
         rtcConfig.timeAdjust.month,
@@ -72,27 +86,27 @@ void TimeProvider::setupRtc() {
         rtcConfig.timeAdjust.second
       ));
     } else {
-      BaseComponent::debugLog("[RTC] ⏱️ Setting RTC time from compile time");
+      LOG_DEBUG("[RTC] ⏱️ Setting RTC time from compile time");
       rtc.adjust(DateTime(F(__DATE__), F(__TIME__)));
     }
 
     DateTime now = rtc.now();
-    BaseComponent::debugLog("[RTC] ✅ Time set to: " + String(now.timestamp(DateTime::TIMESTAMP_FULL)));
+    LOG_DEBUG("[RTC] ✅ Time set to: %s", now.timestamp(DateTime::TIMESTAMP_FULL).c_str());
   } else {
-    BaseComponent::debugLog("[RTC] Power status OK");
+    LOG_DEBUG("[RTC] Power status OK");
     DateTime now = rtc.now();
-    BaseComponent::debugLog("[RTC] Current RTC time: " + String(now.timestamp(DateTime::TIMESTAMP_FULL)));
+    LOG_DEBUG("[RTC] Current RTC time: %s", now.timestamp(DateTime::TIMESTAMP_FULL).c_str());
   }
 
   rtcInitialized = true;
-  BaseComponent::debugLog("[RTC] ✅ RTC initialized");
+  LOG_DEBUG("[RTC] ✅ RTC initialized");
 }
 
 void TimeProvider::setupNtp() {
-  BaseComponent::debugLog("[NTP] setupNtp() called");
+  LOG_DEBUG("[NTP] setupNtp() called");
 
   if (!ntpConfig.enabled) {
-    BaseComponent::debugLog("[NTP] ❌ NTP is disabled in config");
+    LOG_DEBUG("[NTP] ❌ NTP is disabled in config");
     return;
   }
 
@@ -100,9 +114,9 @@ void TimeProvider::setupNtp() {
   tzset();
 
   configTime(ntpConfig.gmtOffset, ntpConfig.dstOffset, ntpConfig.url.c_str());
-  BaseComponent::debugLog("[NTP] ✅ NTP initialized");
+  LOG_DEBUG("[NTP] ✅ NTP initialized");
 
-  BaseComponent::debugLog("[NTP] Waiting for time sync");
+  LOG_DEBUG("[NTP] Waiting for time sync");
   int attempts = 0;
   time_t now;
   String dots = "";
@@ -113,36 +127,46 @@ void TimeProvider::setupNtp() {
     attempts++;
   } while (now < 1000000000 && attempts < 40);
 
-  BaseComponent::debugLog("[NTP] Sync attempt result: " + dots);
+  LOG_DEBUG("[NTP] Sync attempt result: %s", dots.c_str());
 
   if (now >= 1000000000) {
-    BaseComponent::debugLog("[NTP] ✅ Time synced: " + String(now));
+    LOG_DEBUG("[NTP] ✅ Time synced: %ld", (long)now);
   } else {
-    BaseComponent::debugLog("[NTP] ❌ Time sync failed after timeout");
+    LOG_DEBUG("[NTP] ❌ Time sync failed after timeout");
   }
 }
 
 time_t TimeProvider::getCurrentTime() {
-  BaseComponent::debugLog("[TimeProvider] getCurrentTime() called");
+  LOG_DEBUG("[TimeProvider] getCurrentTime() called");
 
-  if (providerType == TimeProviderType::RTC && rtcInitialized) {
-    time_t rtcTime = rtc.now().unixtime();
-    BaseComponent::debugLog("[TimeProvider] RTC time: " + String(rtcTime));
+  time_t rtcTime;
+  if (providerType == TimeProviderType::RTC && readRtc(rtcTime)) {
+    LOG_DEBUG("[TimeProvider] RTC time: %ld", (long)rtcTime);
     return rtcTime;
   }
 
   time_t now = time(nullptr);
-  BaseComponent::debugLog("[TimeProvider] NTP time: " + String(now));
+  LOG_DEBUG("[TimeProvider] NTP time: %ld", (long)now);
 
   if (providerType == TimeProviderType::NTP && now < 1000000000) {
-    BaseComponent::debugLog("[TimeProvider] ⚠️ NTP time not yet synced");
+    LOG_DEBUG("[TimeProvider] ⚠️ NTP time not yet synced");
 
-    if (rtcInitialized) {
-      time_t rtcTime = rtc.now().unixtime();
-      BaseComponent::debugLog("[TimeProvider] ⚠️ Falling back to RTC time: " + String(rtcTime));
+    if (readRtc(rtcTime)) {
+      LOG_DEBUG("[TimeProvider] ⚠️ Falling back to RTC time: %ld", (long)rtcTime);
       return rtcTime;
     }
   }
 
   return now;
-}
\ No newline at end of file
+}
+
+bool TimeProvider::readRtc(time_t& out) {
+  if (!rtcInitialized) return false;
+
+  I2cBus::Lock lock(*rtcBus);
+  if (!lock) return false;
+
+  out = rtc.now().unixtime();
+  rtcBus->recordResult(true);   // RTClib does not report read failures
+  return true;
+}
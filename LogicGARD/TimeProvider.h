@@ -2,10 +2,13 @@
 #include <Arduino.h>
 #include <RTClib.h>
 #include "Types.h"
+#include "I2cBus.h"
 #include "BaseComponent.h"
 
 class TimeProvider : public BaseComponent {
 public:
+  static constexpr LogTag logTag = LogTag::Time;
+
   TimeProvider(TimeProviderType providerType, const NtpConfig& ntpConfig, const RtcConfig& rtcConfig);
   void begin();
   time_t getCurrentTime();
@@ -13,10 +16,14 @@ public:
 private:
   void setupRtc();
   void setupNtp();
+  bool readRtc(time_t& out);
+
+  static constexpr uint8_t RTC_ADDRESS = 0x68;
 
   TimeProviderType providerType;
   NtpConfig ntpConfig;
   RTC_DS3231 rtc;
+  I2cBus* rtcBus = nullptr;
   RtcConfig rtcConfig;
   bool rtcInitialized = false;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <IPAddress.h>
 #include <cstring>
 #include <vector>
+#include "SensorMessage.h"
 
 // ─────────────────────────────────────────────────────────────
 // Auth & Credentials
@@ -105,6 +106,18 @@ struct ApiConfig {
   }
 };
 
+// What a consumer does with a reading when its queue is full
+enum class OverflowPolicy {
+  DropNewest,      // Discard the incoming reading
+  DropOldest,      // Discard the oldest queued reading to make room
+  CoalesceLatest   // Keep only the latest reading per sensor
+};
+
+struct QueueConfig {
+  uint16_t depth = 10;   // Unused by CoalesceLatest: one slot per sensor
+  OverflowPolicy policy = OverflowPolicy::DropNewest;
+};
+
 struct OverlayConfig {
   String sensorId;
   int identity = 0;
@@ -114,6 +127,9 @@ struct OverlayConfig {
   String position;
   int fontSize;
   String textColor;
+  TemperatureUnit unit = TemperatureUnit::Fahrenheit;   // For {temp}, {min}, {max} and {unit}
+  // Only the latest value is worth drawing, so overlays coalesce by default
+  QueueConfig queue = { 1, OverflowPolicy::CoalesceLatest };
 };
 
 struct CameraConfig {
@@ -127,6 +143,12 @@ struct CameraConfig {
 // Sensor & Time
 // ─────────────────────────────────────────────────────────────
 
+// Names one probe on a multi-drop 1-Wire bus by its ROM ID
+struct OneWireProbeConfig {
+  String rom;    // 16 hex digits, family code first, e.g. "28FF641E8C1603AB"
+  String name;
+};
+
 struct SensorConfig {
   String name;
   String interface;
@@ -141,6 +163,12 @@ struct SensorConfig {
   int csPin       = -1;
   int analogPin   = -1;
   int onewirePin  = -1;
+  uint8_t i2cAddress = 0x76;  // BME280: 0x76 or 0x77 (SDO high)
+  uint8_t resolution = 12;   // DS18B20 bits (9–12): 94 ms at 9 bits up to 750 ms at 12
+
+  // Probes not listed here are published as "<name> <ROM>", or as
+  // <name> when the bus has a single probe
+  std::vector<OneWireProbeConfig> probes;
 
   bool isValid() const {
     return !name.isEmpty() && readIntervalMs > 0;
@@ -257,6 +285,11 @@ struct NetworkConfig {
   }
 };
 
+enum class MqttFormat {
+  Json,
+  MsgPack
+};
+
 struct MqttConfig {
   bool enabled;
   String sensorId;
@@ -270,6 +303,9 @@ struct MqttConfig {
   uint16_t batchSize;
   uint32_t flushIntervalMs;
   int bufferSize;
+  MqttFormat format = MqttFormat::Json;
+  uint32_t spoolMaxBytes = 64 * 1024;
+  QueueConfig queue;
 };
 
 struct NtpConfig {
@@ -0,0 +1,10 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Counts global operator new calls from every thread. Linked into the
+// tests that assert a path does not allocate.
+namespace AllocationCounter {
+uint64_t allocations();
+uint64_t bytes();
+}
@@ -0,0 +1,39 @@
+#pragma once
+// Configuration and broker helpers shared by the MqttManager host tests
+#include <MqttBroker.h>
+#include "Types.h"
+
+inline MqttConfig mqttConfig() {
+  MqttConfig config;
+  config.enabled = true;
+  config.sensorId = "*";
+  config.broker = "broker.local";
+  config.port = 1883;
+  config.clientId = "unit-1";
+  config.topic = "logicgard/readings";
+  config.batchSize = 0;
+  config.flushIntervalMs = 200;
+  config.bufferSize = 1024;
+  config.format = MqttFormat::Json;
+  config.queue.depth = 64;
+  return config;
+}
+
+inline DeviceIdentity identity() {
+  DeviceIdentity id;
+  id.clientId = "client";
+  id.locationId = "site";
+  id.unitId = "unit-1";
+  id.version = "test";
+  id.board = "host";
+  return id;
+}
+
+// Readings in every payload the broker has received (JSON format)
+inline size_t readingsAtBroker() {
+  size_t readings = 0;
+  for (const auto& publish : hal::MqttBroker::instance().publishes()) {
+    for (int pos = 0; (pos = publish.payload.indexOf("\"timestamp\"", pos)) >= 0; ++pos) ++readings;
+  }
+  return readings;
+}
@@ -0,0 +1,14 @@
+#pragma once
+// Helpers shared by the host tests
+#include <Arduino.h>
+
+// Polls pred every 2 ms; false if it is still unmet after timeoutMs
+template<typename Pred>
+bool waitUntil(Pred pred, uint32_t timeoutMs) {
+  uint32_t start = millis();
+  while (!pred()) {
+    if (millis() - start > timeoutMs) return false;
+    delay(2);
+  }
+  return true;
+}
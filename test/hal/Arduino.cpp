@@ -0,0 +1,103 @@
+#include <Arduino.h>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+namespace {
+const auto bootTime = std::chrono::steady_clock::now();
+
+std::mutex randomLock;
+std::mt19937 generator(12345);
+
+uint32_t freeHeap = 200 * 1024;
+uint32_t minFreeHeap = 180 * 1024;
+uint32_t maxAlloc = 110 * 1024;
+}
+
+uint32_t millis() {
+  return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - bootTime).count());
+}
+
+uint32_t micros() {
+  return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - bootTime).count());
+}
+
+void delay(uint32_t ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void yield() {
+  std::this_thread::yield();
+}
+
+long random(long max) {
+  return random(0, max);
+}
+
+long random(long min, long max) {
+  if (max <= min) return min;
+  std::lock_guard<std::mutex> guard(randomLock);
+  return min + static_cast<long>(generator() % static_cast<unsigned long>(max - min));
+}
+
+void randomSeed(unsigned long seed) {
+  std::lock_guard<std::mutex> guard(randomLock);
+  generator.seed(seed);
+}
+
+int Stream::timedRead() {
+  uint32_t start = millis();
+  do {
+    int c = read();
+    if (c >= 0) return c;
+    yield();
+  } while (millis() - start < _timeout);
+  return -1;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+  size_t count = 0;
+  while (count < length) {
+    int c = timedRead();
+    if (c < 0) break;
+    buffer[count++] = static_cast<char>(c);
+  }
+  return count;
+}
+
+String Stream::readString() {
+  String out;
+  int c;
+  while ((c = timedRead()) >= 0) out += static_cast<char>(c);
+  return out;
+}
+
+String Stream::readStringUntil(char terminator) {
+  String out;
+  int c;
+  while ((c = timedRead()) >= 0 && c != terminator) out += static_cast<char>(c);
+  return out;
+}
+
+uint32_t EspClass::getFreeHeap() { return freeHeap; }
+uint32_t EspClass::getMinFreeHeap() { return minFreeHeap; }
+uint32_t EspClass::getMaxAllocHeap() { return maxAlloc; }
+
+void EspClass::restart() {
+  fprintf(stderr, "ESP.restart() called\n");
+  abort();
+}
+
+namespace hal {
+void setHeap(uint32_t free, uint32_t minFree, uint32_t alloc) {
+  freeHeap = free;
+  minFreeHeap = minFree;
+  maxAlloc = alloc;
+}
+}
@@ -0,0 +1,251 @@
+#pragma once
+// Host stand-in for the parts of the ESP32 Arduino core the firmware uses.
+// Behaviour follows the core closely enough for unit tests; nothing here
+// is meant to be fast or complete.
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <string>
+#include <mutex>
+#include <algorithm>
+#include <cmath>
+// The ESP32 core pulls FreeRTOS in through Arduino.h
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#define HEX 16
+#define DEC 10
+
+using std::isnan;
+using std::isinf;
+
+class String {
+public:
+  String() {}
+  String(const char* s) : s(s ? s : "") {}
+  String(const char* s, unsigned int length) : s(s, length) {}
+  String(const std::string& s) : s(s) {}
+  String(char c) : s(1, c) {}
+  String(int v, unsigned char base = DEC) : s(number(static_cast<long long>(v), base)) {}
+  String(unsigned int v, unsigned char base = DEC) : s(number(static_cast<unsigned long long>(v), base)) {}
+  String(long v, unsigned char base = DEC) : s(number(static_cast<long long>(v), base)) {}
+  String(unsigned long v, unsigned char base = DEC) : s(number(static_cast<unsigned long long>(v), base)) {}
+  String(long long v, unsigned char base = DEC) : s(number(v, base)) {}
+  String(unsigned long long v, unsigned char base = DEC) : s(number(v, base)) {}
+  String(float v, unsigned int decimals = 2) : s(fixed(v, decimals)) {}
+  String(double v, unsigned int decimals = 2) : s(fixed(v, decimals)) {}
+
+  const char* c_str() const { return s.c_str(); }
+  unsigned int length() const { return static_cast<unsigned int>(s.size()); }
+  bool isEmpty() const { return s.empty(); }
+  bool reserve(unsigned int size) { s.reserve(size); return true; }
+  char charAt(unsigned int i) const { return i < s.size() ? s[i] : 0; }
+  char operator[](unsigned int i) const { return charAt(i); }
+  char& operator[](unsigned int i) { return s[i]; }
+
+  String& operator+=(const String& o) { s += o.s; return *this; }
+  String& operator+=(const char* o) { s += o ? o : ""; return *this; }
+  String& operator+=(char c) { s += c; return *this; }
+  String& operator+=(int v) { s += number(static_cast<long long>(v), DEC); return *this; }
+  String& operator+=(unsigned int v) { s += number(static_cast<unsigned long long>(v), DEC); return *this; }
+  String& operator+=(long v) { s += number(static_cast<long long>(v), DEC); return *this; }
+  String& operator+=(unsigned long v) { s += number(static_cast<unsigned long long>(v), DEC); return *this; }
+  bool concat(const String& o) { s += o.s; return true; }
+  bool concat(const char* o, unsigned int len) { s.append(o, len); return true; }
+  bool concat(char c) { s += c; return true; }
+
+  bool operator==(const String& o) const { return s == o.s; }
+  bool operator==(const char* o) const { return s == (o ? o : ""); }
+  bool operator!=(const String& o) const { return s != o.s; }
+  bool operator!=(const char* o) const { return !(*this == o); }
+  bool operator<(const String& o) const { return s < o.s; }
+  bool equals(const String& o) const { return s == o.s; }
+  bool equalsIgnoreCase(const String& o) const {
+    if (s.size() != o.s.size()) return false;
+    for (size_t i = 0; i < s.size(); ++i) {
+      if (tolower(static_cast<unsigned char>(s[i])) != tolower(static_cast<unsigned char>(o.s[i]))) return false;
+    }
+    return true;
+  }
+  bool startsWith(const String& prefix) const { return s.compare(0, prefix.s.size(), prefix.s) == 0; }
+  bool endsWith(const String& suffix) const {
+    return s.size() >= suffix.s.size() && s.compare(s.size() - suffix.s.size(), suffix.s.size(), suffix.s) == 0;
+  }
+
+  int indexOf(char c, unsigned int from = 0) const { return found(s.find(c, from)); }
+  int indexOf(const String& o, unsigned int from = 0) const { return found(s.find(o.s, from)); }
+  int lastIndexOf(char c) const { return found(s.rfind(c)); }
+  int lastIndexOf(const String& o) const { return found(s.rfind(o.s)); }
+  String substring(unsigned int from) const { return from < s.size() ? String(s.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= s.size()) return String();
+    return String(s.substr(from, std::min<size_t>(to, s.size()) - from));
+  }
+
+  void trim() {
+    size_t b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos) { s.clear(); return; }
+    s = s.substr(b, s.find_last_not_of(" \t\r\n") - b + 1);
+  }
+  void toLowerCase() { for (char& c : s) c = static_cast<char>(tolower(static_cast<unsigned char>(c))); }
+  void toUpperCase() { for (char& c : s) c = static_cast<char>(toupper(static_cast<unsigned char>(c))); }
+  void replace(const String& from, const String& to) {
+    if (from.s.empty()) return;
+    for (size_t pos = 0; (pos = s.find(from.s, pos)) != std::string::npos; pos += to.s.size()) {
+      s.replace(pos, from.s.size(), to.s);
+    }
+  }
+  void remove(unsigned int index) { if (index < s.size()) s.erase(index); }
+  void remove(unsigned int index, unsigned int count) { if (index < s.size()) s.erase(index, count); }
+  long toInt() const { return strtol(s.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(s.c_str(), nullptr); }
+
+  const std::string& str() const { return s; }
+
+private:
+  static int found(size_t pos) { return pos == std::string::npos ? -1 : static_cast<int>(pos); }
+
+  static std::string number(unsigned long long v, unsigned char base) {
+    if (v == 0) return "0";
+    std::string out;
+    while (v) {
+      int digit = static_cast<int>(v % base);
+      out.insert(out.begin(), static_cast<char>(digit < 10 ? '0' + digit : 'a' + digit - 10));
+      v /= base;
+    }
+    return out;
+  }
+
+  static std::string number(long long v, unsigned char base) {
+    if (v < 0 && base == DEC) return "-" + number(static_cast<unsigned long long>(-v), base);
+    return number(static_cast<unsigned long long>(v), base);
+  }
+
+  static std::string fixed(double v, unsigned int decimals) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(decimals), v);
+    return buffer;
+  }
+
+  std::string s;
+};
+
+inline String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+inline String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, char b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, int b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, unsigned int b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, long b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, unsigned long b) { String r(a); r += b; return r; }
+inline bool operator==(const char* a, const String& b) { return b == a; }
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) { return write(&c, 1); }
+  virtual size_t write(const uint8_t* data, size_t len) = 0;
+  size_t write(const char* s) { return write(reinterpret_cast<const uint8_t*>(s), strlen(s)); }
+
+  size_t print(const char* s) { return write(s); }
+  size_t print(const String& s) { return write(s.c_str()); }
+  size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+  size_t print(int v) { return print(String(v)); }
+  size_t print(unsigned int v) { return print(String(v)); }
+  size_t print(long v) { return print(String(v)); }
+  size_t print(unsigned long v) { return print(String(v)); }
+  size_t print(double v, int decimals = 2) { return print(String(v, decimals)); }
+  template<typename T> size_t println(const T& v) { size_t n = print(v); return n + print("\n"); }
+  size_t println() { return print("\n"); }
+
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char buffer[512];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+    if (len < 0) return 0;
+    return write(reinterpret_cast<const uint8_t*>(buffer), std::min<size_t>(len, sizeof(buffer) - 1));
+  }
+};
+
+// As in the core, the read helpers wait up to the timeout (1 s by default)
+// for each byte; read() and peek() return -1 when nothing is buffered.
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  virtual void flush() {}
+
+  void setTimeout(unsigned long timeout) { _timeout = timeout; }
+  unsigned long getTimeout() const { return _timeout; }
+
+  size_t readBytes(char* buffer, size_t length);
+  size_t readBytes(uint8_t* buffer, size_t length) { return readBytes(reinterpret_cast<char*>(buffer), length); }
+  String readString();
+  String readStringUntil(char terminator);
+
+protected:
+  int timedRead();
+  unsigned long _timeout = 1000;
+};
+
+// Writes to stdout, or nowhere when the test sets quiet (benchmarks).
+// A test can also point capture at a string to collect the output.
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long) {}
+  using Print::write;
+  size_t write(const uint8_t* data, size_t len) override {
+    std::lock_guard<std::mutex> guard(mutex);
+    if (capture) capture->append(reinterpret_cast<const char*>(data), len);
+    if (!quiet) fwrite(data, 1, len, stdout);
+    return len;
+  }
+  operator bool() const { return true; }
+
+  bool quiet = false;
+  std::string* capture = nullptr;
+
+private:
+  std::mutex mutex;
+};
+
+extern HardwareSerial Serial;
+
+// uint32_t rather than unsigned long: on the ESP32 toolchain the two are
+// the same type, and firmware code relies on that (std::min with millis()).
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void yield();
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+template<typename T, typename L, typename H>
+auto constrain(T v, L lo, H hi) -> decltype(v + lo + hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+// Heap figures come from the test (see hal::setHeap); ESP.restart aborts
+class EspClass {
+public:
+  uint32_t getFreeHeap();
+  uint32_t getMinFreeHeap();
+  uint32_t getMaxAllocHeap();
+  [[noreturn]] void restart();
+};
+
+extern EspClass ESP;
+
+namespace hal {
+void setHeap(uint32_t freeHeap, uint32_t minFreeHeap, uint32_t maxAlloc);
+}
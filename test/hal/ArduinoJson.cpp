@@ -0,0 +1,326 @@
+#include <ArduinoJson.h>
+
+namespace hal_json {
+
+namespace {
+void writeString(const std::string& s, std::string& out) {
+  out += '"';
+  for (char c : s) {
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char esc[8];
+          snprintf(esc, sizeof(esc), "\\u%04x", c);
+          out += esc;
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+void skipSpace(const char*& p) {
+  while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') ++p;
+}
+
+bool parseString(const char*& p, std::string& out) {
+  if (*p != '"') return false;
+  ++p;
+  while (*p && *p != '"') {
+    if (*p == '\\') {
+      ++p;
+      switch (*p) {
+        case 'n': out += '\n'; break;
+        case 'r': out += '\r'; break;
+        case 't': out += '\t'; break;
+        case 'b': out += '\b'; break;
+        case 'f': out += '\f'; break;
+        case 'u': {
+          unsigned code = 0;
+          for (int i = 1; i <= 4; ++i) {
+            if (!isxdigit(static_cast<unsigned char>(p[i]))) return false;
+            code = code * 16 + (isdigit(static_cast<unsigned char>(p[i])) ? p[i] - '0' : (tolower(p[i]) - 'a' + 10));
+          }
+          p += 4;
+          if (code < 0x80) {
+            out += static_cast<char>(code);
+          } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+          } else {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+          }
+          break;
+        }
+        case '\0': return false;
+        default: out += *p;
+      }
+      ++p;
+    } else {
+      out += *p++;
+    }
+  }
+  if (*p != '"') return false;
+  ++p;
+  return true;
+}
+}  // namespace
+
+void write(const NodePtr& node, std::string& out) {
+  if (!node) {
+    out += "null";
+    return;
+  }
+  switch (node->type) {
+    case Node::Null: out += "null"; break;
+    case Node::Bool: out += node->b ? "true" : "false"; break;
+    case Node::Int: out += std::to_string(node->i); break;
+    case Node::Float: {
+      char buffer[32];
+      snprintf(buffer, sizeof(buffer), "%.9g", node->d);
+      out += buffer;
+      break;
+    }
+    case Node::Str: writeString(node->s, out); break;
+    case Node::Arr:
+      out += '[';
+      for (size_t i = 0; i < node->arr.size(); ++i) {
+        if (i) out += ',';
+        write(node->arr[i], out);
+      }
+      out += ']';
+      break;
+    case Node::Obj:
+      out += '{';
+      for (size_t i = 0; i < node->obj.size(); ++i) {
+        if (i) out += ',';
+        writeString(node->obj[i].first, out);
+        out += ':';
+        write(node->obj[i].second, out);
+      }
+      out += '}';
+      break;
+  }
+}
+
+bool copy(const Node& src, Node& dst) {
+  dst.type = src.type;
+  dst.b = src.b;
+  dst.i = src.i;
+  dst.d = src.d;
+  switch (src.type) {
+    case Node::Str:
+      if (!src.linked && !dst.chargeString(src.s)) {
+        dst.reset();
+        return false;
+      }
+      dst.s = src.s;
+      dst.linked = src.linked;
+      return true;
+    case Node::Arr:
+      for (const NodePtr& element : src.arr) {
+        NodePtr n = dst.addElement();
+        if (!n || !copy(*element, *n)) return false;
+      }
+      return true;
+    case Node::Obj:
+      for (const auto& kv : src.obj) {
+        NodePtr n = dst.addMember(kv.first, kv.second->keyLinked);
+        if (!n || !copy(*kv.second, *n)) return false;
+      }
+      return true;
+    default:
+      return true;
+  }
+}
+
+namespace {
+typedef DeserializationError::Code Code;
+
+// What a filter lets through at one point of the input
+class Filter {
+public:
+  static Filter all() { return Filter(nullptr, true); }
+  explicit Filter(const NodePtr& node) : Filter(node, false) {}
+
+  bool allow() const { return everything || (node && truthy(*node)); }
+  bool allowObject() const { return everything || isTrue() || (node && node->type == Node::Obj); }
+  bool allowArray() const { return everything || isTrue() || (node && node->type == Node::Arr); }
+  bool allowValue() const { return everything || isTrue(); }
+
+  Filter member(const std::string& key) const {
+    if (everything || isTrue()) return *this;
+    if (!node || node->type != Node::Obj) return Filter(nullptr);
+    NodePtr m = node->member(key);
+    return Filter(m && m->type != Node::Null ? m : node->member("*"));
+  }
+  Filter element() const {
+    if (everything || isTrue()) return *this;
+    return Filter(node && node->type == Node::Arr && !node->arr.empty() ? node->arr[0] : nullptr);
+  }
+
+private:
+  Filter(const NodePtr& node, bool everything) : node(node), everything(everything) {}
+
+  static bool truthy(const Node& n) {
+    switch (n.type) {
+      case Node::Null: return false;
+      case Node::Bool: return n.b;
+      case Node::Int: return n.i != 0;
+      case Node::Float: return n.d != 0;
+      default: return true;
+    }
+  }
+  bool isTrue() const { return node && node->type == Node::Bool && node->b; }
+
+  NodePtr node;
+  bool everything;
+};
+
+// Parses one value into target, or skips it when target is null
+class Parser {
+public:
+  Parser(const char* p, bool copyStrings) : p(p), copyStrings(copyStrings) {}
+
+  Code value(Node* target, const Filter& filter, uint8_t nesting) {
+    skipSpace(p);
+    switch (*p) {
+      case '{': return object(filter.allowObject() ? target : nullptr, filter, nesting);
+      case '[': return array(filter.allowArray() ? target : nullptr, filter, nesting);
+      case '\0': return Code::IncompleteInput;
+      default: return scalar(filter.allowValue() ? target : nullptr);
+    }
+  }
+
+private:
+  Code failure() const { return *p ? Code::InvalidInput : Code::IncompleteInput; }
+
+  Code object(Node* target, const Filter& filter, uint8_t nesting) {
+    if (nesting == 0) return Code::TooDeep;
+    ++p;
+    if (target) target->type = Node::Obj;
+    skipSpace(p);
+    if (*p == '}') { ++p; return Code::Ok; }
+    for (;;) {
+      skipSpace(p);
+      std::string key;
+      if (!parseString(p, key)) return failure();
+      skipSpace(p);
+      if (*p != ':') return failure();
+      ++p;
+      Filter memberFilter = filter.member(key);
+      NodePtr child;
+      if (target && memberFilter.allow()) {
+        // A repeated key overwrites the first
+        child = target->member(key);
+        if (child) {
+          child->reset();
+        } else if (!(child = target->addMember(key, !copyStrings))) {
+          return Code::NoMemory;
+        }
+      }
+      Code code = value(child.get(), memberFilter, nesting - 1);
+      if (code != Code::Ok) return code;
+      skipSpace(p);
+      if (*p == ',') { ++p; continue; }
+      if (*p == '}') { ++p; return Code::Ok; }
+      return failure();
+    }
+  }
+
+  Code array(Node* target, const Filter& filter, uint8_t nesting) {
+    if (nesting == 0) return Code::TooDeep;
+    ++p;
+    if (target) target->type = Node::Arr;
+    skipSpace(p);
+    if (*p == ']') { ++p; return Code::Ok; }
+    Filter elementFilter = filter.element();
+    for (;;) {
+      NodePtr child;
+      if (target && elementFilter.allow() && !(child = target->addElement())) return Code::NoMemory;
+      Code code = value(child.get(), elementFilter, nesting - 1);
+      if (code != Code::Ok) return code;
+      skipSpace(p);
+      if (*p == ',') { ++p; continue; }
+      if (*p == ']') { ++p; return Code::Ok; }
+      return failure();
+    }
+  }
+
+  Code scalar(Node* target) {
+    if (*p == '"') {
+      std::string str;
+      if (!parseString(p, str)) return failure();
+      if (!target) return Code::Ok;
+      if (copyStrings && !target->chargeString(str)) return Code::NoMemory;
+      target->type = Node::Str;
+      target->s = str;
+      target->linked = !copyStrings;
+      return Code::Ok;
+    }
+
+    Node parsed;
+    if (strncmp(p, "true", 4) == 0) {
+      p += 4;
+      parsed.type = Node::Bool;
+      parsed.b = true;
+    } else if (strncmp(p, "false", 5) == 0) {
+      p += 5;
+      parsed.type = Node::Bool;
+    } else if (strncmp(p, "null", 4) == 0) {
+      p += 4;
+    } else {
+      const char* start = p;
+      if (*p == '-') ++p;
+      if (!isdigit(static_cast<unsigned char>(*p))) return failure();
+      bool isFloat = false;
+      while (isdigit(static_cast<unsigned char>(*p)) || *p == '.' || *p == 'e' || *p == 'E' || *p == '+' || *p == '-') {
+        if (*p == '.' || *p == 'e' || *p == 'E') isFloat = true;
+        ++p;
+      }
+      std::string number(start, p);
+      if (isFloat) {
+        parsed.type = Node::Float;
+        parsed.d = strtod(number.c_str(), nullptr);
+      } else {
+        parsed.type = Node::Int;
+        parsed.i = strtoll(number.c_str(), nullptr, 10);
+      }
+    }
+    if (target) {
+      target->type = parsed.type;
+      target->b = parsed.b;
+      target->i = parsed.i;
+      target->d = parsed.d;
+    }
+    return Code::Ok;
+  }
+
+  const char* p;
+  bool copyStrings;
+};
+}  // namespace
+
+Code deserialize(JsonDocument& doc, const char* input, size_t length, const ParseOptions& options) {
+  doc.clear();
+  if (!input || length == 0) return Code::EmptyInput;
+  std::string text(input, length);
+  const char* start = text.c_str();
+  skipSpace(start);
+  if (!*start) return Code::EmptyInput;
+  Parser parser(text.c_str(), options.copyStrings);
+  Filter filter = options.filtered ? Filter(options.filter) : Filter::all();
+  Code code = parser.value(doc.root().get(), filter, options.nestingLimit);
+  if (code != Code::Ok) doc.clear();
+  return code;
+}
+
+}  // namespace hal_json
@@ -0,0 +1,724 @@
+#pragma once
+// Host stand-in for the subset of ArduinoJson 6.21 the firmware uses: a
+// tree of shared nodes with lazily created members, a strict parser and a
+// compact serializer. Documents keep the library's ESP32 memory accounting
+// so capacities bite where they would on the device: every member or
+// element takes a 16-byte slot, copied strings take their length plus one
+// and are deduplicated, linked strings (const char* values and keys) are
+// free. Running out sets overflowed() and leaves the value null, and
+// deserializeJson() reports NoMemory (then clears the document, where the
+// library would keep what fitted). Filters and the nesting limit behave as
+// in the library.
+#include <Arduino.h>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Pool sizes on a 32-bit target
+#define JSON_ARRAY_SIZE(NUMBER_OF_ELEMENTS) ((NUMBER_OF_ELEMENTS) * 16)
+#define JSON_OBJECT_SIZE(NUMBER_OF_ELEMENTS) ((NUMBER_OF_ELEMENTS) * 16)
+#define JSON_STRING_SIZE(SIZE) ((SIZE) + 1)
+
+namespace hal_json {
+
+// A document's memory pool
+struct Pool {
+  static constexpr size_t SLOT_SIZE = 16;
+
+  explicit Pool(size_t capacity) : capacity(capacity) {}
+
+  size_t capacity;
+  size_t used = 0;
+  bool overflowed = false;
+  std::set<std::string> strings;   // Copied strings, for deduplication
+
+  bool alloc(size_t bytes) {
+    if (capacity - used < bytes) {
+      overflowed = true;
+      return false;
+    }
+    used += bytes;
+    return true;
+  }
+  bool slot() { return alloc(SLOT_SIZE); }
+  bool copy(const std::string& str) {
+    if (strings.count(str)) return true;
+    if (!alloc(str.size() + 1)) return false;
+    strings.insert(str);
+    return true;
+  }
+  void clear() {
+    used = 0;
+    overflowed = false;
+    strings.clear();
+  }
+};
+typedef std::shared_ptr<Pool> PoolPtr;
+
+struct Node;
+typedef std::shared_ptr<Node> NodePtr;
+
+struct Node {
+  enum Type { Null, Bool, Int, Float, Str, Arr, Obj } type = Null;
+  bool b = false;
+  long long i = 0;
+  double d = 0;
+  std::string s;
+  bool linked = false;      // s points at the caller's string
+  bool keyLinked = false;   // The key this node sits under does
+  std::vector<NodePtr> arr;
+  std::vector<std::pair<std::string, NodePtr>> obj;
+  PoolPtr pool;             // Null for nodes outside any document
+
+  NodePtr member(const std::string& key) const {
+    for (const auto& kv : obj) {
+      if (kv.first == key) return kv.second;
+    }
+    return nullptr;
+  }
+
+  // Back to null, staying in the same pool and under the same key
+  void reset() {
+    type = Null;
+    b = false;
+    i = 0;
+    d = 0;
+    s.clear();
+    linked = false;
+    arr.clear();
+    obj.clear();
+  }
+
+  bool charge(bool (Pool::*what)()) const { return !pool || (pool.get()->*what)(); }
+  bool chargeString(const std::string& str) const { return !pool || pool->copy(str); }
+  NodePtr child() const {
+    auto n = std::make_shared<Node>();
+    n->pool = pool;
+    return n;
+  }
+
+  // Adds a member (a slot, plus the key unless linked); null if it does not fit
+  NodePtr addMember(const std::string& key, bool linkedKey) {
+    if (!charge(&Pool::slot)) return nullptr;
+    if (!linkedKey && !chargeString(key)) return nullptr;
+    NodePtr n = child();
+    n->keyLinked = linkedKey;
+    obj.push_back({ key, n });
+    return n;
+  }
+  NodePtr addElement() {
+    if (!charge(&Pool::slot)) return nullptr;
+    arr.push_back(child());
+    return arr.back();
+  }
+};
+
+typedef std::function<NodePtr(bool create)> Resolver;
+
+// Deep copy of src into dst, charged to dst's pool
+bool copy(const Node& src, Node& dst);
+void write(const NodePtr& node, std::string& out);
+
+}  // namespace hal_json
+
+class JsonArray;
+class JsonObject;
+
+class JsonVariant {
+public:
+  JsonVariant() : resolve([](bool) { return hal_json::NodePtr(); }) {}
+  explicit JsonVariant(hal_json::Resolver resolve) : resolve(std::move(resolve)) {}
+  explicit JsonVariant(hal_json::NodePtr node) : resolve([node](bool) { return node; }) {}
+
+  // const char* keys are linked; String and std::string keys are copied
+  JsonVariant operator[](const char* key) const { return member(key, true); }
+  JsonVariant operator[](const String& key) const { return member(key.c_str(), false); }
+  JsonVariant operator[](const std::string& key) const { return member(key, false); }
+  JsonVariant operator[](int index) const;
+
+  bool isNull() const {
+    hal_json::NodePtr n = resolve(false);
+    return !n || n->type == hal_json::Node::Null;
+  }
+
+  bool containsKey(const char* key) const {
+    hal_json::NodePtr n = resolve(false);
+    return n && n->type == hal_json::Node::Obj && n->member(key) != nullptr;
+  }
+  bool containsKey(const String& key) const { return containsKey(key.c_str()); }
+
+  template<typename T>
+  T as() const;
+
+  template<typename T>
+  bool is() const;
+
+  template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value ||
+                                                          std::is_same<T, String>::value ||
+                                                          std::is_same<T, const char*>::value>::type>
+  operator T() const { return as<T>(); }
+
+  template<typename T>
+  JsonVariant& operator=(const T& value) {
+    set(value);
+    return *this;
+  }
+  // As in the library, assigning to a variable rebinds it, while assigning
+  // to doc["key"] or array[i] (a temporary here, a proxy there) copies
+  JsonVariant(const JsonVariant&) = default;
+  JsonVariant& operator=(const JsonVariant& other) & {
+    resolve = other.resolve;
+    return *this;
+  }
+  JsonVariant& operator=(const JsonVariant& other) && {
+    set(other);
+    return *this;
+  }
+
+  // A deep copy, also between documents
+  bool set(const JsonVariant& other) {
+    hal_json::NodePtr src = other.resolve(false);
+    hal_json::NodePtr dst = resolve(true);
+    if (!dst) return false;
+    if (src == dst) return true;
+    hal_json::Node copy = src ? *src : hal_json::Node();
+    dst->reset();
+    return hal_json::copy(copy, *dst);
+  }
+  bool set(const char* v) { return setString(v, false); }
+  bool set(char* v) { return setString(v, true); }
+  bool set(const String& v) { return setString(v.c_str(), true); }
+  bool set(const std::string& v) { return setString(v.c_str(), true); }
+  bool set(bool v) { return assign([&](hal_json::Node& n) { n.type = hal_json::Node::Bool; n.b = v; }); }
+  template<typename T>
+  typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, bool>::type set(T v) {
+    return assign([&](hal_json::Node& n) { n.type = hal_json::Node::Int; n.i = static_cast<long long>(v); });
+  }
+  template<typename T>
+  typename std::enable_if<std::is_floating_point<T>::value, bool>::type set(T v) {
+    return assign([&](hal_json::Node& n) { n.type = hal_json::Node::Float; n.d = v; });
+  }
+  template<size_t N>
+  bool set(const char (&v)[N]) { return set(static_cast<const char*>(v)); }
+
+  JsonObject createNestedObject(const char* key) const;
+  JsonArray createNestedArray(const char* key) const;
+  bool add(const JsonVariant&) = delete;
+  template<typename T>
+  bool add(const T& value) const;
+
+  size_t size() const {
+    hal_json::NodePtr n = resolve(false);
+    if (!n) return 0;
+    return n->type == hal_json::Node::Arr ? n->arr.size() : n->type == hal_json::Node::Obj ? n->obj.size() : 0;
+  }
+
+  hal_json::NodePtr node() const { return resolve(false); }
+
+protected:
+  JsonVariant member(const std::string& key, bool linkedKey) const {
+    hal_json::Resolver parent = resolve;
+    return JsonVariant([parent, key, linkedKey](bool create) -> hal_json::NodePtr {
+      hal_json::NodePtr p = parent(create);
+      if (!p) return nullptr;
+      if (p->type == hal_json::Node::Obj) {
+        if (hal_json::NodePtr m = p->member(key)) return m;
+      }
+      if (!create) return nullptr;
+      if (p->type == hal_json::Node::Null) p->type = hal_json::Node::Obj;
+      if (p->type != hal_json::Node::Obj) return nullptr;
+      return p->addMember(key, linkedKey);
+    });
+  }
+
+  // Copied strings that do not fit leave the value null
+  bool setString(const char* v, bool copy) {
+    hal_json::NodePtr n = resolve(true);
+    if (!n) return false;
+    n->reset();
+    if (!v) return true;
+    if (copy && !n->chargeString(v)) return false;
+    n->type = hal_json::Node::Str;
+    n->s = v;
+    n->linked = !copy;
+    return true;
+  }
+
+  bool assign(const std::function<void(hal_json::Node&)>& fill) {
+    hal_json::NodePtr n = resolve(true);
+    if (!n) return false;
+    n->reset();
+    fill(*n);
+    return true;
+  }
+
+  hal_json::Resolver resolve;
+};
+
+typedef JsonVariant JsonVariantConst;
+
+template<typename T>
+inline auto operator|(const JsonVariant& v, const T& fallback)
+    -> typename std::conditional<std::is_array<T>::value, const char*, T>::type {
+  typedef typename std::conditional<std::is_array<T>::value, const char*, T>::type R;
+  if (!v.template is<R>()) return fallback;
+  return v.template as<R>();
+}
+
+inline String operator|(const JsonVariant& v, const String& fallback) {
+  if (!v.is<const char*>()) return fallback;
+  return v.as<String>();
+}
+
+class JsonString {
+public:
+  explicit JsonString(const char* str) : str(str) {}
+  const char* c_str() const { return str; }
+  bool operator==(const char* other) const { return strcmp(str, other) == 0; }
+  bool operator!=(const char* other) const { return !(*this == other); }
+
+private:
+  const char* str;
+};
+
+struct JsonPair {
+  JsonString key() const { return JsonString(k->c_str()); }
+  JsonVariant value() const { return JsonVariant(v); }
+  const std::string* k;
+  hal_json::NodePtr v;
+};
+
+class JsonObject : public JsonVariant {
+public:
+  JsonObject() {}
+  explicit JsonObject(hal_json::NodePtr node) : JsonVariant(node) {}
+
+  class iterator {
+  public:
+    iterator(hal_json::NodePtr node, size_t i) : node(node), i(i) {}
+    JsonPair operator*() const { return { &node->obj[i].first, node->obj[i].second }; }
+    iterator& operator++() { ++i; return *this; }
+    bool operator!=(const iterator& o) const { return i != o.i; }
+
+  private:
+    hal_json::NodePtr node;
+    size_t i;
+  };
+
+  iterator begin() const {
+    hal_json::NodePtr n = obj();
+    return iterator(n, 0);
+  }
+  iterator end() const {
+    hal_json::NodePtr n = obj();
+    return iterator(n, n ? n->obj.size() : 0);
+  }
+
+  void remove(const char* key) const {
+    hal_json::NodePtr n = obj();
+    if (!n) return;
+    for (auto it = n->obj.begin(); it != n->obj.end(); ++it) {
+      if (it->first == key) { n->obj.erase(it); return; }
+    }
+  }
+
+private:
+  hal_json::NodePtr obj() const {
+    hal_json::NodePtr n = resolve(false);
+    return n && n->type == hal_json::Node::Obj ? n : nullptr;
+  }
+};
+
+typedef JsonObject JsonObjectConst;
+
+class JsonArray : public JsonVariant {
+public:
+  JsonArray() {}
+  explicit JsonArray(hal_json::NodePtr node) : JsonVariant(node) {}
+
+  class iterator {
+  public:
+    iterator(hal_json::NodePtr node, size_t i) : node(node), i(i) {}
+    JsonObject operator*() const { return JsonObject(node->arr[i]); }
+    iterator& operator++() { ++i; return *this; }
+    bool operator!=(const iterator& o) const { return i != o.i; }
+
+  private:
+    hal_json::NodePtr node;
+    size_t i;
+  };
+
+  iterator begin() const { return iterator(arr(), 0); }
+  iterator end() const {
+    hal_json::NodePtr n = arr();
+    return iterator(n, n ? n->arr.size() : 0);
+  }
+
+  JsonObject createNestedObject() const {
+    hal_json::NodePtr n = resolve(true);
+    if (!n) return JsonObject();
+    if (n->type == hal_json::Node::Null) n->type = hal_json::Node::Arr;
+    if (n->type != hal_json::Node::Arr) return JsonObject();
+    hal_json::NodePtr child = n->addElement();
+    if (!child) return JsonObject();
+    child->type = hal_json::Node::Obj;
+    return JsonObject(child);
+  }
+
+  // Like the library, the pool keeps the removed elements' memory
+  void clear() const {
+    if (hal_json::NodePtr n = arr()) n->arr.clear();
+  }
+
+private:
+  hal_json::NodePtr arr() const {
+    hal_json::NodePtr n = resolve(false);
+    return n && n->type == hal_json::Node::Arr ? n : nullptr;
+  }
+};
+
+typedef JsonArray JsonArrayConst;
+
+inline JsonVariant JsonVariant::operator[](int index) const {
+  hal_json::Resolver parent = resolve;
+  size_t i = static_cast<size_t>(index);
+  return JsonVariant([parent, i](bool create) -> hal_json::NodePtr {
+    hal_json::NodePtr p = parent(create);
+    if (!p) return nullptr;
+    if (p->type == hal_json::Node::Arr && i < p->arr.size()) return p->arr[i];
+    if (!create) return nullptr;
+    if (p->type == hal_json::Node::Null) p->type = hal_json::Node::Arr;
+    if (p->type != hal_json::Node::Arr) return nullptr;
+    while (p->arr.size() <= i) {
+      if (!p->addElement()) return nullptr;
+    }
+    return p->arr[i];
+  });
+}
+
+inline JsonObject JsonVariant::createNestedObject(const char* key) const {
+  JsonVariant child = member(key, true);
+  hal_json::NodePtr n = child.resolve(true);
+  if (!n) return JsonObject();
+  n->reset();
+  n->type = hal_json::Node::Obj;
+  return JsonObject(n);
+}
+
+inline JsonArray JsonVariant::createNestedArray(const char* key) const {
+  JsonVariant child = member(key, true);
+  hal_json::NodePtr n = child.resolve(true);
+  if (!n) return JsonArray();
+  n->reset();
+  n->type = hal_json::Node::Arr;
+  return JsonArray(n);
+}
+
+template<typename T>
+inline bool JsonVariant::add(const T& value) const {
+  hal_json::NodePtr n = resolve(true);
+  if (!n) return false;
+  if (n->type == hal_json::Node::Null) n->type = hal_json::Node::Arr;
+  if (n->type != hal_json::Node::Arr) return false;
+  hal_json::NodePtr element = n->addElement();
+  return element && JsonVariant(element).set(value);
+}
+
+namespace hal_json {
+template<typename T, typename Enable = void>
+struct Convert;
+
+template<typename T>
+struct Convert<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> {
+  static bool fits(long long v) {
+    if (std::is_signed<T>::value) {
+      return v >= static_cast<long long>(std::numeric_limits<T>::min()) &&
+             v <= static_cast<long long>(std::numeric_limits<T>::max());
+    }
+    return v >= 0 && static_cast<unsigned long long>(v) <= static_cast<unsigned long long>(std::numeric_limits<T>::max());
+  }
+  static bool is(const NodePtr& n) { return n && n->type == Node::Int && fits(n->i); }
+  // Out of range reads as 0; numeric strings are parsed
+  static T as(const NodePtr& n) {
+    if (!n) return 0;
+    switch (n->type) {
+      case Node::Int: return fits(n->i) ? static_cast<T>(n->i) : 0;
+      case Node::Float: {
+        if (n->d < static_cast<double>(std::numeric_limits<long long>::min()) ||
+            n->d > static_cast<double>(std::numeric_limits<long long>::max())) {
+          return 0;
+        }
+        long long v = static_cast<long long>(n->d);
+        return fits(v) ? static_cast<T>(v) : 0;
+      }
+      case Node::Bool: return n->b ? 1 : 0;
+      case Node::Str: {
+        Node parsed;
+        parsed.type = Node::Int;
+        parsed.i = strtoll(n->s.c_str(), nullptr, 10);
+        return fits(parsed.i) ? static_cast<T>(parsed.i) : 0;
+      }
+      default: return 0;
+    }
+  }
+};
+
+template<typename T>
+struct Convert<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+  static bool is(const NodePtr& n) { return n && (n->type == Node::Int || n->type == Node::Float); }
+  static T as(const NodePtr& n) {
+    if (!n) return 0;
+    if (n->type == Node::Int) return static_cast<T>(n->i);
+    if (n->type == Node::Float) return static_cast<T>(n->d);
+    if (n->type == Node::Bool) return n->b ? 1 : 0;
+    if (n->type == Node::Str) return static_cast<T>(strtod(n->s.c_str(), nullptr));
+    return 0;
+  }
+};
+
+template<>
+struct Convert<bool> {
+  static bool is(const NodePtr& n) { return n && n->type == Node::Bool; }
+  // Null is false, numbers are compared to zero, anything else is true
+  static bool as(const NodePtr& n) {
+    if (!n) return false;
+    switch (n->type) {
+      case Node::Null: return false;
+      case Node::Bool: return n->b;
+      case Node::Int: return n->i != 0;
+      case Node::Float: return n->d != 0;
+      default: return true;
+    }
+  }
+};
+
+template<>
+struct Convert<const char*> {
+  static bool is(const NodePtr& n) { return n && n->type == Node::Str; }
+  static const char* as(const NodePtr& n) { return n && n->type == Node::Str ? n->s.c_str() : nullptr; }
+};
+
+template<>
+struct Convert<String> {
+  static bool is(const NodePtr& n) { return n && n->type == Node::Str; }
+  static String as(const NodePtr& n) {
+    if (!n || n->type == Node::Null) return String("null");
+    if (n->type == Node::Str) return String(n->s.c_str());
+    std::string out;
+    write(n, out);
+    return String(out.c_str());
+  }
+};
+
+template<>
+struct Convert<JsonObject> {
+  static bool is(const NodePtr& n) { return n && n->type == Node::Obj; }
+  static JsonObject as(const NodePtr& n) { return is(n) ? JsonObject(n) : JsonObject(); }
+};
+
+template<>
+struct Convert<JsonArray> {
+  static bool is(const NodePtr& n) { return n && n->type == Node::Arr; }
+  static JsonArray as(const NodePtr& n) { return is(n) ? JsonArray(n) : JsonArray(); }
+};
+
+template<>
+struct Convert<JsonVariant> {
+  static bool is(const NodePtr&) { return true; }
+  static JsonVariant as(const NodePtr& n) { return n ? JsonVariant(n) : JsonVariant(); }
+};
+}  // namespace hal_json
+
+template<typename T>
+inline T JsonVariant::as() const {
+  return hal_json::Convert<T>::as(resolve(false));
+}
+
+template<typename T>
+inline bool JsonVariant::is() const {
+  return hal_json::Convert<T>::is(resolve(false));
+}
+
+class JsonDocument : public JsonVariant {
+public:
+  explicit JsonDocument(size_t capacity) : JsonVariant(makeRoot(capacity)) {}
+  JsonDocument(const JsonDocument& o) : JsonDocument(o.capacity()) { set(o); }
+  JsonDocument& operator=(const JsonDocument& o) {
+    if (this != &o) {
+      clear();
+      set(o);
+    }
+    return *this;
+  }
+
+  template<typename T>
+  JsonDocument& operator=(const T& value) {
+    JsonVariant::operator=(value);
+    return *this;
+  }
+
+  template<typename T>
+  T to() {
+    clear();
+    root()->type = std::is_same<T, JsonArray>::value ? hal_json::Node::Arr : hal_json::Node::Obj;
+    return as<T>();
+  }
+
+  void clear() {
+    root()->reset();
+    root()->pool->clear();
+  }
+  size_t capacity() const { return root()->pool->capacity; }
+  size_t memoryUsage() const { return root()->pool->used; }
+  bool overflowed() const { return root()->pool->overflowed; }
+
+  hal_json::NodePtr root() const { return resolve(false); }
+
+private:
+  static hal_json::NodePtr makeRoot(size_t capacity) {
+    auto root = std::make_shared<hal_json::Node>();
+    root->pool = std::make_shared<hal_json::Pool>(capacity);
+    return root;
+  }
+};
+
+template<size_t Capacity>
+class StaticJsonDocument : public JsonDocument {
+public:
+  StaticJsonDocument() : JsonDocument(Capacity) {}
+  using JsonDocument::operator=;
+};
+
+class DynamicJsonDocument : public JsonDocument {
+public:
+  explicit DynamicJsonDocument(size_t capacity) : JsonDocument(capacity) {}
+  using JsonDocument::operator=;
+};
+
+class DeserializationError {
+public:
+  enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory, TooDeep };
+
+  DeserializationError(Code code = Ok) : code_(code) {}
+  explicit operator bool() const { return code_ != Ok; }
+  bool operator==(Code c) const { return code_ == c; }
+  bool operator!=(Code c) const { return code_ != c; }
+  Code code() const { return code_; }
+  const char* c_str() const {
+    static const char* const names[] = { "Ok", "EmptyInput", "IncompleteInput", "InvalidInput", "NoMemory", "TooDeep" };
+    return names[code_];
+  }
+
+private:
+  Code code_;
+};
+
+namespace DeserializationOption {
+// Keeps the members whose filter value is true (or an object or array
+// filtering their children); "*" matches any key and an array's first
+// element filters all its elements
+struct Filter {
+  explicit Filter(const JsonVariant& filter) : node(filter.node()) {}
+  hal_json::NodePtr node;
+};
+struct NestingLimit {
+  explicit NestingLimit(uint8_t limit = 10) : limit(limit) {}
+  uint8_t limit;
+};
+}
+
+namespace hal_json {
+struct ParseOptions {
+  bool filtered = false;
+  NodePtr filter;
+  uint8_t nestingLimit = 10;
+  bool copyStrings = true;   // False for char* input, which the library parses in place
+};
+
+inline void apply(ParseOptions&) {}
+template<typename... Rest>
+void apply(ParseOptions& options, const DeserializationOption::Filter& filter, Rest... rest) {
+  options.filtered = true;
+  options.filter = filter.node;
+  apply(options, rest...);
+}
+template<typename... Rest>
+void apply(ParseOptions& options, const DeserializationOption::NestingLimit& limit, Rest... rest) {
+  options.nestingLimit = limit.limit;
+  apply(options, rest...);
+}
+
+DeserializationError::Code deserialize(JsonDocument& doc, const char* input, size_t length, const ParseOptions& options);
+
+template<typename... Options>
+DeserializationError deserialize(JsonDocument& doc, const char* input, size_t length, bool copyStrings,
+                                 Options... options) {
+  ParseOptions parsed;
+  parsed.copyStrings = copyStrings;
+  apply(parsed, options...);
+  return deserialize(doc, input, length, parsed);
+}
+}  // namespace hal_json
+
+template<typename... Options>
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* input, size_t length, Options... options) {
+  return hal_json::deserialize(doc, input, length, true, options...);
+}
+template<typename... Options>
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* input, Options... options) {
+  return hal_json::deserialize(doc, input, input ? strlen(input) : 0, true, options...);
+}
+// A writable buffer is parsed in place: its strings cost the pool nothing
+template<typename... Options>
+inline DeserializationError deserializeJson(JsonDocument& doc, char* input, Options... options) {
+  return hal_json::deserialize(doc, input, input ? strlen(input) : 0, false, options...);
+}
+template<typename... Options>
+inline DeserializationError deserializeJson(JsonDocument& doc, const String& input, Options... options) {
+  return hal_json::deserialize(doc, input.c_str(), input.length(), true, options...);
+}
+template<typename... Options>
+inline DeserializationError deserializeJson(JsonDocument& doc, const std::string& input, Options... options) {
+  return hal_json::deserialize(doc, input.c_str(), input.size(), true, options...);
+}
+// Reads to the end of the stream; the library stops after the first value
+template<typename... Options>
+inline DeserializationError deserializeJson(JsonDocument& doc, Stream& input, Options... options) {
+  std::string text;
+  for (int c; (c = input.read()) >= 0;) text += static_cast<char>(c);
+  return hal_json::deserialize(doc, text.c_str(), text.size(), true, options...);
+}
+
+inline size_t serializeJson(const JsonVariant& v, String& out) {
+  std::string s;
+  hal_json::write(v.node(), s);
+  out = String(s.c_str());
+  return s.size();
+}
+
+inline size_t serializeJson(const JsonVariant& v, char* out, size_t cap) {
+  std::string s;
+  hal_json::write(v.node(), s);
+  if (!cap) return 0;
+  size_t n = std::min(s.size(), cap - 1);
+  memcpy(out, s.data(), n);
+  out[n] = '\0';
+  return n;
+}
+
+inline size_t serializeJson(const JsonVariant& v, Print& out) {
+  std::string s;
+  hal_json::write(v.node(), s);
+  return out.write(reinterpret_cast<const uint8_t*>(s.data()), s.size());
+}
+
+inline size_t measureJson(const JsonVariant& v) {
+  std::string s;
+  hal_json::write(v.node(), s);
+  return s.size();
+}
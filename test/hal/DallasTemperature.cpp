@@ -0,0 +1,78 @@
+#include <DallasTemperature.h>
+#include <map>
+
+hal::OneWireBus& hal::OneWireBus::onPin(uint8_t pin) {
+  static std::map<uint8_t, OneWireBus>* buses = new std::map<uint8_t, OneWireBus>();
+  return (*buses)[pin];
+}
+
+void hal::OneWireBus::resetAll() {
+  for (uint8_t pin = 0; pin < 64; ++pin) onPin(pin) = OneWireBus();
+}
+
+namespace {
+hal::Ds18b20* findProbe(hal::OneWireBus& bus, const uint8_t* address) {
+  for (auto& probe : bus.probes) {
+    if (memcmp(probe.rom, address, 8) == 0) return &probe;
+  }
+  return nullptr;
+}
+}
+
+uint8_t DallasTemperature::getDeviceCount() {
+  return static_cast<uint8_t>(bus().probes.size());
+}
+
+bool DallasTemperature::getAddress(uint8_t* address, uint8_t index) {
+  if (index >= bus().probes.size()) return false;
+  memcpy(address, bus().probes[index].rom, 8);
+  return true;
+}
+
+void DallasTemperature::setResolution(uint8_t bits) {
+  for (auto& probe : bus().probes) probe.resolution = constrain(bits, 9, 12);
+}
+
+bool DallasTemperature::setResolution(const uint8_t* address, uint8_t bits) {
+  hal::Ds18b20* probe = findProbe(bus(), address);
+  if (!probe) return false;
+  probe->resolution = constrain(bits, 9, 12);
+  return true;
+}
+
+uint16_t DallasTemperature::millisToWaitForConversion(uint8_t bits) {
+  switch (bits) {
+    case 9: return 94;
+    case 10: return 188;
+    case 11: return 375;
+    default: return 750;
+  }
+}
+
+void DallasTemperature::requestTemperatures() {
+  hal::OneWireBus& b = bus();
+  uint8_t bits = 9;
+  for (const auto& probe : b.probes) bits = std::max(bits, probe.resolution);
+  ++b.conversions;
+  b.lastConvertMs = millis();
+  b.convertingMs = millisToWaitForConversion(bits);
+  if (waitForConversion) delay(b.convertingMs);
+}
+
+float DallasTemperature::getTempC(const uint8_t* address) {
+  hal::OneWireBus& b = bus();
+  ++b.reads;
+  hal::Ds18b20* probe = findProbe(b, address);
+  if (!probe || !probe->connected) return DEVICE_DISCONNECTED_C;
+  if (b.conversions == 0 || millis() - b.lastConvertMs < b.convertingMs) {
+    ++b.earlyReads;
+    return 85.0f;
+  }
+  return probe->tempC;
+}
+
+float DallasTemperature::getTempCByIndex(uint8_t index) {
+  DeviceAddress address;
+  if (!getAddress(address, index)) return DEVICE_DISCONNECTED_C;
+  return getTempC(address);
+}
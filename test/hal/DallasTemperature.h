@@ -0,0 +1,57 @@
+#pragma once
+// Host stand-in for DallasTemperature over a simulated bus of DS18B20s
+// (hal::OneWireBus, one per pin). Reading a probe before its conversion
+// time has passed returns the power-on value 85 °C, as the real chip does.
+#include <Arduino.h>
+#include <vector>
+#include "OneWire.h"
+
+typedef uint8_t DeviceAddress[8];
+
+#define DEVICE_DISCONNECTED_C -127
+
+namespace hal {
+
+struct Ds18b20 {
+  uint8_t rom[8];
+  float tempC;
+  bool connected = true;
+  uint8_t resolution = 12;
+};
+
+struct OneWireBus {
+  std::vector<Ds18b20> probes;
+  uint32_t conversions = 0;
+  uint32_t reads = 0;
+  uint32_t earlyReads = 0;       // Reads before the conversion finished
+  uint32_t lastConvertMs = 0;
+  uint32_t convertingMs = 0;     // Conversion time of the last convert
+
+  static OneWireBus& onPin(uint8_t pin);
+  static void resetAll();
+};
+
+}  // namespace hal
+
+class DallasTemperature {
+public:
+  explicit DallasTemperature(OneWire* wire) : wire(wire) {}
+
+  void begin() {}
+  uint8_t getDeviceCount();
+  bool getAddress(uint8_t* address, uint8_t index);
+  void setResolution(uint8_t bits);
+  bool setResolution(const uint8_t* address, uint8_t bits);
+  void setWaitForConversion(bool wait) { waitForConversion = wait; }
+  bool getWaitForConversion() const { return waitForConversion; }
+  void requestTemperatures();
+  float getTempC(const uint8_t* address);
+  float getTempCByIndex(uint8_t index);
+  static uint16_t millisToWaitForConversion(uint8_t bits);
+
+private:
+  hal::OneWireBus& bus() { return hal::OneWireBus::onPin(wire->getPin()); }
+
+  OneWire* wire;
+  bool waitForConversion = true;
+};
@@ -0,0 +1,75 @@
+#pragma once
+// Host stand-in for the Arduino FS API, backed by a directory on the host
+// (hal::fsRoot()). Like SPIFFS, parent directories are created on demand.
+#include <Arduino.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+class File : public Stream {
+public:
+  File() {}
+
+  explicit operator bool() const { return impl != nullptr; }
+
+  using Print::write;
+  size_t write(const uint8_t* data, size_t len) override;
+  size_t read(uint8_t* data, size_t len);
+  int read() override;
+  int peek() override;
+  int available() override;
+  bool seek(uint32_t pos, SeekMode mode = SeekSet);
+  size_t position() const;
+  size_t size() const;
+  void flush() override;
+  void close();
+  const char* name() const;
+  const char* path() const;
+  bool isDirectory() const;
+  File openNextFile(const char* mode = FILE_READ);
+  // Stops at the end of the file instead of waiting out the timeout
+  String readString();
+
+  struct Impl;
+  explicit File(std::shared_ptr<Impl> impl) : impl(std::move(impl)) {}
+
+private:
+  std::shared_ptr<Impl> impl;
+};
+
+class FS {
+public:
+  File open(const char* path, const char* mode = FILE_READ, bool create = false);
+  File open(const String& path, const char* mode = FILE_READ, bool create = false) {
+    return open(path.c_str(), mode, create);
+  }
+  bool exists(const char* path);
+  bool exists(const String& path) { return exists(path.c_str()); }
+  bool remove(const char* path);
+  bool remove(const String& path) { return remove(path.c_str()); }
+  bool rename(const char* from, const char* to);
+  bool mkdir(const char* path);
+};
+
+}  // namespace fs
+
+using fs::File;
+using fs::FS;
+
+namespace hal {
+// Host directory standing in for the flash filesystem
+std::string fsRoot();
+std::string fsPath(const char* path);
+// Empties the filesystem
+void fsReset();
+// Writes after this many more bytes come up short (power cut); -1 disables
+void fsFailWritesAfter(long bytes);
+}
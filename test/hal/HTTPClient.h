@@ -0,0 +1,109 @@
+#pragma once
+// Host stand-in for the ESP32 HTTPClient. Requests are answered in-process
+// by hal::HttpServer; a request on a WiFiClient that is not connected first
+// opens it (one "handshake"), and with setReuse(true) end() leaves it open.
+#include <Arduino.h>
+#include <functional>
+#include <map>
+#include <vector>
+#include "WiFiClient.h"
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTP_CODE_OK 200
+#define HTTP_CODE_UNAUTHORIZED 401
+
+class HTTPClient {
+public:
+  HTTPClient();
+  ~HTTPClient();
+
+  bool begin(WiFiClient& client, const String& url);
+  bool begin(const String& url);
+  void end();
+  void setReuse(bool reuse) { this->reuse = reuse; }
+  void setTimeout(uint16_t) {}
+  void setConnectTimeout(int32_t) {}
+
+  void addHeader(const String& name, const String& value);
+  void collectHeaders(const char* headerKeys[], size_t count);
+  String header(const char* name);
+
+  int GET();
+  int POST(const String& payload);
+  int POST(const uint8_t* payload, size_t size);
+  String getString() { return response; }
+  int getSize() { return response.length(); }
+
+private:
+  int send(const char* method, const String& body);
+
+  WiFiClient* client = nullptr;
+  WiFiClient ownClient;
+  String url;
+  String host;
+  uint16_t port = 0;
+  bool secureScheme = false;
+  bool reuse = true;
+  std::vector<std::pair<String, String>> requestHeaders;
+  std::vector<String> wanted;
+  std::map<String, String> collected;
+  String response;
+};
+
+namespace hal {
+
+struct HttpRequest {
+  String method;
+  String url;
+  String host;
+  uint16_t port;
+  bool secure;       // Sent over a WiFiClientSecure
+  std::vector<std::pair<String, String>> headers;
+  String body;
+
+  String header(const char* name) const;
+};
+
+struct HttpResponse {
+  int code = 200;
+  String body;
+  std::vector<std::pair<String, String>> headers;
+  bool close = false;   // Server closes the connection after replying
+};
+
+// The in-process web server every fake HTTPClient talks to
+class HttpServer {
+public:
+  using Handler = std::function<HttpResponse(const HttpRequest&)>;
+
+  static HttpServer& instance();
+
+  // Resets handler, counters and open connections
+  void reset();
+  void setHandler(Handler handler);
+  // Cost of a TCP (+TLS) handshake and of one request round trip
+  void setLatency(uint32_t connectUs, uint32_t requestUs);
+  // When false, connects fail with HTTPC_ERROR_CONNECTION_REFUSED
+  void setReachable(bool reachable);
+  // Drops every open keep-alive connection (server restart, idle timeout)
+  void dropConnections();
+
+  uint32_t connectionsOpened() const;
+  uint32_t secureConnectionsOpened() const;
+  uint32_t requestCount() const;
+  std::vector<HttpRequest> requests() const;
+
+  // Used by WiFiClient/HTTPClient
+  bool connect(bool secure, uint32_t& generation);
+  bool alive(uint32_t generation) const;
+  HttpResponse handle(const HttpRequest& request);
+
+private:
+  struct State;
+  State& state();
+};
+
+}  // namespace hal
@@ -0,0 +1,30 @@
+#pragma once
+#include <Arduino.h>
+
+class IPAddress {
+public:
+  IPAddress() {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets{ a, b, c, d } {}
+
+  bool operator==(const IPAddress& o) const { return memcmp(octets, o.octets, 4) == 0; }
+  bool operator!=(const IPAddress& o) const { return !(*this == o); }
+  uint8_t operator[](int i) const { return octets[i]; }
+
+  bool fromString(const String& s) {
+    unsigned a, b, c, d;
+    if (sscanf(s.c_str(), "%u.%u.%u.%u", &a, &b, &c, &d) != 4 || a > 255 || b > 255 || c > 255 || d > 255) {
+      return false;
+    }
+    *this = IPAddress(a, b, c, d);
+    return true;
+  }
+
+  String toString() const {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+    return String(buffer);
+  }
+
+private:
+  uint8_t octets[4] = {};
+};
@@ -0,0 +1,22 @@
+#pragma once
+#include <Arduino.h>
+
+class MD5Builder {
+public:
+  void begin();
+  void add(const uint8_t* data, size_t len);
+  void add(const char* data) { add(reinterpret_cast<const uint8_t*>(data), strlen(data)); }
+  void add(const String& data) { add(reinterpret_cast<const uint8_t*>(data.c_str()), data.length()); }
+  void calculate();
+  void getBytes(uint8_t* out) const { memcpy(out, digest, 16); }
+  String toString() const;
+
+private:
+  void block(const uint8_t* chunk);
+
+  uint32_t state[4];
+  uint64_t total = 0;
+  uint8_t buffer[64];
+  size_t buffered = 0;
+  uint8_t digest[16];
+};
@@ -0,0 +1,50 @@
+#pragma once
+// In-process MQTT 3.1.1 broker on port 1883 of every host. WiFiClient
+// connects to it over a loopback connection and PubSubClient talks the
+// wire protocol to it: CONNECT/CONNACK, QoS 0/1 PUBLISH, SUBSCRIBE,
+// PINGREQ/PINGRESP and DISCONNECT. Anything malformed drops the
+// connection, as a real broker would.
+#include <Arduino.h>
+#include <memory>
+#include <vector>
+#include "WiFiClient.h"
+
+namespace hal {
+
+struct MqttPublish {
+  String topic;
+  String payload;
+  uint32_t atMs;
+};
+
+class MqttBroker : public Listener {
+public:
+  static constexpr uint16_t PORT = 1883;
+
+  static MqttBroker& instance();
+
+  // Drops every connection and clears the log and settings
+  void reset();
+  // Offline, open connections drop and a TCP connect hangs until the
+  // client's connect timeout, as for an unreachable host
+  void setOnline(bool online);
+  // The broker accepts the TCP connection but answers CONNECT this late
+  void setConnackDelay(uint32_t ms);
+
+  // TCP connects to the broker's port
+  uint32_t connectAttempts() const;
+  // Longest any connect left its caller waiting, in the TCP handshake or
+  // for the CONNACK, until it was answered or given up
+  uint32_t maxConnectBlockMs() const;
+  std::vector<MqttPublish> publishes() const;
+
+  std::shared_ptr<Connection> accept(uint32_t timeoutMs) override;
+
+private:
+  struct Session;
+  struct State;
+  State& state() const;
+  void receive(const std::shared_ptr<Session>& session, const uint8_t* data, size_t len);
+};
+
+}  // namespace hal
@@ -0,0 +1,11 @@
+#pragma once
+#include <Arduino.h>
+
+class OneWire {
+public:
+  explicit OneWire(uint8_t pin) : pin(pin) {}
+  uint8_t getPin() const { return pin; }
+
+private:
+  uint8_t pin;
+};
@@ -0,0 +1,123 @@
+#include <Preferences.h>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace {
+std::mutex nvsLock;
+std::map<std::string, std::map<std::string, std::string>> store;
+uint32_t writes = 0;
+bool failBegin = false;
+
+std::map<std::string, std::string>& space(const String& ns) {
+  return store[ns.c_str()];
+}
+}
+
+namespace hal {
+void nvsReset() {
+  std::lock_guard<std::mutex> guard(nvsLock);
+  store.clear();
+  writes = 0;
+  failBegin = false;
+}
+
+uint32_t nvsWrites() {
+  std::lock_guard<std::mutex> guard(nvsLock);
+  return writes;
+}
+
+void nvsFailBegin(bool fail) {
+  std::lock_guard<std::mutex> guard(nvsLock);
+  failBegin = fail;
+}
+}
+
+bool Preferences::begin(const char* name, bool readOnly, const char*) {
+  std::lock_guard<std::mutex> guard(nvsLock);
+  if (failBegin || !name || strlen(name) > 15) return false;
+  ns = name;
+  open = true;
+  this->readOnly = readOnly;
+  return true;
+}
+
+void Preferences::end() {
+  open = false;
+}
+
+bool Preferences::clear() {
+  std::lock_guard<std::mutex> guard(nvsLock);
+  if (!open || readOnly) return false;
+  space(ns).clear();
+  ++writes;
+  return true;
+}
+
+bool Preferences::remove(const char* key) {
+  std::lock_guard<std::mutex> guard(nvsLock);
+  if (!open || readOnly) return false;
+  ++writes;
+  return space(ns).erase(key) > 0;
+}
+
+bool Preferences::isKey(const char* key) {
+  std::lock_guard<std::mutex> guard(nvsLock);
+  return open && space(ns).count(key);
+}
+
+namespace {
+size_t put(bool open, bool readOnly, const String& ns, const char* key, const std::string& value, size_t size) {
+  std::lock_guard<std::mutex> guard(nvsLock);
+  if (!open || readOnly) return 0;
+  space(ns)[key] = value;
+  ++writes;
+  return size;
+}
+
+bool get(bool open, const String& ns, const char* key, std::string& value) {
+  std::lock_guard<std::mutex> guard(nvsLock);
+  if (!open) return false;
+  auto& s = space(ns);
+  auto it = s.find(key);
+  if (it == s.end()) return false;
+  value = it->second;
+  return true;
+}
+}
+
+size_t Preferences::putUInt(const char* key, uint32_t value) {
+  return put(open, readOnly, ns, key, std::to_string(value), 4);
+}
+
+uint32_t Preferences::getUInt(const char* key, uint32_t defaultValue) {
+  std::string v;
+  return get(open, ns, key, v) ? static_cast<uint32_t>(std::stoul(v)) : defaultValue;
+}
+
+size_t Preferences::putInt(const char* key, int32_t value) {
+  return put(open, readOnly, ns, key, std::to_string(value), 4);
+}
+
+int32_t Preferences::getInt(const char* key, int32_t defaultValue) {
+  std::string v;
+  return get(open, ns, key, v) ? static_cast<int32_t>(std::stol(v)) : defaultValue;
+}
+
+size_t Preferences::putBool(const char* key, bool value) {
+  return put(open, readOnly, ns, key, value ? "1" : "0", 1);
+}
+
+bool Preferences::getBool(const char* key, bool defaultValue) {
+  std::string v;
+  return get(open, ns, key, v) ? v == "1" : defaultValue;
+}
+
+size_t Preferences::putString(const char* key, const String& value) {
+  return put(open, readOnly, ns, key, value.c_str(), value.length());
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+  std::string v;
+  return get(open, ns, key, v) ? String(v.c_str()) : defaultValue;
+}
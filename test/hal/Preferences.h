@@ -0,0 +1,36 @@
+#pragma once
+// Host stand-in for ESP32 NVS Preferences: an in-process key/value store
+// that outlives Preferences instances, like flash outlives a reboot.
+#include <Arduino.h>
+
+class Preferences {
+public:
+  bool begin(const char* name, bool readOnly = false, const char* partitionLabel = nullptr);
+  void end();
+  bool clear();
+  bool remove(const char* key);
+  bool isKey(const char* key);
+
+  size_t putUInt(const char* key, uint32_t value);
+  uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+  size_t putInt(const char* key, int32_t value);
+  int32_t getInt(const char* key, int32_t defaultValue = 0);
+  size_t putBool(const char* key, bool value);
+  bool getBool(const char* key, bool defaultValue = false);
+  size_t putString(const char* key, const String& value);
+  String getString(const char* key, const String& defaultValue = String());
+
+private:
+  String ns;
+  bool open = false;
+  bool readOnly = false;
+};
+
+namespace hal {
+// Drops every namespace and resets the write counter
+void nvsReset();
+// Number of put*() calls that reached "flash"
+uint32_t nvsWrites();
+// While set, Preferences::begin() fails (NVS partition missing or full)
+void nvsFailBegin(bool fail);
+}
@@ -0,0 +1,113 @@
+#pragma once
+// PubSubClient 2.8 (Nick O'Leary, MIT licence), trimmed to the calls the
+// firmware makes. Packet building, buffer checks, timeouts and the
+// keepalive follow the library line for line; it runs over any Client,
+// which in host tests is a loopback WiFiClient to hal::MqttBroker.
+#include <Arduino.h>
+#include <functional>
+#include "Client.h"
+#include "IPAddress.h"
+
+#define MQTT_VERSION_3_1_1 4
+#define MQTT_VERSION MQTT_VERSION_3_1_1
+
+#define MQTT_MAX_PACKET_SIZE 256
+#define MQTT_KEEPALIVE 15
+#define MQTT_SOCKET_TIMEOUT 15
+
+#define MQTT_CONNECTION_TIMEOUT (-4)
+#define MQTT_CONNECTION_LOST (-3)
+#define MQTT_CONNECT_FAILED (-2)
+#define MQTT_DISCONNECTED (-1)
+#define MQTT_CONNECTED 0
+#define MQTT_CONNECT_BAD_PROTOCOL 1
+#define MQTT_CONNECT_BAD_CLIENT_ID 2
+#define MQTT_CONNECT_UNAVAILABLE 3
+#define MQTT_CONNECT_BAD_CREDENTIALS 4
+#define MQTT_CONNECT_UNAUTHORIZED 5
+
+#define MQTTCONNECT (1 << 4)
+#define MQTTCONNACK (2 << 4)
+#define MQTTPUBLISH (3 << 4)
+#define MQTTPUBACK (4 << 4)
+#define MQTTSUBSCRIBE (8 << 4)
+#define MQTTSUBACK (9 << 4)
+#define MQTTPINGREQ (12 << 4)
+#define MQTTPINGRESP (13 << 4)
+#define MQTTDISCONNECT (14 << 4)
+
+#define MQTTQOS0 (0 << 1)
+#define MQTTQOS1 (1 << 1)
+
+// Maximum size of fixed header and variable length size header
+#define MQTT_MAX_HEADER_SIZE 5
+
+#define MQTT_CALLBACK_SIGNATURE std::function<void(char*, uint8_t*, unsigned int)> callback
+
+class PubSubClient : public Print {
+public:
+  PubSubClient();
+  explicit PubSubClient(Client& client);
+  ~PubSubClient();
+
+  PubSubClient& setServer(IPAddress ip, uint16_t port);
+  PubSubClient& setServer(const char* domain, uint16_t port);
+  PubSubClient& setCallback(MQTT_CALLBACK_SIGNATURE);
+  PubSubClient& setClient(Client& client);
+  PubSubClient& setKeepAlive(uint16_t keepAlive);
+  PubSubClient& setSocketTimeout(uint16_t timeout);
+
+  bool setBufferSize(uint16_t size);
+  uint16_t getBufferSize();
+
+  bool connect(const char* id);
+  bool connect(const char* id, const char* user, const char* pass);
+  bool connect(const char* id, const char* user, const char* pass, const char* willTopic, uint8_t willQos,
+               bool willRetain, const char* willMessage, bool cleanSession = true);
+  void disconnect();
+
+  bool publish(const char* topic, const char* payload);
+  bool publish(const char* topic, const char* payload, bool retained);
+  bool publish(const char* topic, const uint8_t* payload, unsigned int plength);
+  bool publish(const char* topic, const uint8_t* payload, unsigned int plength, bool retained);
+
+  // Start to publish a message: the payload follows through write() and
+  // is not buffered, so it may be longer than the buffer
+  bool beginPublish(const char* topic, unsigned int plength, bool retained);
+  int endPublish();
+  size_t write(uint8_t data) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  using Print::write;
+
+  bool subscribe(const char* topic);
+  bool subscribe(const char* topic, uint8_t qos);
+  bool loop();
+  bool connected();
+  int state();
+
+private:
+  Client* _client = nullptr;
+  uint8_t* buffer = nullptr;
+  uint16_t bufferSize = 0;
+  uint16_t keepAlive = 0;
+  uint16_t socketTimeout = 0;
+  uint16_t nextMsgId = 0;
+  unsigned long lastOutActivity = 0;
+  unsigned long lastInActivity = 0;
+  bool pingOutstanding = false;
+  MQTT_CALLBACK_SIGNATURE;
+  uint32_t readPacket(uint8_t*);
+  bool readByte(uint8_t* result);
+  bool readByte(uint8_t* result, uint16_t* index);
+  bool write(uint8_t header, uint8_t* buf, uint16_t length);
+  uint16_t writeString(const char* string, uint8_t* buf, uint16_t pos);
+  // Build up the header ready to send
+  // Returns the size of the header
+  // Note: the header is built at the end of the first MQTT_MAX_HEADER_SIZE bytes, so will start
+  //       (MQTT_MAX_HEADER_SIZE - <returned size>) bytes into the buffer
+  size_t buildHeader(uint8_t header, uint8_t* buf, uint16_t length);
+  IPAddress ip;
+  const char* domain = nullptr;
+  uint16_t port = 0;
+  int _state = MQTT_DISCONNECTED;
+};
@@ -0,0 +1,94 @@
+#pragma once
+// Host stand-in for a TCP socket. It never touches the network. Ports with
+// an in-process listener (see hal::listen, e.g. hal::MqttBroker) get a
+// byte-level loopback connection; every other port "connects" to the fake
+// web server in HTTPClient.h (see hal::HttpServer), which counts
+// handshakes and can drop idle connections.
+#include <Arduino.h>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include "Client.h"
+
+// Default connect timeout of the ESP32 core's WiFiClient
+#define WIFI_CLIENT_DEF_CONN_TIMEOUT_MS (3000)
+
+namespace hal {
+
+// One in-process TCP connection. The server end runs synchronously: what
+// the client writes is handed to the receiver on the writer's thread, and
+// what the server sends becomes readable once its delivery time passes.
+class Connection {
+public:
+  using Receiver = std::function<void(Connection&, const uint8_t*, size_t)>;
+
+  explicit Connection(Receiver receiver) : receiver(std::move(receiver)) {}
+
+  // Server side
+  void send(const uint8_t* data, size_t len, uint32_t delayMs = 0);
+  void close();                 // The client sees the connection drop
+  bool closedByClient() const;
+
+  // Client side
+  size_t write(const uint8_t* data, size_t len);
+  int available();
+  int read(uint8_t* data, size_t len);
+  int peek();
+  bool open();
+  void shutdown();
+
+private:
+  mutable std::mutex mutex;
+  Receiver receiver;
+  std::deque<std::pair<uint32_t, uint8_t>> inbound;   // (deliver at ms, byte)
+  bool serverClosed = false;
+  bool clientClosed = false;
+};
+
+// Accepts in-process connections on a port
+class Listener {
+public:
+  virtual ~Listener() {}
+  // Runs the TCP handshake. Blocks for as long as the handshake takes, but
+  // no longer than timeoutMs; returns null if it fails or times out.
+  virtual std::shared_ptr<Connection> accept(uint32_t timeoutMs) = 0;
+};
+
+// Routes connects on port to listener; nullptr removes the route
+void listen(uint16_t port, Listener* listener);
+
+}  // namespace hal
+
+class WiFiClient : public Client {
+public:
+  virtual ~WiFiClient() { stop(); }
+  int connect(IPAddress ip, uint16_t port) override;
+  int connect(const char* host, uint16_t port) override {
+    return connect(host, port, WIFI_CLIENT_DEF_CONN_TIMEOUT_MS);
+  }
+  virtual int connect(const char* host, uint16_t port, int32_t timeoutMs);
+  uint8_t connected() override;
+  void stop() override;
+  operator bool() override { return connected(); }
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t size) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  int read(uint8_t* buf, size_t size) override;
+  int peek() override;
+  void flush() override {}
+
+  virtual bool isSecure() const { return false; }
+  const String& remoteHost() const { return host; }
+  uint16_t remotePort() const { return port; }
+
+private:
+  String host;
+  uint16_t port = 0;
+  uint32_t generation = 0;    // Web server generation the socket was opened in
+  bool open = false;
+  std::shared_ptr<hal::Connection> link;   // Set when a listener accepted
+};
@@ -0,0 +1,18 @@
+#pragma once
+#include "WiFiClient.h"
+
+class WiFiClientSecure : public WiFiClient {
+public:
+  void setCACert(const char* rootCA) { caCert = rootCA; insecure = false; }
+  void setInsecure() { insecure = true; caCert = nullptr; }
+  bool isSecure() const override { return true; }
+  using WiFiClient::connect;
+  // Like the core, the handshake fails with neither a CA nor setInsecure()
+  int connect(const char* host, uint16_t port, int32_t timeoutMs) override {
+    if (!caCert && !insecure) return 0;
+    return WiFiClient::connect(host, port, timeoutMs);
+  }
+
+  const char* caCert = nullptr;
+  bool insecure = false;
+};
@@ -0,0 +1,54 @@
+#include <Wire.h>
+
+TwoWire Wire(0);
+TwoWire Wire1(1);
+
+bool TwoWire::begin(int sda, int scl, uint32_t) {
+  sdaPin = sda;
+  sclPin = scl;
+  started = true;
+  return true;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  txAddress = address;
+  tx.clear();
+}
+
+size_t TwoWire::write(uint8_t value) {
+  tx.push_back(value);
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t len) {
+  tx.insert(tx.end(), data, data + len);
+  return len;
+}
+
+// 0 success, 2 NACK on address, as in the Arduino API
+uint8_t TwoWire::endTransmission(bool) {
+  auto it = devices.find(txAddress);
+  if (!started || it == devices.end()) return 2;
+  return it->second->write(tx.data(), tx.size()) ? 0 : 3;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t len, bool) {
+  rx.clear();
+  rxPos = 0;
+  auto it = devices.find(address);
+  if (!started || it == devices.end()) return 0;
+  rx.resize(len);
+  if (!it->second->read(rx.data(), len)) {
+    rx.clear();
+    return 0;
+  }
+  return len;
+}
+
+int TwoWire::available() {
+  return static_cast<int>(rx.size() - rxPos);
+}
+
+int TwoWire::read() {
+  return rxPos < rx.size() ? rx[rxPos++] : -1;
+}
@@ -0,0 +1,83 @@
+#pragma once
+// Host stand-in for the ESP32 TwoWire controller. Devices are simulated by
+// attaching hal::I2cDevice objects at 7-bit addresses.
+#include <Arduino.h>
+#include <map>
+#include <vector>
+
+namespace hal {
+
+class I2cDevice {
+public:
+  virtual ~I2cDevice() {}
+  // A write transaction: first byte is normally the register pointer
+  virtual bool write(const uint8_t* data, size_t len) = 0;
+  // A read transaction continuing from the register pointer
+  virtual bool read(uint8_t* out, size_t len) = 0;
+};
+
+// 256 auto-incrementing 8-bit registers; the common case
+class RegisterDevice : public I2cDevice {
+public:
+  uint8_t regs[256] = {};
+  uint8_t pointer = 0;
+  std::vector<std::pair<uint8_t, uint8_t>> writes;   // (register, value)
+
+  bool write(const uint8_t* data, size_t len) override {
+    if (len == 0) return true;
+    pointer = data[0];
+    for (size_t i = 1; i < len; ++i) {
+      writes.push_back({ pointer, data[i] });
+      onWrite(pointer, data[i]);
+      regs[pointer++] = data[i];
+    }
+    return true;
+  }
+
+  bool read(uint8_t* out, size_t len) override {
+    for (size_t i = 0; i < len; ++i) out[i] = regs[pointer++];
+    return true;
+  }
+
+protected:
+  virtual void onWrite(uint8_t, uint8_t) {}
+};
+
+}  // namespace hal
+
+class TwoWire {
+public:
+  explicit TwoWire(uint8_t busNum) : busNum(busNum) {}
+
+  bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+  void setClock(uint32_t) {}
+
+  void beginTransmission(uint8_t address);
+  size_t write(uint8_t value);
+  size_t write(const uint8_t* data, size_t len);
+  uint8_t endTransmission(bool sendStop = true);
+  uint8_t requestFrom(uint8_t address, uint8_t len, bool sendStop = true);
+  int available();
+  int read();
+
+  // Test hooks
+  void attach(uint8_t address, hal::I2cDevice* device) { devices[address] = device; }
+  void detachAll() { devices.clear(); started = false; }
+  bool isStarted() const { return started; }
+  int sda() const { return sdaPin; }
+  int scl() const { return sclPin; }
+
+private:
+  uint8_t busNum;
+  bool started = false;
+  int sdaPin = -1;
+  int sclPin = -1;
+  uint8_t txAddress = 0;
+  std::vector<uint8_t> tx;
+  std::vector<uint8_t> rx;
+  size_t rxPos = 0;
+  std::map<uint8_t, hal::I2cDevice*> devices;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
@@ -0,0 +1,381 @@
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/timers.h>
+#include <Arduino.h>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// True when waited until deadline; portMAX_DELAY waits forever
+template<typename Pred>
+bool waitFor(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, TickType_t ticks, Pred pred) {
+  if (ticks == portMAX_DELAY) {
+    cv.wait(lock, pred);
+    return true;
+  }
+  return cv.wait_for(lock, std::chrono::milliseconds(ticks), pred);
+}
+
+struct TaskExit {};
+
+}  // namespace
+
+// ─────────────────────────────────────────────────────────────
+// Tasks
+// ─────────────────────────────────────────────────────────────
+
+struct HalTask {
+  std::string name;
+  std::mutex mutex;
+  std::condition_variable cv;
+  uint32_t notifications = 0;
+};
+
+namespace {
+thread_local HalTask* currentTask = nullptr;
+
+// Threads that are not FreeRTOS tasks (the test's main thread) still need
+// a handle for notifications
+HalTask* self() {
+  if (!currentTask) {
+    currentTask = new HalTask();
+    currentTask->name = "main";
+  }
+  return currentTask;
+}
+}
+
+TickType_t xTaskGetTickCount() {
+  return static_cast<TickType_t>(millis());
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t, void* param,
+                                   UBaseType_t, TaskHandle_t* handle, BaseType_t) {
+  HalTask* task = new HalTask();
+  task->name = name ? name : "";
+  if (handle) *handle = task;
+
+  std::thread([fn, param, task] {
+    currentTask = task;
+    try {
+      fn(param);
+    } catch (const TaskExit&) {
+    }
+  }).detach();
+  return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stackDepth, void* param,
+                       UBaseType_t priority, TaskHandle_t* handle) {
+  return xTaskCreatePinnedToCore(fn, name, stackDepth, param, priority, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+  if (!task || task == currentTask) throw TaskExit();
+}
+
+void vTaskDelay(TickType_t ticks) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t period) {
+  *previousWake += period;
+  TickType_t remaining = *previousWake - xTaskGetTickCount();
+  if (remaining <= period) vTaskDelay(remaining);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  return self();
+}
+
+const char* pcTaskGetName(TaskHandle_t task) {
+  return (task ? task : self())->name.c_str();
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) {
+  return 1024;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait) {
+  HalTask* task = self();
+  std::unique_lock<std::mutex> lock(task->mutex);
+  waitFor(task->cv, lock, ticksToWait, [task] { return task->notifications > 0; });
+  uint32_t value = task->notifications;
+  if (value) task->notifications = clearOnExit ? 0 : value - 1;
+  return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  {
+    std::lock_guard<std::mutex> lock(task->mutex);
+    ++task->notifications;
+  }
+  task->cv.notify_all();
+  return pdPASS;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Queues and semaphores
+// ─────────────────────────────────────────────────────────────
+
+// Storage is allocated once at creation, as in FreeRTOS, so sends and
+// receives never touch the heap
+struct HalQueue {
+  std::mutex mutex;
+  std::condition_variable changed;
+  UBaseType_t length;
+  UBaseType_t itemSize;
+  std::vector<uint8_t> storage;
+  UBaseType_t head = 0;
+  UBaseType_t count = 0;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  if (length == 0) return nullptr;
+  HalQueue* queue = new HalQueue();
+  queue->length = length;
+  queue->itemSize = itemSize;
+  queue->storage.resize(static_cast<size_t>(length) * itemSize);
+  return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+  delete queue;
+}
+
+namespace {
+uint8_t* slot(HalQueue* q, UBaseType_t index) {
+  return q->storage.data() + static_cast<size_t>((q->head + index) % q->length) * q->itemSize;
+}
+
+BaseType_t send(QueueHandle_t q, const void* item, TickType_t ticks, bool front) {
+  if (!q) return pdFAIL;
+  std::unique_lock<std::mutex> lock(q->mutex);
+  if (!waitFor(q->changed, lock, ticks, [q] { return q->count < q->length; })) return errQUEUE_FULL;
+  if (front) {
+    q->head = (q->head + q->length - 1) % q->length;
+    if (q->itemSize) memcpy(slot(q, 0), item, q->itemSize);
+  } else if (q->itemSize) {
+    memcpy(slot(q, q->count), item, q->itemSize);
+  }
+  ++q->count;
+  lock.unlock();
+  q->changed.notify_all();
+  return pdPASS;
+}
+
+BaseType_t receive(QueueHandle_t q, void* item, TickType_t ticks, bool remove) {
+  if (!q) return pdFAIL;
+  std::unique_lock<std::mutex> lock(q->mutex);
+  if (!waitFor(q->changed, lock, ticks, [q] { return q->count > 0; })) return pdFAIL;
+  if (q->itemSize) memcpy(item, slot(q, 0), q->itemSize);
+  if (remove) {
+    q->head = (q->head + 1) % q->length;
+    --q->count;
+  }
+  lock.unlock();
+  if (remove) q->changed.notify_all();
+  return pdPASS;
+}
+}  // namespace
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks) {
+  return send(queue, item, ticks, false);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticks) {
+  return send(queue, item, ticks, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void* item, TickType_t ticks) {
+  return send(queue, item, ticks, true);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks) {
+  return receive(queue, item, ticks, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticks) {
+  return receive(queue, item, ticks, false);
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+  {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    queue->head = 0;
+    queue->count = 0;
+  }
+  queue->changed.notify_all();
+  return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  return queue->count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue) {
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  return queue->length - queue->count;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+  SemaphoreHandle_t s = xQueueCreate(1, 0);
+  s->count = 1;
+  return s;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+  return xQueueCreate(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount) {
+  SemaphoreHandle_t s = xQueueCreate(maxCount, 0);
+  if (s) s->count = initialCount;
+  return s;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+  return receive(semaphore, nullptr, ticks, true);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+  return send(semaphore, nullptr, 0, false);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+  vQueueDelete(semaphore);
+}
+
+// ─────────────────────────────────────────────────────────────
+// Software timers, serviced by one daemon thread
+// ─────────────────────────────────────────────────────────────
+
+struct HalTimer {
+  std::string name;
+  TickType_t period;
+  bool autoReload;
+  void* id;
+  TimerCallbackFunction_t callback;
+  bool active = false;
+  Clock::time_point due;
+};
+
+namespace {
+struct TimerService {
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::vector<HalTimer*> timers;
+
+  TimerService() {
+    std::thread([this] { run(); }).detach();
+  }
+
+  void run() {
+    currentTask = new HalTask();
+    currentTask->name = "Tmr Svc";
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+      HalTimer* next = nullptr;
+      for (HalTimer* t : timers) {
+        if (t->active && (!next || t->due < next->due)) next = t;
+      }
+      if (!next) {
+        changed.wait(lock);
+        continue;
+      }
+      if (Clock::now() < next->due) {
+        changed.wait_until(lock, next->due);
+        continue;
+      }
+      if (next->autoReload) {
+        next->due += std::chrono::milliseconds(next->period);
+      } else {
+        next->active = false;
+      }
+      lock.unlock();
+      next->callback(next);
+      lock.lock();
+    }
+  }
+
+  void arm(HalTimer* timer, bool active) {
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      timer->active = active;
+      if (active) timer->due = Clock::now() + std::chrono::milliseconds(timer->period);
+    }
+    changed.notify_all();
+  }
+};
+
+TimerService& timerService() {
+  static TimerService* service = new TimerService();
+  return *service;
+}
+}  // namespace
+
+TimerHandle_t xTimerCreate(const char* name, TickType_t period, UBaseType_t autoReload, void* id,
+                           TimerCallbackFunction_t callback) {
+  if (period == 0 || !callback) return nullptr;
+  HalTimer* timer = new HalTimer{ name ? name : "", period, autoReload != pdFALSE, id, callback };
+  TimerService& service = timerService();
+  std::lock_guard<std::mutex> guard(service.mutex);
+  service.timers.push_back(timer);
+  return timer;
+}
+
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t) {
+  if (!timer) return pdFAIL;
+  timerService().arm(timer, true);
+  return pdPASS;
+}
+
+BaseType_t xTimerReset(TimerHandle_t timer, TickType_t ticks) {
+  return xTimerStart(timer, ticks);
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t) {
+  if (!timer) return pdFAIL;
+  timerService().arm(timer, false);
+  return pdPASS;
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t ticks) {
+  if (!timer || period == 0) return pdFAIL;
+  {
+    std::lock_guard<std::mutex> guard(timerService().mutex);
+    timer->period = period;
+  }
+  return xTimerStart(timer, ticks);
+}
+
+BaseType_t xTimerDelete(TimerHandle_t timer, TickType_t) {
+  if (!timer) return pdFAIL;
+  TimerService& service = timerService();
+  {
+    std::lock_guard<std::mutex> guard(service.mutex);
+    timer->active = false;
+    // Kept allocated: a callback may still be running with this handle
+  }
+  service.changed.notify_all();
+  return pdPASS;
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer) {
+  std::lock_guard<std::mutex> guard(timerService().mutex);
+  return timer && timer->active ? pdTRUE : pdFALSE;
+}
+
+void* pvTimerGetTimerID(TimerHandle_t timer) {
+  return timer ? timer->id : nullptr;
+}
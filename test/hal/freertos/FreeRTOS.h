@@ -0,0 +1,38 @@
+#pragma once
+// Host stand-in for ESP-IDF FreeRTOS: tasks are std::threads, queues and
+// semaphores are mutex/condition-variable objects, one tick is 1 ms.
+#include <stdint.h>
+#include <stddef.h>
+#include <mutex>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL 0
+#define pdPASS 1
+#define errQUEUE_FULL 0
+#define portMAX_DELAY 0xFFFFFFFFu
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) (static_cast<TickType_t>(ms))
+#define tskIDLE_PRIORITY 0
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+// Spinlock stand-in; portENTER_CRITICAL does not nest on the host
+struct portMUX_TYPE {
+  portMUX_TYPE() {}
+  portMUX_TYPE(const portMUX_TYPE&) {}
+  portMUX_TYPE& operator=(const portMUX_TYPE&) { return *this; }
+  std::mutex mutex;
+};
+
+#define portMUX_INITIALIZER_UNLOCKED {}
+#define portENTER_CRITICAL(mux) ((mux)->mutex.lock())
+#define portEXIT_CRITICAL(mux) ((mux)->mutex.unlock())
+#define taskENTER_CRITICAL(mux) portENTER_CRITICAL(mux)
+#define taskEXIT_CRITICAL(mux) portEXIT_CRITICAL(mux)
+
+TickType_t xTaskGetTickCount();
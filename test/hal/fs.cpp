@@ -0,0 +1,237 @@
+#include <FS.h>
+#include <SPIFFS.h>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <unistd.h>
+
+namespace stdfs = std::filesystem;
+
+fs::SPIFFSFS SPIFFS;
+
+namespace {
+std::mutex fsLock;
+long failAfter = -1;
+
+stdfs::path hostPath(const char* path) {
+  std::string p = path ? path : "/";
+  while (!p.empty() && p[0] == '/') p.erase(0, 1);
+  return stdfs::path(hal::fsRoot()) / p;
+}
+}
+
+namespace hal {
+std::string fsRoot() {
+  static std::string root = [] {
+    stdfs::path dir = stdfs::temp_directory_path() / ("logicgard-fs-" + std::to_string(getpid()));
+    stdfs::create_directories(dir);
+    return dir.string();
+  }();
+  return root;
+}
+
+std::string fsPath(const char* path) {
+  return hostPath(path).string();
+}
+
+void fsReset() {
+  std::lock_guard<std::mutex> guard(fsLock);
+  stdfs::remove_all(fsRoot());
+  stdfs::create_directories(fsRoot());
+  failAfter = -1;
+}
+
+void fsFailWritesAfter(long bytes) {
+  std::lock_guard<std::mutex> guard(fsLock);
+  failAfter = bytes;
+}
+}  // namespace hal
+
+struct fs::File::Impl {
+  std::string path;          // Firmware-side path
+  std::string name;
+  stdfs::path host;
+  bool directory = false;
+  std::vector<std::string> entries;
+  size_t nextEntry = 0;
+  std::fstream stream;
+  bool writable = false;
+};
+
+size_t fs::File::write(const uint8_t* data, size_t len) {
+  if (!impl || !impl->writable) return 0;
+  std::lock_guard<std::mutex> guard(fsLock);
+  if (failAfter >= 0) {
+    size_t allowed = std::min<size_t>(len, static_cast<size_t>(failAfter));
+    failAfter -= allowed;
+    len = allowed;
+  }
+  impl->stream.write(reinterpret_cast<const char*>(data), len);
+  impl->stream.flush();
+  return impl->stream ? len : 0;
+}
+
+size_t fs::File::read(uint8_t* data, size_t len) {
+  if (!impl || impl->directory) return 0;
+  impl->stream.read(reinterpret_cast<char*>(data), len);
+  size_t got = static_cast<size_t>(impl->stream.gcount());
+  if (!impl->stream) impl->stream.clear();
+  return got;
+}
+
+int fs::File::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int fs::File::peek() {
+  if (!impl || impl->directory) return -1;
+  int c = impl->stream.peek();
+  if (c == std::char_traits<char>::eof()) {
+    impl->stream.clear();
+    return -1;
+  }
+  return c;
+}
+
+int fs::File::available() {
+  if (!impl || impl->directory) return 0;
+  return static_cast<int>(size() - position());
+}
+
+bool fs::File::seek(uint32_t pos, SeekMode mode) {
+  if (!impl || impl->directory) return false;
+  size_t target = mode == SeekSet ? pos : mode == SeekCur ? position() + pos : size() + pos;
+  if (target > size()) return false;
+  impl->stream.clear();
+  impl->stream.seekg(target);
+  impl->stream.seekp(target);
+  return static_cast<bool>(impl->stream);
+}
+
+size_t fs::File::position() const {
+  if (!impl || impl->directory) return 0;
+  auto pos = impl->stream.tellg();
+  return pos < 0 ? 0 : static_cast<size_t>(pos);
+}
+
+size_t fs::File::size() const {
+  if (!impl || impl->directory) return 0;
+  std::error_code ec;
+  auto bytes = stdfs::file_size(impl->host, ec);
+  return ec ? 0 : static_cast<size_t>(bytes);
+}
+
+void fs::File::flush() {
+  if (impl && impl->writable) impl->stream.flush();
+}
+
+void fs::File::close() {
+  impl.reset();
+}
+
+const char* fs::File::name() const {
+  return impl ? impl->name.c_str() : "";
+}
+
+const char* fs::File::path() const {
+  return impl ? impl->path.c_str() : "";
+}
+
+bool fs::File::isDirectory() const {
+  return impl && impl->directory;
+}
+
+fs::File fs::File::openNextFile(const char* mode) {
+  if (!impl || !impl->directory || impl->nextEntry >= impl->entries.size()) return File();
+  std::string child = impl->path;
+  if (child.empty() || child.back() != '/') child += '/';
+  child += impl->entries[impl->nextEntry++];
+  return SPIFFS.open(child.c_str(), mode);
+}
+
+String fs::File::readString() {
+  String out;
+  int c;
+  while ((c = read()) >= 0) out += static_cast<char>(c);
+  return out;
+}
+
+fs::File fs::FS::open(const char* path, const char* mode, bool) {
+  auto impl = std::make_shared<File::Impl>();
+  impl->path = path;
+  impl->host = hostPath(path);
+  std::string p(path);
+  impl->name = p.substr(p.find_last_of('/') + 1);
+
+  std::error_code ec;
+  if (stdfs::is_directory(impl->host, ec)) {
+    impl->directory = true;
+    for (const auto& entry : stdfs::directory_iterator(impl->host)) {
+      impl->entries.push_back(entry.path().filename().string());
+    }
+    std::sort(impl->entries.begin(), impl->entries.end());
+    return File(impl);
+  }
+
+  std::string m(mode);
+  std::ios::openmode flags = std::ios::binary;
+  if (m == FILE_READ) {
+    if (!stdfs::exists(impl->host)) return File();
+    flags |= std::ios::in;
+  } else {
+    stdfs::create_directories(impl->host.parent_path());
+    flags |= std::ios::in | std::ios::out | (m == FILE_APPEND ? std::ios::app : std::ios::trunc);
+    impl->writable = true;
+    if (m == FILE_APPEND && !stdfs::exists(impl->host)) {
+      std::ofstream(impl->host, std::ios::binary);
+    }
+  }
+
+  impl->stream.open(impl->host, flags);
+  if (!impl->stream) return File();
+  return File(impl);
+}
+
+bool fs::FS::exists(const char* path) {
+  return stdfs::exists(hostPath(path));
+}
+
+bool fs::FS::remove(const char* path) {
+  std::error_code ec;
+  return stdfs::remove(hostPath(path), ec);
+}
+
+bool fs::FS::rename(const char* from, const char* to) {
+  std::error_code ec;
+  stdfs::rename(hostPath(from), hostPath(to), ec);
+  return !ec;
+}
+
+bool fs::FS::mkdir(const char* path) {
+  std::error_code ec;
+  stdfs::create_directories(hostPath(path), ec);
+  return !ec;
+}
+
+bool fs::SPIFFSFS::begin(bool, const char*, uint8_t, const char*) {
+  hal::fsRoot();
+  return true;
+}
+
+bool fs::SPIFFSFS::format() {
+  hal::fsReset();
+  return true;
+}
+
+size_t fs::SPIFFSFS::totalBytes() {
+  return 1024 * 1024;
+}
+
+size_t fs::SPIFFSFS::usedBytes() {
+  size_t used = 0;
+  for (const auto& entry : stdfs::recursive_directory_iterator(hal::fsRoot())) {
+    if (entry.is_regular_file()) used += entry.file_size();
+  }
+  return used;
+}
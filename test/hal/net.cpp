@@ -0,0 +1,651 @@
+#include <HTTPClient.h>
+#include <MqttBroker.h>
+#include <WiFiClient.h>
+#include <map>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace {
+void spin(uint32_t us) {
+  if (us) std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+}
+
+// ─────────────────────────────────────────────────────────────
+// Web server
+// ─────────────────────────────────────────────────────────────
+
+struct hal::HttpServer::State {
+  mutable std::mutex mutex;
+  Handler handler;
+  uint32_t connectUs = 0;
+  uint32_t requestUs = 0;
+  bool reachable = true;
+  uint32_t generation = 1;
+  uint32_t opened = 0;
+  uint32_t secureOpened = 0;
+  std::vector<HttpRequest> log;
+};
+
+hal::HttpServer& hal::HttpServer::instance() {
+  static HttpServer server;
+  return server;
+}
+
+hal::HttpServer::State& hal::HttpServer::state() {
+  static State* s = new State();
+  return *s;
+}
+
+void hal::HttpServer::reset() {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  s.handler = nullptr;
+  s.connectUs = s.requestUs = 0;
+  s.reachable = true;
+  ++s.generation;
+  s.opened = s.secureOpened = 0;
+  s.log.clear();
+}
+
+void hal::HttpServer::setHandler(Handler handler) {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  s.handler = std::move(handler);
+}
+
+void hal::HttpServer::setLatency(uint32_t connectUs, uint32_t requestUs) {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  s.connectUs = connectUs;
+  s.requestUs = requestUs;
+}
+
+void hal::HttpServer::setReachable(bool reachable) {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  s.reachable = reachable;
+}
+
+void hal::HttpServer::dropConnections() {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  ++s.generation;
+}
+
+uint32_t hal::HttpServer::connectionsOpened() const {
+  State& s = const_cast<HttpServer*>(this)->state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  return s.opened;
+}
+
+uint32_t hal::HttpServer::secureConnectionsOpened() const {
+  State& s = const_cast<HttpServer*>(this)->state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  return s.secureOpened;
+}
+
+uint32_t hal::HttpServer::requestCount() const {
+  State& s = const_cast<HttpServer*>(this)->state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  return static_cast<uint32_t>(s.log.size());
+}
+
+std::vector<hal::HttpRequest> hal::HttpServer::requests() const {
+  State& s = const_cast<HttpServer*>(this)->state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  return s.log;
+}
+
+bool hal::HttpServer::connect(bool secure, uint32_t& generation) {
+  State& s = state();
+  uint32_t cost;
+  {
+    std::lock_guard<std::mutex> guard(s.mutex);
+    if (!s.reachable) return false;
+    ++s.opened;
+    if (secure) ++s.secureOpened;
+    generation = s.generation;
+    cost = s.connectUs;
+  }
+  spin(cost);
+  return true;
+}
+
+bool hal::HttpServer::alive(uint32_t generation) const {
+  State& s = const_cast<HttpServer*>(this)->state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  return s.reachable && generation == s.generation;
+}
+
+hal::HttpResponse hal::HttpServer::handle(const HttpRequest& request) {
+  State& s = state();
+  Handler handler;
+  uint32_t cost;
+  {
+    std::lock_guard<std::mutex> guard(s.mutex);
+    s.log.push_back(request);
+    handler = s.handler;
+    cost = s.requestUs;
+  }
+  spin(cost);
+  if (!handler) return HttpResponse();
+  return handler(request);
+}
+
+String hal::HttpRequest::header(const char* name) const {
+  for (const auto& h : headers) {
+    if (h.first.equalsIgnoreCase(name)) return h.second;
+  }
+  return String();
+}
+
+// ─────────────────────────────────────────────────────────────
+// Loopback connections / WiFiClient
+// ─────────────────────────────────────────────────────────────
+
+namespace {
+std::mutex routeLock;
+
+std::map<uint16_t, hal::Listener*>& routes() {
+  static auto* table = new std::map<uint16_t, hal::Listener*>();
+  return *table;
+}
+
+hal::Listener* route(uint16_t port) {
+  std::lock_guard<std::mutex> guard(routeLock);
+  auto it = routes().find(port);
+  return it == routes().end() ? nullptr : it->second;
+}
+}
+
+void hal::listen(uint16_t port, Listener* listener) {
+  std::lock_guard<std::mutex> guard(routeLock);
+  if (listener) {
+    routes()[port] = listener;
+  } else {
+    routes().erase(port);
+  }
+}
+
+void hal::Connection::send(const uint8_t* data, size_t len, uint32_t delayMs) {
+  std::lock_guard<std::mutex> guard(mutex);
+  if (serverClosed || clientClosed) return;
+  // Later bytes never overtake earlier ones
+  uint32_t at = millis() + delayMs;
+  if (!inbound.empty() && static_cast<int32_t>(inbound.back().first - at) > 0) at = inbound.back().first;
+  for (size_t i = 0; i < len; ++i) inbound.push_back({ at, data[i] });
+}
+
+void hal::Connection::close() {
+  std::lock_guard<std::mutex> guard(mutex);
+  serverClosed = true;
+}
+
+bool hal::Connection::closedByClient() const {
+  std::lock_guard<std::mutex> guard(mutex);
+  return clientClosed;
+}
+
+size_t hal::Connection::write(const uint8_t* data, size_t len) {
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    if (serverClosed || clientClosed) return 0;
+  }
+  receiver(*this, data, len);
+  return len;
+}
+
+int hal::Connection::available() {
+  std::lock_guard<std::mutex> guard(mutex);
+  uint32_t now = millis();
+  int count = 0;
+  for (const auto& byte : inbound) {
+    if (static_cast<int32_t>(now - byte.first) < 0) break;
+    ++count;
+  }
+  return count;
+}
+
+int hal::Connection::read(uint8_t* data, size_t len) {
+  std::lock_guard<std::mutex> guard(mutex);
+  uint32_t now = millis();
+  size_t count = 0;
+  while (count < len && !inbound.empty() && static_cast<int32_t>(now - inbound.front().first) >= 0) {
+    data[count++] = inbound.front().second;
+    inbound.pop_front();
+  }
+  return static_cast<int>(count);
+}
+
+int hal::Connection::peek() {
+  std::lock_guard<std::mutex> guard(mutex);
+  if (inbound.empty() || static_cast<int32_t>(millis() - inbound.front().first) < 0) return -1;
+  return inbound.front().second;
+}
+
+bool hal::Connection::open() {
+  std::lock_guard<std::mutex> guard(mutex);
+  return !serverClosed && !clientClosed;
+}
+
+void hal::Connection::shutdown() {
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    if (clientClosed) return;
+    clientClosed = true;
+    inbound.clear();
+  }
+  receiver(*this, nullptr, 0);
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) {
+  return connect(ip.toString().c_str(), port);
+}
+
+int WiFiClient::connect(const char* host, uint16_t port, int32_t timeoutMs) {
+  stop();
+  if (hal::Listener* listener = route(port)) {
+    link = listener->accept(static_cast<uint32_t>(std::max<int32_t>(timeoutMs, 0)));
+    if (!link) return 0;
+  } else if (!hal::HttpServer::instance().connect(isSecure(), generation)) {
+    return 0;
+  }
+  this->host = host;
+  this->port = port;
+  open = true;
+  return 1;
+}
+
+uint8_t WiFiClient::connected() {
+  if (!open) return 0;
+  if (link) {
+    // Like the core, a socket the peer closed reads as connected until drained
+    if (!link->open() && link->available() == 0) open = false;
+  } else if (!hal::HttpServer::instance().alive(generation)) {
+    open = false;
+  }
+  return open;
+}
+
+void WiFiClient::stop() {
+  if (link) {
+    link->shutdown();
+    link.reset();
+  }
+  open = false;
+}
+
+size_t WiFiClient::write(const uint8_t* buf, size_t size) {
+  if (!open) return 0;
+  // Requests to hal::HttpServer go through HTTPClient, not the socket
+  return link ? link->write(buf, size) : size;
+}
+
+int WiFiClient::available() {
+  return link ? link->available() : 0;
+}
+
+int WiFiClient::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t* buf, size_t size) {
+  if (!link) return -1;
+  int count = link->read(buf, size);
+  return count > 0 ? count : -1;
+}
+
+int WiFiClient::peek() {
+  return link ? link->peek() : -1;
+}
+
+HTTPClient::HTTPClient() {}
+HTTPClient::~HTTPClient() {}
+
+bool HTTPClient::begin(WiFiClient& client, const String& url) {
+  this->client = &client;
+  this->url = url;
+  requestHeaders.clear();
+  collected.clear();
+  response = String();
+
+  int scheme = url.indexOf("://");
+  if (scheme < 0) return false;
+  secureScheme = url.substring(0, scheme) == "https";
+  String rest = url.substring(scheme + 3);
+  int slash = rest.indexOf('/');
+  String hostPort = slash >= 0 ? rest.substring(0, slash) : rest;
+  int colon = hostPort.indexOf(':');
+  host = colon >= 0 ? hostPort.substring(0, colon) : hostPort;
+  port = colon >= 0 ? static_cast<uint16_t>(hostPort.substring(colon + 1).toInt()) : (secureScheme ? 443 : 80);
+  return true;
+}
+
+bool HTTPClient::begin(const String& url) {
+  return begin(ownClient, url);
+}
+
+void HTTPClient::end() {
+  if (!reuse && client) client->stop();
+  client = nullptr;
+}
+
+void HTTPClient::addHeader(const String& name, const String& value) {
+  requestHeaders.push_back({ name, value });
+}
+
+void HTTPClient::collectHeaders(const char* headerKeys[], size_t count) {
+  wanted.clear();
+  for (size_t i = 0; i < count; ++i) wanted.push_back(headerKeys[i]);
+}
+
+String HTTPClient::header(const char* name) {
+  for (const auto& kv : collected) {
+    if (kv.first.equalsIgnoreCase(name)) return kv.second;
+  }
+  return String();
+}
+
+int HTTPClient::GET() {
+  return send("GET", String());
+}
+
+int HTTPClient::POST(const String& payload) {
+  return send("POST", payload);
+}
+
+int HTTPClient::POST(const uint8_t* payload, size_t size) {
+  String body;
+  body.concat(reinterpret_cast<const char*>(payload), size);
+  return send("POST", body);
+}
+
+int HTTPClient::send(const char* method, const String& body) {
+  collected.clear();
+  response = String();
+  if (!client) return HTTPC_ERROR_NOT_CONNECTED;
+
+  // A plain socket cannot speak TLS: the handshake fails, as on the device
+  if (secureScheme && !client->isSecure()) {
+    client->stop();
+    return HTTPC_ERROR_CONNECTION_REFUSED;
+  }
+
+  bool reusable = client->connected() && client->remoteHost() == host && client->remotePort() == port;
+  if (!reusable && !client->connect(host.c_str(), port)) {
+    return HTTPC_ERROR_CONNECTION_REFUSED;
+  }
+
+  hal::HttpRequest request{ method, url, host, port, client->isSecure(), requestHeaders, body };
+  hal::HttpResponse reply = hal::HttpServer::instance().handle(request);
+
+  for (const auto& h : reply.headers) {
+    for (const String& w : wanted) {
+      if (h.first.equalsIgnoreCase(w)) collected[w] = h.second;
+    }
+  }
+  response = reply.body;
+  if (reply.close || !reuse) client->stop();
+  return reply.code;
+}
+
+// ─────────────────────────────────────────────────────────────
+// MQTT broker
+// ─────────────────────────────────────────────────────────────
+
+struct hal::MqttBroker::Session {
+  std::shared_ptr<Connection> connection;
+  std::vector<uint8_t> rx;
+  bool connected = false;      // CONNECT accepted
+  uint32_t startMs = 0;
+  uint32_t connackDueMs = 0;
+  bool closed = false;
+  uint32_t closedMs = 0;
+
+  // How long the client's connect() waited on this session
+  uint32_t blockedMs(uint32_t now) const {
+    uint32_t end = closed ? closedMs : now;
+    if (connected && static_cast<int32_t>(connackDueMs - end) < 0) end = connackDueMs;
+    return end - startMs;
+  }
+};
+
+struct hal::MqttBroker::State {
+  mutable std::mutex mutex;
+  bool online = true;
+  uint32_t connackDelayMs = 0;
+  uint32_t attempts = 0;
+  uint32_t maxRefusedMs = 0;
+  std::vector<std::shared_ptr<Session>> sessions;
+  std::vector<MqttPublish> log;
+
+  void drop(Session& session) {
+    session.connection->close();
+    if (!session.closed) {
+      session.closed = true;
+      session.closedMs = millis();
+    }
+  }
+};
+
+namespace {
+// Reads a length-prefixed MQTT string at pos
+bool readMqttString(const std::vector<uint8_t>& body, size_t& pos, String& out) {
+  if (pos + 2 > body.size()) return false;
+  size_t len = (body[pos] << 8) | body[pos + 1];
+  pos += 2;
+  if (pos + len > body.size()) return false;
+  out = String(reinterpret_cast<const char*>(body.data() + pos), static_cast<unsigned int>(len));
+  pos += len;
+  return true;
+}
+
+// Registered at start-up so connects to the port reach the broker even
+// before a test first touches it
+const bool brokerListening = (hal::MqttBroker::instance(), true);
+}
+
+hal::MqttBroker& hal::MqttBroker::instance() {
+  static MqttBroker* broker = [] {
+    MqttBroker* b = new MqttBroker();
+    hal::listen(PORT, b);
+    return b;
+  }();
+  return *broker;
+}
+
+hal::MqttBroker::State& hal::MqttBroker::state() const {
+  static State* s = new State();
+  return *s;
+}
+
+void hal::MqttBroker::reset() {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  for (auto& session : s.sessions) s.drop(*session);
+  s.sessions.clear();
+  s.online = true;
+  s.connackDelayMs = 0;
+  s.attempts = 0;
+  s.maxRefusedMs = 0;
+  s.log.clear();
+}
+
+void hal::MqttBroker::setOnline(bool online) {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  s.online = online;
+  if (!online) {
+    for (auto& session : s.sessions) s.drop(*session);
+  }
+}
+
+void hal::MqttBroker::setConnackDelay(uint32_t ms) {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  s.connackDelayMs = ms;
+}
+
+uint32_t hal::MqttBroker::connectAttempts() const {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  return s.attempts;
+}
+
+uint32_t hal::MqttBroker::maxConnectBlockMs() const {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  uint32_t now = millis();
+  uint32_t worst = s.maxRefusedMs;
+  for (const auto& session : s.sessions) worst = std::max(worst, session->blockedMs(now));
+  return worst;
+}
+
+std::vector<hal::MqttPublish> hal::MqttBroker::publishes() const {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  return s.log;
+}
+
+std::shared_ptr<hal::Connection> hal::MqttBroker::accept(uint32_t timeoutMs) {
+  State& s = state();
+  uint32_t start = millis();
+  {
+    std::lock_guard<std::mutex> guard(s.mutex);
+    ++s.attempts;
+    if (s.online) {
+      auto session = std::make_shared<Session>();
+      std::weak_ptr<Session> weak = session;
+      session->startMs = start;
+      session->connection = std::make_shared<Connection>(
+          [this, weak](Connection&, const uint8_t* data, size_t len) {
+            if (auto live = weak.lock()) receive(live, data, len);
+          });
+      s.sessions.push_back(session);
+      return session->connection;
+    }
+  }
+  // No SYN-ACK ever comes: the client gives up at its connect timeout
+  delay(timeoutMs);
+  std::lock_guard<std::mutex> guard(s.mutex);
+  s.maxRefusedMs = std::max(s.maxRefusedMs, millis() - start);
+  return nullptr;
+}
+
+void hal::MqttBroker::receive(const std::shared_ptr<Session>& session, const uint8_t* data, size_t len) {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  Session& client = *session;
+  if (client.closed) return;
+  if (!data) {
+    // The client closed the socket
+    client.closed = true;
+    client.closedMs = millis();
+    return;
+  }
+  client.rx.insert(client.rx.end(), data, data + len);
+
+  for (;;) {
+    if (client.rx.size() < 2) return;
+    // Remaining length: up to four 7-bit digits
+    size_t remaining = 0;
+    size_t pos = 1;
+    uint32_t multiplier = 1;
+    for (;;) {
+      if (pos >= client.rx.size()) return;
+      if (pos > 4) {
+        s.drop(client);
+        return;
+      }
+      uint8_t digit = client.rx[pos++];
+      remaining += (digit & 127) * multiplier;
+      multiplier <<= 7;
+      if (!(digit & 128)) break;
+    }
+    if (client.rx.size() < pos + remaining) return;
+
+    uint8_t header = client.rx[0];
+    std::vector<uint8_t> body(client.rx.begin() + pos, client.rx.begin() + pos + remaining);
+    client.rx.erase(client.rx.begin(), client.rx.begin() + pos + remaining);
+
+    uint8_t type = header & 0xF0;
+    size_t at = 0;
+    if (!client.connected && type != 0x10) {
+      s.drop(client);
+      return;
+    }
+
+    switch (type) {
+      case 0x10: {  // CONNECT
+        String protocol, clientId, willTopic, willMessage, user, pass;
+        if (client.connected || !readMqttString(body, at, protocol) || protocol != "MQTT" ||
+            at + 4 > body.size() || body[at] != 4) {
+          s.drop(client);
+          return;
+        }
+        uint8_t flags = body[at + 1];
+        at += 4;   // Level, flags, keepalive
+        bool ok = readMqttString(body, at, clientId);
+        if (ok && (flags & 0x04)) ok = readMqttString(body, at, willTopic) && readMqttString(body, at, willMessage);
+        if (ok && (flags & 0x80)) ok = readMqttString(body, at, user);
+        if (ok && (flags & 0x40)) ok = readMqttString(body, at, pass);
+        if (!ok || at != body.size()) {
+          s.drop(client);
+          return;
+        }
+        client.connected = true;
+        client.connackDueMs = millis() + s.connackDelayMs;
+        const uint8_t connack[] = { 0x20, 0x02, 0x00, 0x00 };
+        client.connection->send(connack, sizeof(connack), s.connackDelayMs);
+        break;
+      }
+      case 0x30: {  // PUBLISH
+        String topic;
+        uint8_t qos = (header >> 1) & 0x03;
+        if (!readMqttString(body, at, topic) || qos > 1 || (qos && at + 2 > body.size())) {
+          s.drop(client);
+          return;
+        }
+        if (qos) {
+          const uint8_t puback[] = { 0x40, 0x02, body[at], body[at + 1] };
+          client.connection->send(puback, sizeof(puback));
+          at += 2;
+        }
+        String payload(reinterpret_cast<const char*>(body.data() + at), static_cast<unsigned int>(body.size() - at));
+        s.log.push_back({ topic, payload, static_cast<uint32_t>(millis()) });
+        break;
+      }
+      case 0x80: {  // SUBSCRIBE
+        if (body.size() < 2) {
+          s.drop(client);
+          return;
+        }
+        std::vector<uint8_t> suback = { 0x90, 0, body[0], body[1] };
+        at = 2;
+        String filter;
+        while (at < body.size()) {
+          if (!readMqttString(body, at, filter) || at >= body.size()) {
+            s.drop(client);
+            return;
+          }
+          suback.push_back(std::min<uint8_t>(body[at++], 1));
+        }
+        suback[1] = static_cast<uint8_t>(suback.size() - 2);
+        client.connection->send(suback.data(), suback.size());
+        break;
+      }
+      case 0xC0: {  // PINGREQ
+        const uint8_t pingresp[] = { 0xD0, 0x00 };
+        client.connection->send(pingresp, sizeof(pingresp));
+        break;
+      }
+      case 0xE0:    // DISCONNECT
+      default:
+        s.drop(client);
+        return;
+    }
+  }
+}
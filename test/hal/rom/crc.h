@@ -0,0 +1,6 @@
+#pragma once
+#include <stdint.h>
+
+// Same contract as the ESP32 ROM: reflected CRC-32 (0xEDB88320), with the
+// caller's running value complemented on entry and exit.
+uint32_t crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len);
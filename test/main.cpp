@@ -0,0 +1,13 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+
+// Firmware tasks never return, so skip static destructors on exit rather
+// than tear objects down under running threads.
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  int result = RUN_ALL_TESTS();
+  fflush(stdout);
+  fflush(stderr);
+  std::_Exit(result);
+}
@@ -0,0 +1,165 @@
+// AdminConfigManager: the shipped admin.json, sensor address and 1-Wire
+// settings, the MQTT format and spool size, and queue settings
+#include <gtest/gtest.h>
+#include <SPIFFS.h>
+#include <fstream>
+#include <sstream>
+#include "AdminConfigManager.h"
+
+namespace {
+
+// data/admin.json from the sketch, parsed so a test can change fields
+DynamicJsonDocument shippedConfig() {
+  std::ifstream in(LOGICGARD_DATA_DIR "/admin.json");
+  std::stringstream text;
+  text << in.rdbuf();
+  DynamicJsonDocument doc(8192);
+  EXPECT_FALSE(deserializeJson(doc, text.str()));
+  return doc;
+}
+
+void install(const JsonDocument& doc) {
+  File file = SPIFFS.open("/admin.json", "w");
+  serializeJson(doc, file);
+  file.close();
+}
+
+class AdminConfigManagerTest : public ::testing::Test {
+protected:
+  void SetUp() override { hal::fsReset(); }
+};
+
+TEST_F(AdminConfigManagerTest, ShippedConfigLoads) {
+  install(shippedConfig());
+  AdminConfigManager admin;
+  admin.begin();
+
+  std::vector<SensorConfig> sensors = admin.getSensors();
+  ASSERT_EQ(sensors.size(), 3u);
+  EXPECT_EQ(sensors[0].interface, "i2c");
+  EXPECT_EQ(sensors[0].i2cAddress, 0x76);
+  EXPECT_EQ(sensors[1].onewirePin, 17);
+  EXPECT_EQ(sensors[1].resolution, 12);
+  EXPECT_TRUE(sensors[1].probes.empty());
+
+  MqttConfig mqtt = admin.getMqttConfig();
+  EXPECT_EQ(mqtt.bufferSize, 4096);
+  EXPECT_EQ(mqtt.format, MqttFormat::Json);
+  EXPECT_EQ(mqtt.spoolMaxBytes, 65536u);
+  EXPECT_EQ(mqtt.queue.depth, 10);
+  EXPECT_EQ(mqtt.queue.policy, OverflowPolicy::DropOldest);
+
+  QueueConfig overlays = admin.getOverlayQueueConfig();
+  EXPECT_EQ(overlays.depth, 1);
+  EXPECT_EQ(overlays.policy, OverflowPolicy::CoalesceLatest);
+}
+
+TEST_F(AdminConfigManagerTest, I2cAddressIsHexStringOrNumber) {
+  DynamicJsonDocument config = shippedConfig();
+  config["sensors"][0]["address"] = "0x77";
+  install(config);
+  AdminConfigManager admin;
+  admin.begin();
+  EXPECT_EQ(admin.getSensors()[0].i2cAddress, 0x77);
+
+  config["sensors"][0]["address"] = 118;
+  install(config);
+  admin.begin();
+  EXPECT_EQ(admin.getSensors()[0].i2cAddress, 0x76);
+
+  config["sensors"][0].as<JsonObject>().remove("address");
+  install(config);
+  admin.begin();
+  EXPECT_EQ(admin.getSensors()[0].i2cAddress, 0x76);
+}
+
+TEST_F(AdminConfigManagerTest, OneWireResolutionAndProbes) {
+  DynamicJsonDocument config = shippedConfig();
+  config["sensors"][1]["resolution"] = 9;
+  config["sensors"][2]["resolution"] = 14;
+  JsonArray probes = config["sensors"][1].createNestedArray("probes");
+  JsonObject freezer = probes.createNestedObject();
+  freezer["rom"] = "28ff641e8c1603ab";
+  freezer["name"] = "Freezer";
+  probes.createNestedObject()["rom"] = "28FF641E8C1603AC";   // No name
+  install(config);
+
+  AdminConfigManager admin;
+  admin.begin();
+  Serial.quiet = true;
+  std::vector<SensorConfig> sensors = admin.getSensors();
+  Serial.quiet = false;
+
+  EXPECT_EQ(sensors[1].resolution, 9);
+  EXPECT_EQ(sensors[2].resolution, 12);
+  ASSERT_EQ(sensors[1].probes.size(), 1u);
+  EXPECT_EQ(sensors[1].probes[0].rom, "28FF641E8C1603AB");
+  EXPECT_EQ(sensors[1].probes[0].name, "Freezer");
+}
+
+TEST_F(AdminConfigManagerTest, MqttFormatAndSpoolSize) {
+  DynamicJsonDocument config = shippedConfig();
+  config["mqtt"]["format"] = "MsgPack";
+  config["mqtt"]["spoolMaxBytes"] = 4096;
+  install(config);
+  AdminConfigManager admin;
+  admin.begin();
+  MqttConfig mqtt = admin.getMqttConfig();
+  EXPECT_EQ(mqtt.format, MqttFormat::MsgPack);
+  EXPECT_EQ(mqtt.spoolMaxBytes, 4096u);
+
+  // Both are optional
+  config["mqtt"].as<JsonObject>().remove("format");
+  config["mqtt"].as<JsonObject>().remove("spoolMaxBytes");
+  install(config);
+  admin.begin();
+  mqtt = admin.getMqttConfig();
+  EXPECT_EQ(mqtt.format, MqttFormat::Json);
+  EXPECT_EQ(mqtt.spoolMaxBytes, 64u * 1024);
+}
+
+TEST_F(AdminConfigManagerTest, QueueSettings) {
+  DynamicJsonDocument config = shippedConfig();
+  config["mqtt"]["queue"]["depth"] = 0;
+  config["mqtt"]["queue"]["overflow"] = "DROPNEWEST";
+  config["overlayQueue"]["overflow"] = "dropEverything";
+  install(config);
+  AdminConfigManager admin;
+  admin.begin();
+
+  MqttConfig mqtt = admin.getMqttConfig();
+  EXPECT_EQ(mqtt.queue.depth, 1);
+  EXPECT_EQ(mqtt.queue.policy, OverflowPolicy::DropNewest);
+
+  std::string output;
+  Serial.capture = &output;
+  QueueConfig overlays = admin.getOverlayQueueConfig();
+  Serial.capture = nullptr;
+  EXPECT_EQ(overlays.policy, OverflowPolicy::CoalesceLatest);
+  EXPECT_NE(output.find("Unknown queue overflow policy 'dropeverything'"), std::string::npos) << output;
+
+  // A coalescing queue has one slot per sensor; a depth is not applied
+  config["overlayQueue"]["overflow"] = "coalesce";
+  config["overlayQueue"]["depth"] = 50;
+  install(config);
+  admin.begin();
+  output.clear();
+  Serial.capture = &output;
+  overlays = admin.getOverlayQueueConfig();
+  Serial.capture = nullptr;
+  EXPECT_EQ(overlays.policy, OverflowPolicy::CoalesceLatest);
+  EXPECT_EQ(overlays.depth, 1);
+  EXPECT_NE(output.find("Queue depth is ignored"), std::string::npos) << output;
+
+  // Without a queue section the defaults apply
+  config["mqtt"].as<JsonObject>().remove("queue");
+  config.as<JsonObject>().remove("overlayQueue");
+  install(config);
+  admin.begin();
+  mqtt = admin.getMqttConfig();
+  EXPECT_EQ(mqtt.queue.depth, QueueConfig().depth);
+  EXPECT_EQ(mqtt.queue.policy, OverflowPolicy::DropNewest);
+  EXPECT_EQ(admin.getOverlayQueueConfig().depth, 1);
+}
+
+}  // namespace
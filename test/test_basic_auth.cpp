@@ -0,0 +1,81 @@
+// BasicAuthStrategy: the header is encoded once, at construction, and
+// sent preemptively, and a failed connection backs off instead of blocking
+#include <gtest/gtest.h>
+#include <HTTPClient.h>
+#include <memory>
+#include "BasicAuthStrategy.h"
+
+namespace {
+
+ApiConfig cameraApi() {
+  ApiConfig api;
+  api.host = "camera.local";
+  api.port = 80;
+  api.path = "/axis-cgi/dynamicoverlay/dynamicoverlay.cgi";
+  return api;
+}
+
+class BasicAuthTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    hal::HttpServer& server = hal::HttpServer::instance();
+    server.reset();
+    server.setHandler([](const hal::HttpRequest& request) {
+      hal::HttpResponse response;
+      if (request.header("Authorization") != "Basic cm9vdDpwYXNz") response.code = 401;
+      return response;
+    });
+  }
+};
+
+}  // namespace
+
+TEST_F(BasicAuthTest, SendsTheCachedHeaderWithoutAChallenge) {
+  BasicAuthStrategy auth({ "root", "pass" });
+  EXPECT_EQ(auth.getAuthHeader("POST", "/"), "Basic cm9vdDpwYXNz");
+
+  for (int i = 0; i < 5; ++i) EXPECT_TRUE(auth.post("{}", nullptr, cameraApi()));
+
+  // One request per post: nothing unauthenticated went out first
+  std::vector<hal::HttpRequest> requests = hal::HttpServer::instance().requests();
+  ASSERT_EQ(requests.size(), 5u);
+  for (const hal::HttpRequest& request : requests) {
+    EXPECT_EQ(request.header("Authorization"), "Basic cm9vdDpwYXNz");
+  }
+}
+
+TEST_F(BasicAuthTest, WrongCredentialsAreRejectedWithoutRetrying) {
+  BasicAuthStrategy auth({ "root", "wrong" });
+  EXPECT_EQ(auth.getAuthHeader("POST", "/"), "Basic cm9vdDp3cm9uZw==");
+  EXPECT_FALSE(auth.post("{}", nullptr, cameraApi()));
+  EXPECT_EQ(hal::HttpServer::instance().requestCount(), 1u);
+}
+
+TEST_F(BasicAuthTest, MissingOrOversizedCredentialsSendNothing) {
+  BasicAuthStrategy empty({ "root", "" });
+  EXPECT_FALSE(empty.post("{}", nullptr, cameraApi()));
+
+  BasicAuthStrategy oversized({ "root", String(std::string(200, 'x')) });
+  EXPECT_TRUE(oversized.getAuthHeader("POST", "/").isEmpty());
+  EXPECT_FALSE(oversized.post("{}", nullptr, cameraApi()));
+
+  EXPECT_EQ(hal::HttpServer::instance().requestCount(), 0u);
+}
+
+TEST_F(BasicAuthTest, UnreachableCameraBacksOffUntilTheRetryWindow) {
+  hal::HttpServer& server = hal::HttpServer::instance();
+  BasicAuthStrategy auth({ "root", "pass" });
+
+  server.setReachable(false);
+  EXPECT_FALSE(auth.post("{}", nullptr, cameraApi()));
+  uint32_t failedAt = millis();
+
+  // Within the backoff the post fails without trying to connect
+  server.setReachable(true);
+  EXPECT_FALSE(auth.post("{}", nullptr, cameraApi()));
+  EXPECT_EQ(server.connectionsOpened(), 0u);
+
+  delay(HttpClientWrapper::FAILURE_BACKOFF_MS - (millis() - failedAt) + 10);
+  EXPECT_TRUE(auth.post("{}", nullptr, cameraApi()));
+  EXPECT_EQ(server.connectionsOpened(), 1u);
+}
@@ -0,0 +1,159 @@
+// Bme280 against a simulated chip: the integer compensation matches the
+// datasheet example, and Sensor_I2C publishes all three channels from one
+// forced measurement and one burst read
+#include <gtest/gtest.h>
+#include <Wire.h>
+#include <mutex>
+#include <vector>
+#include "Bme280.h"
+#include "ConsumerExecutor.h"
+#include "I2cBus.h"
+#include "MessageDispatcher.h"
+#include "Sensor_I2C.h"
+#include "TestSupport.h"
+
+namespace {
+
+constexpr int SDA = 21;
+constexpr int SCL = 22;
+
+// Trimming values and raw readings from the BME280 datasheet's
+// compensation example (25.08 °C, 100653 Pa); the humidity trimming is a
+// typical part's, giving 55.00 %RH.
+class FakeBme280 : public hal::RegisterDevice {
+public:
+  uint32_t forcedTriggers = 0;
+  uint32_t dataReads = 0;
+
+  FakeBme280() {
+    regs[0xD0] = 0x60;
+    const int16_t tp[] = { 27504, 26435, -1000,                                      // T1..T3
+                           -29059, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000 };  // P1 (36477 unsigned)..P9
+    for (size_t i = 0; i < sizeof(tp) / sizeof(tp[0]); ++i) put16(0x88 + i * 2, tp[i]);
+    regs[0xA1] = 75;                                // H1
+    put16(0xE1, 362);                               // H2
+    regs[0xE3] = 0;                                 // H3
+    regs[0xE4] = 313 >> 4;                          // H4 = E4 << 4 | E5[3:0]
+    regs[0xE5] = (313 & 0x0F) | ((50 & 0x0F) << 4); // H5 = E6 << 4 | E5[7:4]
+    regs[0xE6] = 50 >> 4;
+    regs[0xE7] = 30;                                // H6
+    setRaw(415148, 519888, 30000);
+  }
+
+  void setRaw(uint32_t adcP, uint32_t adcT, uint16_t adcH) {
+    regs[0xF7] = adcP >> 12; regs[0xF8] = adcP >> 4; regs[0xF9] = (adcP & 0x0F) << 4;
+    regs[0xFA] = adcT >> 12; regs[0xFB] = adcT >> 4; regs[0xFC] = (adcT & 0x0F) << 4;
+    regs[0xFD] = adcH >> 8;  regs[0xFE] = adcH & 0xFF;
+  }
+
+  bool read(uint8_t* out, size_t len) override {
+    if (pointer == 0xF7) ++dataReads;
+    return RegisterDevice::read(out, len);
+  }
+
+protected:
+  void onWrite(uint8_t reg, uint8_t value) override {
+    if (reg == 0xF4 && (value & 0x03) == 0x01) ++forcedTriggers;
+  }
+
+private:
+  void put16(size_t reg, int16_t value) {
+    regs[reg] = static_cast<uint16_t>(value) & 0xFF;
+    regs[reg + 1] = static_cast<uint16_t>(value) >> 8;
+  }
+};
+
+class RecordingConsumer : public MessageConsumer {
+public:
+  using MessageConsumer::MessageConsumer;
+  ~RecordingConsumer() override { end(); }
+
+  std::vector<SensorMessage> received() {
+    std::lock_guard<std::mutex> guard(mutex);
+    return messages;
+  }
+
+protected:
+  void process(const SensorMessage& msg) override {
+    std::lock_guard<std::mutex> guard(mutex);
+    messages.push_back(msg);
+  }
+
+private:
+  std::mutex mutex;
+  std::vector<SensorMessage> messages;
+};
+
+}  // namespace
+
+TEST(Bme280Test, CompensatesTheDatasheetExample) {
+  static FakeBme280 chip;
+  Wire.attach(0x76, &chip);
+  I2cBus* bus = I2cBus::forPins(SDA, SCL);
+  ASSERT_NE(bus, nullptr);
+
+  Bme280 bme;
+  ASSERT_TRUE(bme.begin(*bus, 0x76));
+  ASSERT_TRUE(bme.trigger());
+  EXPECT_EQ(chip.forcedTriggers, 1u);
+
+  Bme280::Reading reading;
+  ASSERT_TRUE(bme.read(reading));
+  EXPECT_EQ(reading.centiCelsius, 2508);
+  EXPECT_EQ(reading.pressurePa, 100653u);
+  EXPECT_EQ(reading.centiHumidity, 5500u);
+  EXPECT_EQ(chip.dataReads, 1u);
+}
+
+TEST(Bme280Test, SkippedChannelFailsTheRead) {
+  static FakeBme280 chip;
+  Wire.attach(0x76, &chip);
+  Bme280 bme;
+  ASSERT_TRUE(bme.begin(*I2cBus::forPins(SDA, SCL), 0x76));
+
+  chip.setRaw(0x80000, 519888, 30000);
+  Bme280::Reading reading;
+  EXPECT_FALSE(bme.read(reading));
+}
+
+TEST(Bme280Test, WrongChipIdFailsBegin) {
+  static FakeBme280 chip;
+  chip.regs[0xD0] = 0x58;   // BMP280: no humidity
+  Wire.attach(0x76, &chip);
+  Bme280 bme;
+
+  EXPECT_FALSE(bme.begin(*I2cBus::forPins(SDA, SCL), 0x76));
+}
+
+TEST(Bme280Test, SensorPublishesEveryChannelFromOneMeasurement) {
+  ConsumerExecutor::begin();
+  static FakeBme280 chip;
+  Wire.attach(0x77, &chip);
+
+  MessageDispatcher dispatcher;
+  RecordingConsumer freezer("bme freezer");
+  freezer.begin({ 4, OverflowPolicy::DropNewest });
+  dispatcher.registerConsumer(&freezer);
+
+  SensorConfig config;
+  config.name = "bme freezer";
+  config.interface = "i2c";
+  config.enabled = true;
+  config.readIntervalMs = 1000;
+  config.sdaPin = SDA;
+  config.sclPin = SCL;
+  config.i2cAddress = 0x77;
+  Sensor_I2C sensor(dispatcher, config);
+  ASSERT_TRUE(sensor.begin());
+
+  EXPECT_EQ(sensor.poll(), Bme280::MEASURE_MS);
+  EXPECT_EQ(sensor.poll(), config.readIntervalMs - Bme280::MEASURE_MS);
+
+  ASSERT_TRUE(waitUntil([&] { return freezer.received().size() == 1; }, 2000));
+  SensorMessage msg = freezer.received()[0];
+  EXPECT_EQ(msg.get(Channel::Temperature), 7714);   // 25.08 °C = 77.144 °F
+  EXPECT_EQ(msg.get(Channel::Humidity), 5500);
+  EXPECT_EQ(msg.get(Channel::Pressure), 100653);
+  EXPECT_EQ(chip.forcedTriggers, 1u);
+  EXPECT_EQ(chip.dataReads, 1u);
+}
@@ -0,0 +1,99 @@
+// ConfigManager: the shipped user.json, the overlay temperature unit, and
+// patches from the settings page
+#include <gtest/gtest.h>
+#include <SPIFFS.h>
+#include <fstream>
+#include <sstream>
+#include "ConfigManager.h"
+
+namespace {
+
+// A config file from the sketch's data directory, parsed so a test can
+// change fields
+DynamicJsonDocument shippedConfig(const char* name) {
+  std::ifstream in(std::string(LOGICGARD_DATA_DIR "/") + name);
+  std::stringstream text;
+  text << in.rdbuf();
+  DynamicJsonDocument doc(8192);
+  EXPECT_FALSE(deserializeJson(doc, text.str()));
+  return doc;
+}
+
+void install(const char* path, const JsonDocument& doc) {
+  File file = SPIFFS.open(path, "w");
+  serializeJson(doc, file);
+  file.close();
+}
+
+class ConfigManagerTest : public ::testing::Test {
+protected:
+  void SetUp() override { hal::fsReset(); }
+};
+
+TEST_F(ConfigManagerTest, ShippedConfigLoads) {
+  install("/user.json", shippedConfig("user.json"));
+  ConfigManager config;
+  config.begin();
+
+  DeviceIdentity id = config.getDeviceIdentity();
+  EXPECT_EQ(id.clientId, "ABC123");
+  EXPECT_EQ(id.unitId, "UNIT789");
+
+  std::vector<CameraConfig> cameras = config.getCameraConfigList();
+  ASSERT_EQ(cameras.size(), 1u);
+  EXPECT_EQ(cameras[0].api.port, 8083);
+  ASSERT_EQ(cameras[0].overlays.size(), 2u);
+  EXPECT_EQ(cameras[0].overlays[0].indicator, "LogicGARD1");
+  EXPECT_EQ(cameras[0].overlays[0].unit, TemperatureUnit::Fahrenheit);
+}
+
+TEST_F(ConfigManagerTest, OverlayUnit) {
+  DynamicJsonDocument user = shippedConfig("user.json");
+  user["cameras"][0]["overlays"][0]["unit"]["value"] = "°C";
+  user["cameras"][0]["overlays"][1].as<JsonObject>().remove("unit");
+  install("/user.json", user);
+  ConfigManager config;
+  config.begin();
+
+  std::vector<OverlayConfig> overlays = config.getCameraConfigList()[0].overlays;
+  EXPECT_EQ(overlays[0].unit, TemperatureUnit::Celsius);
+  // Saved before the setting existed
+  EXPECT_EQ(overlays[1].unit, TemperatureUnit::Fahrenheit);
+}
+
+TEST_F(ConfigManagerTest, PatchUpdatesAndSavesValues) {
+  install("/user.json", shippedConfig("user.json"));
+  ConfigManager config;
+  config.begin();
+
+  StaticJsonDocument<256> patch;
+  patch["identification_unitId"] = "UNIT42";
+  patch["cameras_missing"] = "ignored";
+  Serial.quiet = true;
+  config.syncValuesFrom(patch.as<JsonObject>());
+  Serial.quiet = false;
+  EXPECT_EQ(config.getDeviceIdentity().unitId, "UNIT42");
+
+  ConfigManager reloaded;
+  reloaded.begin();
+  EXPECT_EQ(reloaded.getDeviceIdentity().unitId, "UNIT42");
+  EXPECT_EQ(reloaded.getDeviceIdentity().clientId, "ABC123");
+}
+
+TEST_F(ConfigManagerTest, RestoreSettingsReplacesTheFile) {
+  DynamicJsonDocument user = shippedConfig("user.json");
+  user["identification"]["unitId"]["value"] = "CHANGED";
+  install("/user.json", user);
+  install("/user_bkup.json", shippedConfig("user_bkup.json"));
+  ConfigManager config;
+  config.begin();
+  EXPECT_EQ(config.getDeviceIdentity().unitId, "CHANGED");
+
+  Serial.quiet = true;
+  config.restoreSettings();
+  Serial.quiet = false;
+  config.begin();
+  EXPECT_EQ(config.getDeviceIdentity().unitId, "UNIT789");
+}
+
+}  // namespace
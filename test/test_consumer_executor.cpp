@@ -0,0 +1,147 @@
+// ConsumerExecutor: per-consumer ordering, fairness between consumers on
+// a shared worker, and the consumer cap
+#include <gtest/gtest.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "ConsumerExecutor.h"
+#include "MessageConsumer.h"
+#include "TestSupport.h"
+
+namespace {
+
+class RecordingConsumer : public MessageConsumer {
+public:
+  RecordingConsumer(const String& sensorId, uint32_t workMs = 0) : MessageConsumer(sensorId), workMs(workMs) {}
+  ~RecordingConsumer() override { end(); }
+
+  std::vector<uint32_t> seen() {
+    std::lock_guard<std::mutex> guard(mutex);
+    return timestamps;
+  }
+
+  size_t processed() {
+    std::lock_guard<std::mutex> guard(mutex);
+    return timestamps.size();
+  }
+
+  std::function<void()> onProcess;
+
+protected:
+  void process(const SensorMessage& msg) override {
+    if (workMs) delay(workMs);
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      timestamps.push_back(msg.timestamp);
+    }
+    if (onProcess) onProcess();
+  }
+
+private:
+  const uint32_t workMs;
+  std::mutex mutex;
+  std::vector<uint32_t> timestamps;
+};
+
+class ConsumerExecutorTest : public ::testing::Test {
+protected:
+  // One worker makes the interleaving between consumers deterministic
+  static void SetUpTestSuite() { ConsumerExecutor::begin(1); }
+};
+
+}  // namespace
+
+TEST_F(ConsumerExecutorTest, ProcessesEachConsumersMessagesInOrder) {
+  RecordingConsumer consumer("ordered");
+  consumer.begin({ 512, OverflowPolicy::DropNewest });
+  SensorHandle sensor = consumer.getSensorHandle();
+
+  for (uint32_t i = 0; i < 500; ++i) {
+    consumer.enqueue(SensorMessage::make(sensor, i));
+  }
+
+  ASSERT_TRUE(waitUntil([&] { return consumer.processed() == 500; }, 3000)) << consumer.processed();
+  std::vector<uint32_t> seen = consumer.seen();
+  for (uint32_t i = 0; i < seen.size(); ++i) {
+    ASSERT_EQ(seen[i], i);
+  }
+}
+
+TEST_F(ConsumerExecutorTest, BusyConsumerDoesNotStarveOthers) {
+  constexpr uint32_t BACKLOG = 64;
+  RecordingConsumer busy("busy", 2);
+  busy.begin({ BACKLOG, OverflowPolicy::DropNewest });
+  RecordingConsumer quiet("quiet");
+  quiet.begin({ 4, OverflowPolicy::DropNewest });
+
+  std::atomic<size_t> busyWhenQuietRan{0};
+  quiet.onProcess = [&] { busyWhenQuietRan = busy.processed(); };
+
+  for (uint32_t i = 0; i < BACKLOG; ++i) {
+    busy.enqueue(SensorMessage::make(busy.getSensorHandle(), i));
+  }
+  quiet.enqueue(SensorMessage::make(quiet.getSensorHandle(), 0));
+
+  ASSERT_TRUE(waitUntil([&] { return busy.processed() == BACKLOG; }, 5000));
+  ASSERT_EQ(quiet.processed(), 1u);
+
+  // The quiet consumer waits for at most the batch in progress plus one
+  // more, not for the whole backlog
+  EXPECT_LE(busyWhenQuietRan.load(), 2 * ConsumerExecutor::DRAIN_BUDGET);
+}
+
+TEST_F(ConsumerExecutorTest, RefusesConsumersPastTheCap) {
+  std::vector<std::unique_ptr<RecordingConsumer>> consumers;
+  while (ConsumerExecutor::consumerCount() < ConsumerExecutor::MAX_CONSUMERS) {
+    consumers.emplace_back(new RecordingConsumer("filler"));
+    consumers.back()->begin({ 2, OverflowPolicy::DropNewest });
+  }
+
+  RecordingConsumer extra("extra");
+  Serial.quiet = true;
+  extra.begin({ 2, OverflowPolicy::DropNewest });
+  Serial.quiet = false;
+  EXPECT_EQ(ConsumerExecutor::consumerCount(), ConsumerExecutor::MAX_CONSUMERS);
+
+  // Every admitted consumer can be pending at once without losing its slot
+  for (auto& consumer : consumers) {
+    consumer->enqueue(SensorMessage::make(consumer->getSensorHandle(), 1));
+  }
+  extra.enqueue(SensorMessage::make(extra.getSensorHandle(), 1));
+
+  ASSERT_TRUE(waitUntil([&] {
+    for (auto& consumer : consumers) {
+      if (consumer->processed() != 1) return false;
+    }
+    return true;
+  }, 3000));
+  EXPECT_EQ(extra.processed(), 0u);
+  EXPECT_EQ(extra.getQueueStats().enqueued, 0u);
+
+  // A consumer that goes away hands its slot to the next one
+  consumers.pop_back();
+  EXPECT_EQ(ConsumerExecutor::consumerCount(), ConsumerExecutor::MAX_CONSUMERS - 1);
+  RecordingConsumer late("late");
+  late.begin({ 2, OverflowPolicy::DropNewest });
+  late.enqueue(SensorMessage::make(late.getSensorHandle(), 1));
+  EXPECT_TRUE(waitUntil([&] { return late.processed() == 1; }, 1000));
+}
+
+TEST_F(ConsumerExecutorTest, EndWaitsForTheWorkerAndDropsTheBacklog) {
+  size_t before = ConsumerExecutor::consumerCount();
+  RecordingConsumer slow("slow", 20);
+  slow.begin({ 16, OverflowPolicy::DropNewest });
+  for (uint32_t i = 0; i < 16; ++i) {
+    slow.enqueue(SensorMessage::make(slow.getSensorHandle(), i));
+  }
+  ASSERT_TRUE(waitUntil([&] { return slow.processed() >= 1; }, 1000));
+
+  // Returns once the message in progress is done, without the other 14
+  slow.end();
+  size_t processed = slow.processed();
+  EXPECT_LT(processed, 16u);
+  EXPECT_EQ(ConsumerExecutor::consumerCount(), before);
+  delay(100);
+  EXPECT_EQ(slow.processed(), processed);
+}
@@ -0,0 +1,51 @@
+// DigestAuthStrategy: the challenge's qop list must offer plain auth, which
+// is the only quality of protection the strategy implements
+#include <gtest/gtest.h>
+#include <HTTPClient.h>
+#include "DigestAuthStrategy.h"
+
+namespace {
+
+ApiConfig cameraApi() {
+  ApiConfig api;
+  api.host = "camera.local";
+  api.port = 80;
+  api.path = "/axis-cgi/dynamicoverlay/dynamicoverlay.cgi";
+  return api;
+}
+
+// Challenges every request without a Digest header with the given qop
+void challengeWith(const String& qop) {
+  hal::HttpServer& server = hal::HttpServer::instance();
+  server.reset();
+  server.setHandler([qop](const hal::HttpRequest& request) {
+    hal::HttpResponse response;
+    if (!request.header("Authorization").startsWith("Digest ")) {
+      response.code = 401;
+      response.headers.push_back({ "WWW-Authenticate",
+                                   "Digest realm=\"cam\", nonce=\"n0nce\", qop=\"" + qop + "\"" });
+    }
+    return response;
+  });
+}
+
+}  // namespace
+
+TEST(DigestAuthTest, PicksAuthOutOfTheOfferedList) {
+  challengeWith("auth-int, auth");
+  DigestAuthStrategy auth({ "root", "pass" });
+  EXPECT_TRUE(auth.post("{}", nullptr, cameraApi()));
+
+  std::vector<hal::HttpRequest> requests = hal::HttpServer::instance().requests();
+  ASSERT_EQ(requests.size(), 2u);
+  EXPECT_GE(requests[1].header("Authorization").indexOf("qop=\"auth\""), 0);
+}
+
+TEST(DigestAuthTest, FailsWhenOnlyAuthIntIsOffered) {
+  challengeWith("auth-int");
+  DigestAuthStrategy auth({ "root", "pass" });
+  EXPECT_FALSE(auth.post("{}", nullptr, cameraApi()));
+
+  // The challenge request only: nothing was signed with the wrong qop
+  EXPECT_EQ(hal::HttpServer::instance().requestCount(), 1u);
+}
@@ -0,0 +1,45 @@
+// MessageDispatcher routing by sensor handle and to wildcard consumers
+#include <gtest/gtest.h>
+#include <atomic>
+#include "ConsumerExecutor.h"
+#include "MessageDispatcher.h"
+#include "TestSupport.h"
+
+namespace {
+
+class CountingConsumer : public MessageConsumer {
+public:
+  using MessageConsumer::MessageConsumer;
+  ~CountingConsumer() override { end(); }
+  std::atomic<uint32_t> processed{0};
+
+protected:
+  void process(const SensorMessage&) override { processed.fetch_add(1); }
+};
+
+class DispatcherTest : public ::testing::Test {
+protected:
+  static void SetUpTestSuite() { ConsumerExecutor::begin(); }
+};
+
+}  // namespace
+
+TEST_F(DispatcherTest, RoutesBySensorAndToWildcards) {
+  MessageDispatcher dispatcher;
+  CountingConsumer freezer("route-freezer");
+  CountingConsumer cooler("route-cooler");
+  CountingConsumer everything("*");
+  for (CountingConsumer* consumer : { &freezer, &cooler, &everything }) {
+    consumer->begin({ 8, OverflowPolicy::DropNewest });
+    dispatcher.registerConsumer(consumer);
+  }
+
+  dispatcher.publish(SensorMessage::make(freezer.getSensorHandle(), 1));
+  dispatcher.publish(SensorMessage::make(freezer.getSensorHandle(), 2));
+  dispatcher.publish(SensorMessage::make(cooler.getSensorHandle(), 3));
+  dispatcher.publish(SensorMessage::make(SensorRegistry::intern("route-unclaimed"), 4));
+
+  ASSERT_TRUE(waitUntil([&] { return everything.processed == 4; }, 2000));
+  EXPECT_EQ(freezer.processed, 2u);
+  EXPECT_EQ(cooler.processed, 1u);
+}
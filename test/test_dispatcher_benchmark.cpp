@@ -0,0 +1,62 @@
+// Publish latency of MessageDispatcher for 1, 8 and 64 consumers. Its own
+// executable because 64 consumers take every executor slot.
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "ConsumerExecutor.h"
+#include "MessageDispatcher.h"
+
+namespace {
+
+class CountingConsumer : public MessageConsumer {
+public:
+  using MessageConsumer::MessageConsumer;
+  ~CountingConsumer() override { end(); }
+  std::atomic<uint32_t> processed{0};
+
+protected:
+  void process(const SensorMessage&) override { processed.fetch_add(1); }
+};
+
+}  // namespace
+
+// Not a pass/fail timing test: prints ns per publish so a change to the
+// routing can be compared before and after. The consumers drain on the
+// executor meanwhile, as they would on the device.
+TEST(DispatcherBenchmark, PublishLatency) {
+  constexpr uint32_t PUBLISHES = 20000;
+  ConsumerExecutor::begin();
+  MessageDispatcher dispatcher;
+  SensorHandle sensor = SensorRegistry::intern("bench");
+  SensorHandle other = SensorRegistry::intern("bench-other");
+  std::vector<std::unique_ptr<CountingConsumer>> consumers;
+
+  for (size_t target : { 1, 8, 64 }) {
+    while (consumers.size() < target) {
+      consumers.emplace_back(new CountingConsumer("bench"));
+      consumers.back()->begin({ 16, OverflowPolicy::DropOldest });
+      dispatcher.registerConsumer(consumers.back().get());
+    }
+
+    auto measure = [&](SensorHandle handle) {
+      auto start = std::chrono::steady_clock::now();
+      for (uint32_t i = 0; i < PUBLISHES; ++i) {
+        dispatcher.publish(SensorMessage::make(handle, i));
+      }
+      auto elapsed = std::chrono::steady_clock::now() - start;
+      return std::chrono::duration<double, std::nano>(elapsed).count() / PUBLISHES;
+    };
+
+    double matched = measure(sensor);
+    double unmatched = measure(other);
+    printf("[ BENCH    ] %2u consumers: %7.1f ns/publish matched, %5.1f ns/publish unmatched\n",
+           (unsigned)target, matched, unmatched);
+  }
+
+  // Matched publishes reached every consumer; unmatched ones none
+  ASSERT_EQ(consumers.size(), ConsumerExecutor::MAX_CONSUMERS);
+  EXPECT_EQ(consumers.front()->getQueueStats().enqueued, 3 * PUBLISHES);
+  EXPECT_EQ(consumers.back()->getQueueStats().enqueued, PUBLISHES);
+}
@@ -0,0 +1,127 @@
+// HttpClientWrapper / HttpConnectionPool: https goes over TLS, shared
+// pools are keyed by scheme, keep-alive survives a server-side drop, and
+// a Digest camera costs one handshake and one challenge for a whole run
+#include <gtest/gtest.h>
+#include <HTTPClient.h>
+#include <memory>
+#include "DigestAuthStrategy.h"
+#include "HttpConnectionPool.h"
+
+namespace {
+
+ApiConfig cameraApi(const char* scheme, uint16_t port) {
+  ApiConfig api;
+  api.scheme = scheme;
+  api.host = "camera.local";
+  api.port = port;
+  api.path = "/axis-cgi/dynamicoverlay/dynamicoverlay.cgi";
+  return api;
+}
+
+hal::HttpResponse ok() {
+  hal::HttpResponse response;
+  response.body = "{\"apiVersion\":\"1.0\",\"data\":{}}";
+  return response;
+}
+
+// Answers unauthenticated requests with a Digest challenge
+hal::HttpResponse digestCamera(const hal::HttpRequest& request) {
+  if (request.header("Authorization").startsWith("Digest ")) return ok();
+  hal::HttpResponse challenge;
+  challenge.code = 401;
+  challenge.headers.push_back({ "WWW-Authenticate",
+                                "Digest realm=\"AXIS_ACCC8E000000\", nonce=\"0a4f113b\", qop=\"auth\"" });
+  return challenge;
+}
+
+class HttpConnectionPoolTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    hal::HttpServer::instance().reset();
+    hal::HttpServer::instance().setHandler([](const hal::HttpRequest&) { return ok(); });
+  }
+};
+
+}  // namespace
+
+TEST_F(HttpConnectionPoolTest, HttpsUrlsGoOverTls) {
+  HttpClientWrapper wrapper;
+  hal::HttpServer& server = hal::HttpServer::instance();
+
+  EXPECT_EQ(wrapper.performPost(cameraApi("https", 443).fullUrl(), "{}"), 200);
+  EXPECT_EQ(server.secureConnectionsOpened(), 1u);
+  ASSERT_EQ(server.requests().size(), 1u);
+  EXPECT_TRUE(server.requests()[0].secure);
+
+  EXPECT_EQ(wrapper.performPost(cameraApi("http", 80).fullUrl(), "{}"), 200);
+  EXPECT_EQ(server.connectionsOpened(), 2u);
+  EXPECT_EQ(server.secureConnectionsOpened(), 1u);
+  EXPECT_FALSE(server.requests()[1].secure);
+}
+
+TEST_F(HttpConnectionPoolTest, SharedPoolsAreKeyedByScheme) {
+  auto plain = HttpConnectionPool::forHost("http", "camera.local", 8080);
+  auto secure = HttpConnectionPool::forHost("https", "camera.local", 8080);
+
+  EXPECT_NE(plain, secure);
+  EXPECT_EQ(plain, HttpConnectionPool::forHost("http", "camera.local", 8080));
+  EXPECT_EQ(secure, HttpConnectionPool::forHost("https", "camera.local", 8080));
+}
+
+TEST_F(HttpConnectionPoolTest, KeepAliveReconnectsAfterTheServerDrops) {
+  HttpClientWrapper wrapper;
+  hal::HttpServer& server = hal::HttpServer::instance();
+  String url = cameraApi("https", 443).fullUrl();
+
+  for (int i = 0; i < 10; ++i) ASSERT_EQ(wrapper.performPost(url, "{}"), 200);
+  EXPECT_EQ(server.connectionsOpened(), 1u);
+  EXPECT_EQ(wrapper.connectionsOpened(), 1u);
+
+  server.dropConnections();
+  EXPECT_EQ(wrapper.performPost(url, "{}"), 200);
+  EXPECT_EQ(server.connectionsOpened(), 2u);
+  EXPECT_TRUE(wrapper.isValid());
+}
+
+// Before: every post opened a fresh TLS connection and fetched a new
+// Digest challenge. After: one handshake and one challenge per run.
+TEST_F(HttpConnectionPoolTest, DigestPostsReuseTheConnectionAndNonce) {
+  constexpr int POSTS = 20;
+  constexpr uint32_t HANDSHAKE_US = 20000;   // TLS on the ESP32 is tens of ms
+  constexpr uint32_t ROUND_TRIP_US = 1000;
+  hal::HttpServer& server = hal::HttpServer::instance();
+  server.setHandler(digestCamera);
+  server.setLatency(HANDSHAKE_US, ROUND_TRIP_US);
+  ApiConfig api = cameraApi("https", 443);
+
+  uint32_t start = micros();
+  for (int i = 0; i < POSTS; ++i) {
+    server.dropConnections();
+    DigestAuthStrategy fresh({ "root", "pass" });
+    ASSERT_TRUE(fresh.post("{}", nullptr, api));
+  }
+  uint32_t beforeUs = micros() - start;
+  uint32_t beforeHandshakes = server.connectionsOpened();
+  uint32_t beforeRequests = server.requestCount();
+
+  server.reset();
+  server.setHandler(digestCamera);
+  server.setLatency(HANDSHAKE_US, ROUND_TRIP_US);
+  DigestAuthStrategy reused({ "root", "pass" }, std::make_shared<HttpConnectionPool>(1));
+  start = micros();
+  for (int i = 0; i < POSTS; ++i) ASSERT_TRUE(reused.post("{}", nullptr, api));
+  uint32_t afterUs = micros() - start;
+
+  printf("[ BENCH    ] %d Digest posts over https: before %lu ms, %lu handshakes, %lu requests; "
+         "after %lu ms, %lu handshakes, %lu requests\n",
+         POSTS, static_cast<unsigned long>(beforeUs / 1000), static_cast<unsigned long>(beforeHandshakes),
+         static_cast<unsigned long>(beforeRequests), static_cast<unsigned long>(afterUs / 1000),
+         static_cast<unsigned long>(server.connectionsOpened()), static_cast<unsigned long>(server.requestCount()));
+
+  EXPECT_EQ(beforeHandshakes, static_cast<uint32_t>(POSTS));
+  EXPECT_EQ(beforeRequests, static_cast<uint32_t>(2 * POSTS));
+  EXPECT_EQ(server.connectionsOpened(), 1u);
+  EXPECT_EQ(server.secureConnectionsOpened(), 1u);
+  EXPECT_EQ(server.requestCount(), static_cast<uint32_t>(POSTS + 1));
+  EXPECT_LT(afterUs, beforeUs);
+}
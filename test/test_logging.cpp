@@ -0,0 +1,148 @@
+// LOG_* macros: lazy arguments, per-component levels, and heap
+// allocations per sensor cycle against the old String-based debugLog
+#include <gtest/gtest.h>
+#include <atomic>
+#include "AllocationCounter.h"
+#include "BaseComponent.h"
+#include "ConsumerExecutor.h"
+#include "MessageDispatcher.h"
+#include "TestSupport.h"
+
+namespace {
+
+int evaluations = 0;
+
+int expensiveArgument() {
+  ++evaluations;
+  return 42;
+}
+
+// What every call site did before the LOG_* macros: the String was built
+// before debugLog looked at the flag.
+bool legacyDebugEnabled = false;
+
+void legacyDebugLog(const String& msg) {
+  if (legacyDebugEnabled) {
+    Serial.print("[Debug] ");
+    Serial.println(msg);
+  }
+}
+
+class CountingConsumer : public MessageConsumer {
+public:
+  using MessageConsumer::MessageConsumer;
+  ~CountingConsumer() override { end(); }
+  std::atomic<uint32_t> processed{0};
+
+protected:
+  void process(const SensorMessage& msg) override {
+    LOG_DEBUG("CountingConsumer::process - sensor %s at %lu", msg.sensorId(), (unsigned long)msg.timestamp);
+    processed.fetch_add(1);
+  }
+};
+
+class LoggingTest : public ::testing::Test {
+protected:
+  void TearDown() override { BaseComponent::enableDebug(false); }
+};
+
+}  // namespace
+
+// First, so that no test has reset the levels yet
+TEST_F(LoggingTest, EveryTagStartsAtInfo) {
+  for (uint8_t tag = 0; tag < static_cast<uint8_t>(LogTag::Count); ++tag) {
+    EXPECT_TRUE(BaseComponent::logEnabled(static_cast<LogTag>(tag), LOG_LEVEL_INFO)) << unsigned(tag);
+    EXPECT_FALSE(BaseComponent::logEnabled(static_cast<LogTag>(tag), LOG_LEVEL_DEBUG)) << unsigned(tag);
+  }
+}
+
+TEST_F(LoggingTest, DisabledLevelsDoNotEvaluateArguments) {
+  evaluations = 0;
+  LOG_DEBUG("value %d", expensiveArgument());
+  EXPECT_EQ(evaluations, 0);
+
+  Serial.quiet = true;
+  LOG_INFO("value %d", expensiveArgument());
+  BaseComponent::enableDebug(true);
+  LOG_DEBUG("value %d", expensiveArgument());
+  Serial.quiet = false;
+  EXPECT_EQ(evaluations, 2);
+}
+
+TEST_F(LoggingTest, LevelsArePerComponent) {
+  EXPECT_FALSE(BaseComponent::logEnabled(LogTag::Mqtt, LOG_LEVEL_DEBUG));
+  EXPECT_TRUE(BaseComponent::logEnabled(LogTag::Mqtt, LOG_LEVEL_INFO));
+
+  BaseComponent::setLogLevel(LogTag::Mqtt, LOG_LEVEL_DEBUG);
+  EXPECT_TRUE(BaseComponent::logEnabled(LogTag::Mqtt, LOG_LEVEL_DEBUG));
+  EXPECT_FALSE(BaseComponent::logEnabled(LogTag::Camera, LOG_LEVEL_DEBUG));
+
+  BaseComponent::setLogLevel(LogTag::Mqtt, LOG_LEVEL_ERROR);
+  EXPECT_FALSE(BaseComponent::logEnabled(LogTag::Mqtt, LOG_LEVEL_WARN));
+  EXPECT_TRUE(BaseComponent::logEnabled(LogTag::Mqtt, LOG_LEVEL_ERROR));
+
+  // DebugEnable/DebugDisable from an OTA manifest reset every component
+  BaseComponent::enableDebug(true);
+  EXPECT_TRUE(BaseComponent::logEnabled(LogTag::Camera, LOG_LEVEL_DEBUG));
+  BaseComponent::enableDebug(false);
+  EXPECT_FALSE(BaseComponent::logEnabled(LogTag::Mqtt, LOG_LEVEL_DEBUG));
+  EXPECT_TRUE(BaseComponent::logEnabled(LogTag::Mqtt, LOG_LEVEL_INFO));
+}
+
+// A sensor cycle is one reading published through the dispatcher and
+// processed by a consumer on the executor. "Before" adds the debugLog
+// calls the old MessageDispatcher::publish made per reading and per
+// matching consumer; "after" is the firmware as it is, whose publish
+// and drain paths log through LOG_DEBUG.
+TEST_F(LoggingTest, AllocationsPerSensorCycle) {
+  constexpr uint32_t CYCLES = 5000;
+
+  ConsumerExecutor::begin();
+  LogRing::begin();
+  MessageDispatcher dispatcher;
+  CountingConsumer consumer("cycle");
+  consumer.begin({ CYCLES, OverflowPolicy::DropNewest });
+  dispatcher.registerConsumer(&consumer);
+  SensorHandle sensor = consumer.getSensorHandle();
+
+  auto run = [&](bool legacy) {
+    uint32_t target = consumer.processed + CYCLES;
+    uint64_t before = AllocationCounter::allocations();
+    for (uint32_t i = 0; i < CYCLES; ++i) {
+      SensorMessage msg = SensorMessage::make(sensor, i);
+      msg.set(Channel::Temperature, 3512);
+      if (legacy) {
+        legacyDebugLog("MessageDispatcher::publish - Publishing message: { temperature: " +
+                       String(msg.get(Channel::Temperature) / 100.0) + ", timestamp: " + String(msg.timestamp) +
+                       ", sensorId: " + msg.sensorId() + " }");
+        legacyDebugLog("MessageDispatcher::publish - Checking consumer [0]");
+        legacyDebugLog("Comparing msg.sensorId: [" + String(msg.sensorId()) + "] vs consumer.sensorId: [" +
+                       consumer.getSensorId() + "]");
+        legacyDebugLog("MessageDispatcher::publish - Match found. Dispatching to consumer [0]");
+      }
+      dispatcher.publish(msg);
+    }
+    EXPECT_TRUE(waitUntil([&] { return consumer.processed == target; }, 5000));
+    return static_cast<double>(AllocationCounter::allocations() - before) / CYCLES;
+  };
+
+  Serial.quiet = true;
+  double legacyOff = run(true);
+  double off = run(false);
+  legacyDebugEnabled = true;
+  BaseComponent::enableDebug(true);
+  double legacyOn = run(true);
+  double on = run(false);
+  BaseComponent::enableDebug(false);
+  legacyDebugEnabled = false;
+  delay(50);
+  Serial.quiet = false;
+
+  printf("[ BENCH    ] allocations per sensor cycle, debug off: before %.1f, after %.1f\n", legacyOff, off);
+  printf("[ BENCH    ] allocations per sensor cycle, debug on:  before %.1f, after %.1f\n", legacyOn, on);
+
+  EXPECT_GT(legacyOff, 0.0);
+  EXPECT_EQ(off, 0.0);
+  // Debug output goes through the LogRing, which copies into fixed slots
+  EXPECT_EQ(on, 0.0);
+}
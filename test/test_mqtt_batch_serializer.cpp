@@ -0,0 +1,229 @@
+// MqttBatchSerializer: MsgPack round-trip through a small host-side
+// decoder, batch splitting, and the size saving over JSON
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "MqttBatchSerializer.h"
+
+namespace {
+
+// Just enough MessagePack to read what the serializer writes
+struct Value {
+  enum Kind { Int, Str, Array, Map } kind = Int;
+  int64_t i = 0;
+  std::string s;
+  std::vector<Value> items;                  // Array elements
+  std::vector<std::pair<std::string, Value>> fields;   // Map entries, in order
+
+  const Value& operator[](const std::string& key) const {
+    for (const auto& field : fields) {
+      if (field.first == key) return field.second;
+    }
+    throw std::out_of_range("no key " + key);
+  }
+};
+
+class Decoder {
+public:
+  Decoder(const char* data, size_t length)
+      : p(reinterpret_cast<const uint8_t*>(data)), end(p + length) {}
+
+  Value next() {
+    uint8_t b = byte();
+    Value v;
+    if (b <= 0x7f) { v.i = b; return v; }
+    if (b >= 0xe0) { v.i = static_cast<int8_t>(b); return v; }
+    if ((b & 0xe0) == 0xa0) return str(b & 0x1f);
+    if ((b & 0xf0) == 0x90) return array(b & 0x0f);
+    if ((b & 0xf0) == 0x80) return map(b & 0x0f);
+    switch (b) {
+      case 0xcc: v.i = uint(1); return v;
+      case 0xcd: v.i = uint(2); return v;
+      case 0xce: v.i = uint(4); return v;
+      case 0xd0: v.i = static_cast<int8_t>(uint(1)); return v;
+      case 0xd1: v.i = static_cast<int16_t>(uint(2)); return v;
+      case 0xd2: v.i = static_cast<int32_t>(uint(4)); return v;
+      case 0xd9: return str(uint(1));
+      case 0xda: return str(uint(2));
+      case 0xdc: return array(uint(2));
+      case 0xdd: return array(uint(4));
+      case 0xde: return map(uint(2));
+    }
+    throw std::runtime_error("unsupported type byte " + std::to_string(b));
+  }
+
+  bool atEnd() const { return p == end; }
+
+private:
+  uint8_t byte() {
+    if (p >= end) throw std::runtime_error("truncated");
+    return *p++;
+  }
+
+  uint64_t uint(int bytes) {
+    uint64_t v = 0;
+    while (bytes--) v = (v << 8) | byte();
+    return v;
+  }
+
+  Value str(size_t length) {
+    Value v;
+    v.kind = Value::Str;
+    for (size_t i = 0; i < length; ++i) v.s += static_cast<char>(byte());
+    return v;
+  }
+
+  Value array(size_t size) {
+    Value v;
+    v.kind = Value::Array;
+    for (size_t i = 0; i < size; ++i) v.items.push_back(next());
+    return v;
+  }
+
+  Value map(size_t size) {
+    Value v;
+    v.kind = Value::Map;
+    for (size_t i = 0; i < size; ++i) {
+      Value key = next();
+      v.fields.emplace_back(key.s, next());
+    }
+    return v;
+  }
+
+  const uint8_t* p;
+  const uint8_t* end;
+};
+
+// Rebuilds SensorMessages from one MsgPack payload
+std::vector<SensorMessage> decodeBatch(const char* data, size_t length, Value* root = nullptr) {
+  Decoder decoder(data, length);
+  Value batch = decoder.next();
+  EXPECT_TRUE(decoder.atEnd());
+  if (root) *root = batch;
+
+  const Value& sensors = batch["sensors"];
+  std::vector<SensorMessage> out;
+  uint32_t timestamp = static_cast<uint32_t>(batch["base"].i);
+  for (const Value& item : batch["messages"].items) {
+    SensorMessage msg{};
+    size_t handle = static_cast<size_t>(item.items.at(0).i);
+    EXPECT_LT(handle, sensors.items.size());
+    msg.sensor = SensorRegistry::find(sensors.items.at(handle).s.c_str());
+    timestamp += static_cast<int32_t>(item.items.at(1).i);
+    msg.timestamp = timestamp;
+    uint8_t channels = static_cast<uint8_t>(item.items.at(2).i);
+    size_t next = 3;
+    for (size_t c = 0; c < SensorMessage::CHANNELS; ++c) {
+      if (channels & (1u << c)) msg.set(static_cast<Channel>(c), static_cast<int32_t>(item.items.at(next++).i));
+    }
+    EXPECT_EQ(next, item.items.size());
+    out.push_back(msg);
+  }
+  return out;
+}
+
+DeviceIdentity identity() {
+  DeviceIdentity id;
+  id.clientId = "client";
+  id.locationId = "site";
+  id.unitId = "unit-1";
+  id.version = "1.2.3";
+  id.board = "esp32";
+  return id;
+}
+
+std::vector<SensorMessage> sampleBatch(size_t count) {
+  SensorHandle sensors[] = {
+    SensorRegistry::intern("walk-in-freezer"),
+    SensorRegistry::intern("reach-in-cooler"),
+    SensorRegistry::intern("prep-room-bme280")
+  };
+  std::vector<SensorMessage> batch;
+  uint32_t timestamp = 1700000000;
+  for (size_t i = 0; i < count; ++i) {
+    SensorMessage msg = SensorMessage::make(sensors[i % 3], timestamp);
+    // Wide value ranges exercise every int encoding, both signs
+    msg.set(Channel::Temperature, static_cast<int32_t>(i * 7919 % 200000) - 100000);
+    if (i % 3 == 2) {
+      msg.set(Channel::Humidity, 4120 + static_cast<int32_t>(i % 50));
+      msg.set(Channel::Pressure, 101325 - static_cast<int32_t>(i));
+    }
+    batch.push_back(msg);
+    // Mostly forward in 4 s steps; now and then a clock correction backwards
+    timestamp = i % 17 == 16 ? timestamp - 90 : timestamp + 4;
+  }
+  return batch;
+}
+
+void expectSameReadings(const std::vector<SensorMessage>& expected, const std::vector<SensorMessage>& actual) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    SCOPED_TRACE(i);
+    EXPECT_EQ(actual[i].sensor, expected[i].sensor);
+    EXPECT_EQ(actual[i].timestamp, expected[i].timestamp);
+    EXPECT_EQ(actual[i].channels, expected[i].channels);
+    for (size_t c = 0; c < SensorMessage::CHANNELS; ++c) {
+      if (expected[i].has(static_cast<Channel>(c))) EXPECT_EQ(actual[i].values[c], expected[i].values[c]);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(MqttBatchSerializer, MsgPackRoundTrips) {
+  std::vector<SensorMessage> batch = sampleBatch(200);
+  MqttBatchSerializer serializer;
+  ASSERT_TRUE(serializer.begin(16 * 1024, identity(), MqttFormat::MsgPack));
+
+  ASSERT_EQ(serializer.serialize(batch.data(), batch.size()), batch.size());
+  Value root;
+  std::vector<SensorMessage> decoded = decodeBatch(serializer.data(), serializer.length(), &root);
+
+  expectSameReadings(batch, decoded);
+  EXPECT_EQ(root["device"]["clientId"].s, "client");
+  EXPECT_EQ(root["device"]["board"].s, "esp32");
+  EXPECT_EQ(root["base"].i, 1700000000);
+}
+
+TEST(MqttBatchSerializer, MsgPackSplitsAcrossPayloads) {
+  std::vector<SensorMessage> batch = sampleBatch(500);
+  MqttBatchSerializer serializer;
+  ASSERT_TRUE(serializer.begin(512, identity(), MqttFormat::MsgPack));
+
+  std::vector<SensorMessage> decoded;
+  size_t offset = 0;
+  size_t payloads = 0;
+  while (offset < batch.size()) {
+    size_t consumed = serializer.serialize(batch.data() + offset, batch.size() - offset);
+    ASSERT_GT(consumed, 0u);
+    ASSERT_LE(serializer.length(), 512u);
+    // Each payload decodes on its own, deltas restarting from its base
+    std::vector<SensorMessage> part = decodeBatch(serializer.data(), serializer.length());
+    ASSERT_EQ(part.size(), consumed);
+    decoded.insert(decoded.end(), part.begin(), part.end());
+    offset += consumed;
+    ++payloads;
+  }
+
+  EXPECT_GT(payloads, 1u);
+  expectSameReadings(batch, decoded);
+}
+
+TEST(MqttBatchSerializer, MsgPackIsSeveralTimesSmallerThanJson) {
+  std::vector<SensorMessage> batch = sampleBatch(900);
+  MqttBatchSerializer json;
+  MqttBatchSerializer msgpack;
+  ASSERT_TRUE(json.begin(256 * 1024, identity(), MqttFormat::Json));
+  ASSERT_TRUE(msgpack.begin(256 * 1024, identity(), MqttFormat::MsgPack));
+
+  ASSERT_EQ(json.serialize(batch.data(), batch.size()), batch.size());
+  ASSERT_EQ(msgpack.serialize(batch.data(), batch.size()), batch.size());
+
+  double ratio = static_cast<double>(json.length()) / msgpack.length();
+  printf("[ BENCH    ] %u readings: JSON %u bytes, MsgPack %u bytes (%.1fx)\n",
+         (unsigned)batch.size(), (unsigned)json.length(), (unsigned)msgpack.length(), ratio);
+  EXPECT_GT(ratio, 5.0);
+}
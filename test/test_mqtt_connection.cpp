@@ -0,0 +1,83 @@
+// MqttManager against a broker that stops answering, or answers CONNECT
+// late. Its own executable so managers from other suites stay out of the
+// broker's counters.
+#include <gtest/gtest.h>
+#include <WiFiClient.h>
+#include <MqttBroker.h>
+#include <SPIFFS.h>
+#include <algorithm>
+#include "ConsumerExecutor.h"
+#include "MqttManager.h"
+#include "MqttTestSupport.h"
+#include "TestSupport.h"
+
+// A broker that never answers must not hold up the rest of the firmware:
+// the main loop keeps feeding readings and polling status within its
+// budget, each TCP connect ends at WiFiClient's timeout, retries back
+// off, and the readings go out once the broker returns.
+TEST(MqttConnection, DeadBrokerNeverStallsTheCaller) {
+  hal::fsReset();
+  hal::nvsReset();
+  hal::MqttBroker::instance().reset();
+  ConsumerExecutor::begin();
+
+  constexpr uint32_t LOOP_BUDGET_MS = 20;
+  hal::MqttBroker& broker = hal::MqttBroker::instance();
+  broker.setOnline(false);
+
+  MqttConfig config = mqttConfig();
+  WiFiClient net;
+  MqttManager mqtt("*", net);
+  ASSERT_TRUE(mqtt.begin(config, identity()));
+
+  SensorHandle sensor = SensorRegistry::intern("outage");
+  uint32_t worstLoopMs = 0;
+  uint32_t start = millis();
+  int readings = 0;
+  Serial.quiet = true;
+  while (millis() - start < 4000) {
+    uint32_t loopStart = millis();
+    SensorMessage msg = SensorMessage::make(sensor, 1700000000u + readings++);
+    msg.set(Channel::Temperature, 3500);
+    mqtt.enqueue(msg);
+    (void)mqtt.getState();
+    (void)mqtt.getFlag();
+    worstLoopMs = std::max(worstLoopMs, millis() - loopStart);
+    delay(50);
+  }
+
+  EXPECT_LE(worstLoopMs, LOOP_BUDGET_MS);
+  EXPECT_LE(broker.maxConnectBlockMs(), WIFI_CLIENT_DEF_CONN_TIMEOUT_MS + 100u);
+  // 3 s timeout, then 0.5-1 s backoff: two attempts fit in 4 s, not dozens
+  EXPECT_LE(broker.connectAttempts(), 2u);
+
+  broker.setOnline(true);
+  EXPECT_TRUE(waitUntil([&] { return readingsAtBroker() == static_cast<size_t>(readings); }, 5000))
+      << readingsAtBroker() << " of " << readings;
+  Serial.quiet = false;
+  EXPECT_EQ(mqtt.getState(), MqttManager::ConnectionState::Connected);
+}
+
+// A broker that takes the TCP connection but sits on the CONNECT: the
+// attempt ends at the socket timeout, not the broker's pace.
+TEST(MqttConnection, SlowConnackEndsAtTheSocketTimeout) {
+  hal::MqttBroker& broker = hal::MqttBroker::instance();
+  broker.reset();
+  broker.setConnackDelay(30000);
+  ConsumerExecutor::begin();
+
+  WiFiClient net;
+  MqttManager mqtt("*", net);
+  Serial.quiet = true;
+  ASSERT_TRUE(mqtt.begin(mqttConfig(), identity()));
+
+  constexpr uint32_t TIMEOUT_MS = MqttManager::CONNECT_TIMEOUT_S * 1000u;
+  EXPECT_TRUE(waitUntil([&] { return broker.maxConnectBlockMs() >= TIMEOUT_MS - 100; }, TIMEOUT_MS + 1000));
+  delay(500);   // Long enough for a wait without the timeout to overshoot
+  EXPECT_LE(broker.maxConnectBlockMs(), TIMEOUT_MS + 100);
+  EXPECT_NE(mqtt.getState(), MqttManager::ConnectionState::Connected);
+
+  broker.setConnackDelay(0);
+  EXPECT_TRUE(waitUntil([&] { return mqtt.getState() == MqttManager::ConnectionState::Connected; }, 5000));
+  Serial.quiet = false;
+}
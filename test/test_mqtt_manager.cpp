@@ -0,0 +1,82 @@
+// MqttManager against the in-process broker: batch splitting, buffer
+// sizing and start-up failures
+#include <gtest/gtest.h>
+#include <WiFiClient.h>
+#include <MqttBroker.h>
+#include <SPIFFS.h>
+#include "ConsumerExecutor.h"
+#include "MessageDispatcher.h"
+#include "MqttManager.h"
+#include "MqttTestSupport.h"
+#include "TestSupport.h"
+
+namespace {
+
+class MqttManagerTest : public ::testing::Test {
+protected:
+  static void SetUpTestSuite() { ConsumerExecutor::begin(); }
+
+  void SetUp() override {
+    hal::fsReset();
+    hal::nvsReset();
+    hal::MqttBroker::instance().reset();
+  }
+};
+
+}  // namespace
+
+// A long flush window (3 sensors every 4 s for an hour is ~2700 readings)
+// goes out as several publishes that each fit bufferSize.
+TEST_F(MqttManagerTest, LargeFlushIsSplitIntoPublishesThatFitTheBuffer) {
+  constexpr int READINGS = 2700;
+  MqttConfig config = mqttConfig();
+  WiFiClient net;
+  MqttManager mqtt("*", net);
+  ASSERT_TRUE(mqtt.begin(config, identity()));
+  ASSERT_TRUE(waitUntil([&] { return mqtt.getState() == MqttManager::ConnectionState::Connected; }, 2000));
+
+  SensorHandle sensors[] = {
+    SensorRegistry::intern("freezer"), SensorRegistry::intern("cooler"), SensorRegistry::intern("prep")
+  };
+  for (int i = 0; i < READINGS; ++i) {
+    SensorMessage msg = SensorMessage::make(sensors[i % 3], 1700000000u + i);
+    msg.set(Channel::Temperature, 3300 + i % 200);
+    mqtt.enqueue(msg);
+    if (i % 32 == 31) delay(1);   // Let the consumer keep up with its 64-deep queue
+  }
+
+  ASSERT_TRUE(waitUntil([] { return readingsAtBroker() == READINGS; }, 5000)) << readingsAtBroker();
+  std::vector<hal::MqttPublish> publishes = hal::MqttBroker::instance().publishes();
+  EXPECT_GT(publishes.size(), 1u);
+  for (const auto& publish : publishes) {
+    EXPECT_LE(publish.payload.length(), static_cast<unsigned>(config.bufferSize));
+  }
+}
+
+TEST_F(MqttManagerTest, ClientBufferFitsLongCredentials) {
+  MqttConfig config = mqttConfig();
+  config.clientId = String(std::string(100, 'c'));
+  config.username = String(std::string(120, 'u'));
+  config.password = String(std::string(200, 'p'));
+  WiFiClient net;
+  MqttManager mqtt("*", net);
+  ASSERT_TRUE(mqtt.begin(config, identity()));
+
+  EXPECT_TRUE(waitUntil([&] { return mqtt.getState() == MqttManager::ConnectionState::Connected; }, 2000));
+}
+
+TEST_F(MqttManagerTest, BeginFailsWhenThePayloadBufferCannotHoldTheHeader) {
+  MqttConfig config = mqttConfig();
+  config.bufferSize = 32;
+  WiFiClient net;
+  MqttManager mqtt("*", net);
+  size_t consumers = ConsumerExecutor::consumerCount();
+
+  Serial.quiet = true;
+  EXPECT_FALSE(mqtt.begin(config, identity()));
+  Serial.quiet = false;
+  EXPECT_EQ(ConsumerExecutor::consumerCount(), consumers);
+
+  delay(50);
+  EXPECT_EQ(hal::MqttBroker::instance().connectAttempts(), 0u);
+}
@@ -0,0 +1,119 @@
+// OverlayBatcher: submit() returns at once, a window's submits share one
+// batch on one connection, and a slow camera never blocks submitters
+#include <gtest/gtest.h>
+#include <HTTPClient.h>
+#include <memory>
+#include "BasicAuthStrategy.h"
+#include "ConsumerExecutor.h"
+#include "OverlayBatcher.h"
+#include "OverlayManager.h"
+#include "TestSupport.h"
+
+namespace {
+
+ApiConfig cameraApi() {
+  ApiConfig api;
+  api.host = "camera.local";
+  api.port = 80;
+  api.path = "/axis-cgi/dynamicoverlay/dynamicoverlay.cgi";
+  return api;
+}
+
+std::shared_ptr<SecureHttpClient> cameraClient(std::shared_ptr<HttpConnectionPool> pool) {
+  return std::make_shared<SecureHttpClient>(
+    std::unique_ptr<AuthStrategy>(new BasicAuthStrategy({ "root", "pass" }, pool)), cameraApi());
+}
+
+OverlayConfig overlayConfig(int identity) {
+  OverlayConfig config;
+  config.sensorId = "batch-probe";
+  config.identity = identity;
+  config.camera = 1;
+  config.indicator = "overlay-" + String(identity);
+  config.text = "{temp}";
+  config.position = "topLeft";
+  config.fontSize = 24;
+  config.textColor = "white";
+  return config;
+}
+
+class OverlayBatcherTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    hal::HttpServer& server = hal::HttpServer::instance();
+    server.reset();
+    server.setHandler([](const hal::HttpRequest&) {
+      hal::HttpResponse response;
+      response.body = "{\"apiVersion\":\"1.0\",\"method\":\"setText\",\"data\":{}}";
+      return response;
+    });
+
+    pool = std::make_shared<HttpConnectionPool>(1);
+    client = cameraClient(pool);
+    identities = std::make_shared<OverlayIdentityCache>();
+    batcher = std::make_shared<OverlayBatcher>(client);
+    ASSERT_TRUE(batcher->begin());
+    // The flush task outlives the test, as it does the camera on the device
+    static std::vector<std::shared_ptr<OverlayBatcher>> running;
+    running.push_back(batcher);
+    for (int i = 0; i < 3; ++i) {
+      overlays.emplace_back(new OverlayManager(overlayConfig(i + 1), client, identities, batcher));
+    }
+  }
+
+  std::shared_ptr<HttpConnectionPool> pool;
+  std::shared_ptr<SecureHttpClient> client;
+  std::shared_ptr<OverlayIdentityCache> identities;
+  std::shared_ptr<OverlayBatcher> batcher;
+  std::vector<OverlayManager*> overlays;   // Leaked: onPosted may still run
+
+  bool allPosted() const {
+    for (OverlayManager* overlay : overlays) {
+      if (overlay->flag != 1) return false;
+    }
+    return true;
+  }
+};
+
+}  // namespace
+
+TEST_F(OverlayBatcherTest, SubmitReturnsWithoutWaitingForTheWindow) {
+  hal::HttpServer::instance().setLatency(0, 50000);
+
+  uint32_t worstUs = 0;
+  for (size_t i = 0; i < overlays.size(); ++i) {
+    String payload = "{\"method\":\"setText\",\"params\":{\"identity\":" + String((int)i + 1) + "}}";
+    uint32_t start = micros();
+    batcher->submit(overlays[i], payload, static_cast<int>(i) + 1, micros());
+    worstUs = std::max(worstUs, micros() - start);
+  }
+  EXPECT_LT(worstUs, 5000u);
+
+  ASSERT_TRUE(waitUntil([&] { return allPosted(); }, 2000));
+  EXPECT_EQ(hal::HttpServer::instance().requestCount(), 3u);
+  EXPECT_EQ(hal::HttpServer::instance().connectionsOpened(), 1u);
+}
+
+TEST_F(OverlayBatcherTest, ResubmitInTheWindowReplacesThePendingPayload) {
+  batcher->submit(overlays[0], "{\"v\":1}", 1, micros());
+  batcher->submit(overlays[0], "{\"v\":2}", 1, micros());
+
+  ASSERT_TRUE(waitUntil([&] { return overlays[0]->flag == 1; }, 2000));
+  std::vector<hal::HttpRequest> requests = hal::HttpServer::instance().requests();
+  ASSERT_EQ(requests.size(), 1u);
+  EXPECT_EQ(requests[0].body, "{\"v\":2}");
+}
+
+TEST_F(OverlayBatcherTest, SlowCameraDoesNotBlockTheNextWindow) {
+  hal::HttpServer::instance().setLatency(0, 400000);
+  batcher->submit(overlays[0], "{\"v\":1}", 1, micros());
+  // Let the first batch get on the wire, then submit while it is in flight
+  delay(OverlayBatcher::WINDOW_MS + 50);
+
+  uint32_t start = millis();
+  batcher->submit(overlays[1], "{\"v\":2}", 2, micros());
+  EXPECT_LT(millis() - start, 5u);
+
+  ASSERT_TRUE(waitUntil([&] { return overlays[0]->flag == 1 && overlays[1]->flag == 1; }, 3000));
+  EXPECT_EQ(hal::HttpServer::instance().requestCount(), 2u);
+}
@@ -0,0 +1,81 @@
+// OverlayIdentityCache: the filtered overlay list fits its document for
+// the largest camera configuration it is sized for
+#include <gtest/gtest.h>
+#include <HTTPClient.h>
+#include <memory>
+#include "BasicAuthStrategy.h"
+#include "OverlayIdentityCache.h"
+
+namespace {
+
+std::shared_ptr<SecureHttpClient> cameraClient() {
+  ApiConfig api;
+  api.host = "camera.local";
+  api.port = 80;
+  api.path = "/axis-cgi/dynamicoverlay/dynamicoverlay.cgi";
+  auto pool = std::make_shared<HttpConnectionPool>(1);
+  return std::make_shared<SecureHttpClient>(
+    std::unique_ptr<AuthStrategy>(new BasicAuthStrategy({ "root", "pass" }, pool)), api);
+}
+
+// 32-character indicator, unique per overlay
+String indicator(int identity) {
+  char text[33];
+  snprintf(text, sizeof(text), "camera-overlay-indicator-%07d", identity);
+  return String(text);
+}
+
+// A list response as the camera sends it, with every overlay's text,
+// position and styling that the filter has to skip
+String listResponse(int overlays) {
+  String body = "{\"apiVersion\":\"1.0\",\"method\":\"list\",\"data\":{\"textOverlays\":[";
+  for (int i = 1; i <= overlays; ++i) {
+    if (i > 1) body += ",";
+    body += "{\"camera\":1,\"identity\":" + String(i) + ",\"indicator\":\"" + indicator(i) + "\"," +
+            "\"text\":\"Freezer " + String(i) + " temperature is -18.25 °F at %d/%m/%Y %H:%M, "
+            "last checked by the night shift, padding padding padding padding padding\"," +
+            "\"position\":\"topLeft\",\"textColor\":\"white\",\"textBGColor\":\"transparent\"," +
+            "\"textOLColor\":\"black\",\"fontSize\":48,\"reference\":\"top\"," +
+            "\"scrollSpeed\":0,\"visible\":true,\"zIndex\":" + String(i) + "," +
+            "\"extra\":{\"history\":[1,2,3,4,5,6,7,8],\"owner\":{\"name\":\"operator\",\"id\":" + String(i) + "}}}";
+  }
+  body += "]}}";
+  return body;
+}
+
+void serveList(int overlays) {
+  hal::HttpServer& server = hal::HttpServer::instance();
+  server.reset();
+  String body = listResponse(overlays);
+  server.setHandler([body](const hal::HttpRequest&) {
+    hal::HttpResponse response;
+    response.body = body;
+    return response;
+  });
+}
+
+TEST(OverlayIdentityCache, LargestSupportedListFits) {
+  serveList(32);
+  ASSERT_GT(listResponse(32).length(), 12000u);   // Mostly what the filter drops
+  auto client = cameraClient();
+  OverlayIdentityCache cache;
+
+  EXPECT_EQ(cache.lookup(indicator(32), *client), 32);
+  EXPECT_EQ(cache.lookup(indicator(1), *client), 1);
+  EXPECT_EQ(cache.lookup("not-on-this-camera", *client), 0);
+  EXPECT_EQ(hal::HttpServer::instance().requestCount(), 1u);
+}
+
+TEST(OverlayIdentityCache, LongerListFailsTheLookup) {
+  serveList(40);
+  auto client = cameraClient();
+  OverlayIdentityCache cache;
+
+  std::string output;
+  Serial.capture = &output;
+  EXPECT_EQ(cache.lookup(indicator(1), *client), -1);
+  Serial.capture = nullptr;
+  EXPECT_NE(output.find("Overlay list exceeds 32 overlays"), std::string::npos) << output;
+}
+
+}  // namespace
@@ -0,0 +1,142 @@
+// OverlayTemplate: every token renders, the unit comes from the caller,
+// truncation is reported, and rendering neither parses nor allocates
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include "AllocationCounter.h"
+#include "OverlayTemplate.h"
+#include "SensorMessage.h"
+
+namespace {
+
+constexpr const char* COOLER_TEXT = "{time:%d/%m/%Y %H:%M} {sensor} {temp}{unit} (min {min}, max {max}) {humidity}%";
+
+OverlayValues coolerValues() {
+  OverlayValues values;
+  values.timestamp = 1700000000;   // 14/11/2023 22:13 UTC
+  values.hasTemperature = true;
+  values.temperature = 36;
+  values.minTemperature = 34;
+  values.maxTemperature = 38;
+  values.hasHumidity = true;
+  values.humidity = 81;
+  values.sensor = "walk-in";
+  return values;
+}
+
+// The String-based formatter OverlayPayloadBuilder used before templates
+String legacyFormat(String templateStr, time_t timestamp, int temp) {
+  struct tm* timeinfo = localtime(&timestamp);
+  int timeStart = templateStr.indexOf("{time:");
+  int timeEnd = templateStr.indexOf("}", timeStart);
+  if (timeStart != -1 && timeEnd != -1) {
+    String formatSpec = templateStr.substring(timeStart + 6, timeEnd);
+    char timeBuf[64];
+    strftime(timeBuf, sizeof(timeBuf), formatSpec.c_str(), timeinfo);
+    templateStr.replace(templateStr.substring(timeStart, timeEnd + 1), String(timeBuf));
+  }
+  templateStr.replace("{temp}", String(temp));
+  return templateStr;
+}
+
+class OverlayTemplateTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    setenv("TZ", "UTC0", 1);
+    tzset();
+  }
+};
+
+}  // namespace
+
+TEST_F(OverlayTemplateTest, RendersEveryToken) {
+  OverlayTemplate text(COOLER_TEXT);
+  char out[128];
+
+  size_t len = text.render(out, sizeof(out), coolerValues());
+  EXPECT_STREQ(out, "14/11/2023 22:13 walk-in 36°F (min 34, max 38) 81%");
+  EXPECT_EQ(len, strlen(out));
+  EXPECT_TRUE(text.usesTime());
+}
+
+TEST_F(OverlayTemplateTest, UnitComesFromTheValues) {
+  OverlayTemplate text("{temp}{unit}");
+  OverlayValues values = coolerValues();
+  values.temperature = 2;
+  values.unit = unitSymbol(TemperatureUnit::Celsius);
+  char out[32];
+
+  text.render(out, sizeof(out), values);
+  EXPECT_STREQ(out, "2°C");
+}
+
+TEST_F(OverlayTemplateTest, ConvertsTemperaturesForCelsiusOverlays) {
+  SensorMessage msg = SensorMessage::make(SensorHandle{}, 0);
+  msg.set(Channel::Temperature, 3560);    // 35.60 °F = 2.00 °C
+  EXPECT_EQ(msg.wholeTemperature(TemperatureUnit::Fahrenheit), 36);
+  EXPECT_EQ(msg.wholeTemperature(TemperatureUnit::Celsius), 2);
+
+  msg.set(Channel::Temperature, -400);    // -4.00 °F = -20.00 °C
+  EXPECT_EQ(msg.wholeTemperature(TemperatureUnit::Celsius), -20);
+  msg.set(Channel::Temperature, 3290);    // 32.90 °F = 0.50 °C, rounds away from zero
+  EXPECT_EQ(msg.wholeTemperature(TemperatureUnit::Celsius), 1);
+  msg.set(Channel::Temperature, 3110);    // 31.10 °F = -0.50 °C
+  EXPECT_EQ(msg.wholeTemperature(TemperatureUnit::Celsius), -1);
+}
+
+TEST_F(OverlayTemplateTest, MissingValuesAndUnknownTokens) {
+  OverlayTemplate text("{temp} {humidity} {pressure} {bogus} {unclosed");
+  char out[64];
+
+  text.render(out, sizeof(out), OverlayValues());
+  EXPECT_STREQ(out, "-- -- -- {bogus} {unclosed");
+  EXPECT_FALSE(text.usesTime());
+}
+
+TEST_F(OverlayTemplateTest, ReportsTruncation) {
+  OverlayTemplate text(COOLER_TEXT);
+  char full[128];
+  size_t needed = text.render(full, sizeof(full), coolerValues());
+
+  char out[16];
+  EXPECT_EQ(text.render(out, sizeof(out), coolerValues()), needed);
+  EXPECT_EQ(strlen(out), sizeof(out) - 1);
+  EXPECT_EQ(strncmp(out, full, sizeof(out) - 1), 0);
+
+  // A time field that does not fit is cut like any other run
+  char cut[8];
+  EXPECT_EQ(OverlayTemplate("{time:%d/%m/%Y}").render(cut, sizeof(cut), coolerValues()), 10u);
+  EXPECT_STREQ(cut, "14/11/2");
+}
+
+TEST_F(OverlayTemplateTest, RenderBenchmark) {
+  constexpr int RENDERS = 20000;
+  const String legacyText = "{time:%d/%m/%Y %H:%M} cooler temperature is {temp}°F";
+  OverlayTemplate text(legacyText);
+  OverlayValues values = coolerValues();
+  char out[128];
+  volatile size_t sink = 0;
+
+  auto measure = [&](auto&& render, double& nsPerRender, double& allocsPerRender) {
+    uint64_t allocs = AllocationCounter::allocations();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < RENDERS; ++i) render(i);
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    nsPerRender = static_cast<double>(elapsed.count()) / RENDERS;
+    allocsPerRender = static_cast<double>(AllocationCounter::allocations() - allocs) / RENDERS;
+  };
+
+  double legacyNs, legacyAllocs, compiledNs, compiledAllocs;
+  measure([&](int i) { sink = sink + legacyFormat(legacyText, values.timestamp + i, 36).length(); },
+          legacyNs, legacyAllocs);
+  measure([&](int i) {
+            values.timestamp = 1700000000 + i;
+            sink = sink + text.render(out, sizeof(out), values);
+          },
+          compiledNs, compiledAllocs);
+
+  printf("[ BENCH    ] overlay text render: before %.0f ns, %.1f allocations; after %.0f ns, %.1f allocations\n",
+         legacyNs, legacyAllocs, compiledNs, compiledAllocs);
+  EXPECT_EQ(compiledAllocs, 0.0);
+  EXPECT_GT(legacyAllocs, 0.0);
+}
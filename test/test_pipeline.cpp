@@ -0,0 +1,86 @@
+// End-to-end: readings published on the dispatcher reach the broker
+// through the consumer executor, the MQTT task and the serializer.
+#include <gtest/gtest.h>
+#include <WiFiClient.h>
+#include <MqttBroker.h>
+#include <SPIFFS.h>
+#include "ConsumerExecutor.h"
+#include "MessageDispatcher.h"
+#include "MqttManager.h"
+#include "TestSupport.h"
+
+namespace {
+
+MqttConfig mqttConfig() {
+  MqttConfig config;
+  config.enabled = true;
+  config.sensorId = "*";
+  config.broker = "broker.local";
+  config.port = 1883;
+  config.clientId = "unit-1";
+  config.topic = "logicgard/readings";
+  config.batchSize = 4;
+  config.flushIntervalMs = 100;
+  config.bufferSize = 1024;
+  config.format = MqttFormat::Json;
+  config.queue.depth = 32;
+  return config;
+}
+
+DeviceIdentity identity() {
+  DeviceIdentity id;
+  id.clientId = "client";
+  id.locationId = "site";
+  id.unitId = "unit-1";
+  id.version = "test";
+  id.board = "host";
+  return id;
+}
+
+}  // namespace
+
+TEST(Pipeline, ReadingsReachTheBrokerInOrder) {
+  hal::fsReset();
+  hal::nvsReset();
+  hal::MqttBroker::instance().reset();
+  ConsumerExecutor::begin();
+
+  MessageDispatcher dispatcher;
+  WiFiClient net;
+  MqttManager mqtt("*", net);
+  MqttConfig config = mqttConfig();
+  ASSERT_TRUE(mqtt.begin(config, identity()));
+  dispatcher.registerConsumer(&mqtt);
+
+  SensorHandle probe = SensorRegistry::intern("probe");
+  for (int i = 0; i < 8; ++i) {
+    SensorMessage msg = SensorMessage::make(probe, 1000 + i);
+    msg.set(Channel::Temperature, 7000 + i);
+    dispatcher.publish(msg);
+  }
+
+  auto published = [] {
+    size_t readings = 0;
+    for (const auto& publish : hal::MqttBroker::instance().publishes()) {
+      for (int pos = 0; (pos = publish.payload.indexOf("\"timestamp\"", pos)) >= 0; ++pos) ++readings;
+    }
+    return readings;
+  };
+  ASSERT_TRUE(waitUntil([&] { return published() == 8; }, 3000)) << published() << " readings published";
+
+  String all;
+  for (const auto& publish : hal::MqttBroker::instance().publishes()) {
+    EXPECT_EQ(publish.topic, config.topic);
+    EXPECT_TRUE(publish.payload.startsWith("{\"device\":{\"clientId\":\"client\"")) << publish.payload.c_str();
+    all += publish.payload;
+  }
+  int last = -1;
+  for (int i = 0; i < 8; ++i) {
+    char timestamp[24];
+    snprintf(timestamp, sizeof(timestamp), "\"timestamp\":%d", 1000 + i);
+    int pos = all.indexOf(timestamp);
+    ASSERT_GT(pos, last) << "reading " << i << " missing or out of order";
+    last = pos;
+  }
+  EXPECT_EQ(mqtt.getState(), MqttManager::ConnectionState::Connected);
+}
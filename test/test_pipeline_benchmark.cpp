@@ -0,0 +1,151 @@
+// Pipeline benchmark: synthetic sensors publish through the dispatcher to
+// MQTT and to camera overlays against the host stand-ins. Reports
+// throughput, per-stage latency, queue high-water and per-task resources
+// from PipelineStats, plus host allocations per reading in place of the
+// ESP32 heap figures.
+#include <gtest/gtest.h>
+#include <HTTPClient.h>
+#include <WiFiClient.h>
+#include <SPIFFS.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include "AllocationCounter.h"
+#include "BasicAuthStrategy.h"
+#include "ConsumerExecutor.h"
+#include "MessageDispatcher.h"
+#include "MqttManager.h"
+#include "MqttTestSupport.h"
+#include "OverlayBatcher.h"
+#include "OverlayManager.h"
+#include "PipelineStats.h"
+#include "TestSupport.h"
+
+namespace {
+
+constexpr int SENSORS = 8;
+constexpr int ROUNDS = 200;          // One reading per sensor per round
+constexpr int OVERLAYS = 2;          // On the first sensors, one camera
+constexpr uint32_t CAMERA_US = 2000; // Camera round trip per request
+
+OverlayConfig overlayConfig(int index) {
+  OverlayConfig config;
+  config.sensorId = "bench-" + String(index);
+  config.identity = index + 1;
+  config.camera = 1;
+  config.indicator = "bench-overlay-" + String(index);
+  config.text = "{sensor} {temp}{unit} {humidity}%";
+  config.position = "topLeft";
+  config.fontSize = 24;
+  config.textColor = "white";
+  return config;
+}
+
+}  // namespace
+
+TEST(PipelineBenchmark, SensorsToMqttAndOverlays) {
+  hal::fsReset();
+  hal::nvsReset();
+  hal::MqttBroker::instance().reset();
+  hal::HttpServer& camera = hal::HttpServer::instance();
+  camera.reset();
+  camera.setLatency(0, CAMERA_US);
+  camera.setHandler([](const hal::HttpRequest&) {
+    hal::HttpResponse response;
+    response.body = "{\"apiVersion\":\"1.0\",\"method\":\"setText\",\"data\":{}}";
+    return response;
+  });
+  ConsumerExecutor::begin();
+
+  MessageDispatcher dispatcher;
+  WiFiClient net;
+  MqttManager mqtt("*", net);
+  MqttConfig config = mqttConfig();
+  config.batchSize = 16;
+  config.flushIntervalMs = 50;
+  ASSERT_TRUE(mqtt.begin(config, identity()));
+  dispatcher.registerConsumer(&mqtt);
+
+  ApiConfig api;
+  api.host = "camera.local";
+  api.port = 80;
+  api.path = "/axis-cgi/dynamicoverlay/dynamicoverlay.cgi";
+  auto client = std::make_shared<SecureHttpClient>(
+    std::unique_ptr<AuthStrategy>(new BasicAuthStrategy({ "root", "pass" })), api);
+  // The flush task outlives the test, and calls back into the overlays
+  static auto batcher = std::make_shared<OverlayBatcher>(client);
+  ASSERT_TRUE(batcher->begin());
+  auto identities = std::make_shared<OverlayIdentityCache>();
+  static std::vector<OverlayManager*> overlays;   // Leaked: onPosted may still run
+  for (int i = 0; i < OVERLAYS; ++i) {
+    overlays.push_back(new OverlayManager(overlayConfig(i), client, identities, batcher));
+    overlays.back()->begin(dispatcher);
+  }
+
+  SensorHandle sensors[SENSORS];
+  for (int s = 0; s < SENSORS; ++s) sensors[s] = SensorRegistry::intern("bench-" + String(s));
+
+  PipelineStats::logSummary();   // Starts a clean window
+  Serial.quiet = true;
+  uint64_t allocations = AllocationCounter::allocations();
+  uint64_t bytes = AllocationCounter::bytes();
+  auto start = std::chrono::steady_clock::now();
+
+  for (int round = 0; round < ROUNDS; ++round) {
+    for (int s = 0; s < SENSORS; ++s) {
+      SensorMessage msg = SensorMessage::make(sensors[s], 1700000000 + round);
+      msg.set(Channel::Temperature, round * SensorMessage::SCALE);
+      msg.set(Channel::Humidity, 8100);
+      dispatcher.publish(msg);
+    }
+    delay(1);
+  }
+
+  constexpr size_t TOTAL = SENSORS * ROUNDS;
+  uint32_t dropped = 0;
+  bool drained = waitUntil([&] {
+    dropped = mqtt.getQueueStats().dropped;
+    return readingsAtBroker() + dropped == TOTAL;
+  }, 10000);
+  // Coalescing may skip readings, but each overlay ends on the last one
+  auto showsLastRound = [&](int index) {
+    String text = "bench-" + String(index) + " " + String(ROUNDS - 1);
+    for (const hal::HttpRequest& request : camera.requests()) {
+      if (request.body.indexOf(text) >= 0) return true;
+    }
+    return false;
+  };
+  // flag is set after onPosted has recorded the overlay latency
+  bool overlaysDone = waitUntil([&] {
+    for (int i = 0; i < OVERLAYS; ++i) {
+      if (!showsLastRound(i) || overlays[i]->flag != 1) return false;
+    }
+    return true;
+  }, 5000);
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  double perReading = static_cast<double>(AllocationCounter::allocations() - allocations) / TOTAL;
+  double bytesPerReading = static_cast<double>(AllocationCounter::bytes() - bytes) / TOTAL;
+  Serial.quiet = false;
+
+  std::string summary;
+  Serial.capture = &summary;
+  PipelineStats::logSummary();
+  Serial.capture = nullptr;
+
+  printf("[ BENCH    ] %zu readings from %d sensors in %.3f s (%.0f/s); MQTT dropped %lu; "
+         "%lu camera requests for %d overlays; %.1f allocations, %.0f bytes per reading\n",
+         TOTAL, SENSORS, seconds, TOTAL / seconds, static_cast<unsigned long>(dropped),
+         static_cast<unsigned long>(camera.requestCount()), OVERLAYS, perReading, bytesPerReading);
+
+  ASSERT_TRUE(drained) << readingsAtBroker() << " readings at the broker, " << dropped << " dropped";
+  EXPECT_TRUE(overlaysDone);
+  EXPECT_EQ(dropped, 0u);
+  EXPECT_NE(summary.find("queue latency"), std::string::npos) << summary;
+  EXPECT_NE(summary.find("mqtt latency"), std::string::npos) << summary;
+  EXPECT_NE(summary.find("overlay latency"), std::string::npos) << summary;
+  EXPECT_NE(summary.find("queue high-water"), std::string::npos) << summary;
+  EXPECT_NE(summary.find("queue task: stack headroom"), std::string::npos) << summary;
+  EXPECT_NE(summary.find("mqtt task: stack headroom"), std::string::npos) << summary;
+  EXPECT_NE(summary.find("overlay task: stack headroom"), std::string::npos) << summary;
+}
@@ -0,0 +1,143 @@
+// Sensor_1Wire on a simulated bus: one broadcast convert per cycle, no
+// read before the conversion time, and poll() never waits on the bus
+#include <gtest/gtest.h>
+#include <DallasTemperature.h>
+#include <mutex>
+#include <vector>
+#include "ConsumerExecutor.h"
+#include "MessageDispatcher.h"
+#include "Sensor_1Wire.h"
+#include "TestSupport.h"
+
+namespace {
+
+constexpr uint8_t PIN = 4;
+
+class RecordingConsumer : public MessageConsumer {
+public:
+  using MessageConsumer::MessageConsumer;
+  ~RecordingConsumer() override { end(); }
+
+  std::vector<SensorMessage> received() {
+    std::lock_guard<std::mutex> guard(mutex);
+    return messages;
+  }
+
+protected:
+  void process(const SensorMessage& msg) override {
+    std::lock_guard<std::mutex> guard(mutex);
+    messages.push_back(msg);
+  }
+
+private:
+  std::mutex mutex;
+  std::vector<SensorMessage> messages;
+};
+
+SensorConfig busConfig(uint8_t resolution) {
+  SensorConfig config;
+  config.name = "cooler";
+  config.interface = "onewire";
+  config.enabled = true;
+  config.readIntervalMs = 400;
+  config.onewirePin = PIN;
+  config.resolution = resolution;
+  config.probes.push_back({ "28FF000000000001", "cooler door" });
+  return config;
+}
+
+void addProbe(uint8_t last, float tempC) {
+  hal::Ds18b20 probe{ { 0x28, 0xFF, 0, 0, 0, 0, 0, last }, tempC };
+  hal::OneWireBus::onPin(PIN).probes.push_back(probe);
+}
+
+class Sensor1WireTest : public ::testing::Test {
+protected:
+  static void SetUpTestSuite() { ConsumerExecutor::begin(); }
+
+  void SetUp() override {
+    hal::OneWireBus::resetAll();
+    addProbe(0x01, 2.0f);
+    addProbe(0x02, -18.5f);
+    addProbe(0x03, 4.25f);
+  }
+};
+
+}  // namespace
+
+TEST_F(Sensor1WireTest, EnumeratesProbesAtTheConfiguredResolution) {
+  MessageDispatcher dispatcher;
+  SensorConfig config = busConfig(10);
+  Sensor_1Wire bus(dispatcher, config);
+
+  ASSERT_TRUE(bus.begin());
+  EXPECT_EQ(bus.probeCount(), 3u);
+  for (const hal::Ds18b20& probe : hal::OneWireBus::onPin(PIN).probes) {
+    EXPECT_EQ(probe.resolution, 10);
+  }
+  EXPECT_TRUE(SensorRegistry::find("cooler door") != SensorRegistry::INVALID);
+  EXPECT_TRUE(SensorRegistry::find("cooler 28FF000000000002") != SensorRegistry::INVALID);
+}
+
+TEST_F(Sensor1WireTest, ConvertsOnceAndReadsOnlyAfterTheConversionTime) {
+  constexpr int CYCLES = 5;
+  MessageDispatcher dispatcher;
+  RecordingConsumer door("cooler door");
+  door.begin({ 8, OverflowPolicy::DropNewest });
+  dispatcher.registerConsumer(&door);
+
+  SensorConfig config = busConfig(9);
+  Sensor_1Wire bus(dispatcher, config);
+  ASSERT_TRUE(bus.begin());
+  hal::OneWireBus& wire = hal::OneWireBus::onPin(PIN);
+
+  for (int i = 0; i < CYCLES; ++i) {
+    // Step one only starts the conversion: it must not spin for it
+    uint32_t start = millis();
+    uint32_t waitMs = bus.poll();
+    EXPECT_LT(millis() - start, 20u);
+    EXPECT_EQ(waitMs, DallasTemperature::millisToWaitForConversion(9));
+    delay(waitMs);
+
+    uint32_t restMs = bus.poll();
+    // Convert start to convert start stays on the configured interval
+    EXPECT_EQ(waitMs + restMs, config.readIntervalMs);
+  }
+
+  EXPECT_EQ(wire.conversions, static_cast<uint32_t>(CYCLES));
+  EXPECT_EQ(wire.reads, static_cast<uint32_t>(CYCLES * 3));
+  EXPECT_EQ(wire.earlyReads, 0u);
+
+  ASSERT_TRUE(waitUntil([&] { return door.received().size() == CYCLES; }, 2000));
+  for (const SensorMessage& msg : door.received()) {
+    EXPECT_EQ(msg.get(Channel::Temperature), 3560);   // 2.00 °C
+  }
+}
+
+TEST_F(Sensor1WireTest, DisconnectedProbesAreSkipped) {
+  MessageDispatcher dispatcher;
+  RecordingConsumer all("*");
+  all.begin({ 8, OverflowPolicy::DropNewest });
+  dispatcher.registerConsumer(&all);
+
+  SensorConfig config = busConfig(9);
+  Sensor_1Wire bus(dispatcher, config);
+  ASSERT_TRUE(bus.begin());
+  hal::OneWireBus::onPin(PIN).probes[1].connected = false;
+
+  delay(bus.poll());
+  bus.poll();
+
+  ASSERT_TRUE(waitUntil([&] { return all.received().size() == 2; }, 2000));
+  delay(20);
+  EXPECT_EQ(all.received().size(), 2u);
+}
+
+TEST_F(Sensor1WireTest, EmptyBusFailsBegin) {
+  hal::OneWireBus::resetAll();
+  MessageDispatcher dispatcher;
+  SensorConfig config = busConfig(12);
+  Sensor_1Wire bus(dispatcher, config);
+
+  EXPECT_FALSE(bus.begin());
+}
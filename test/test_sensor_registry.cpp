@@ -0,0 +1,133 @@
+// SensorRegistry interning, and the allocation-free publish path it enables
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "AllocationCounter.h"
+#include "ConsumerExecutor.h"
+#include "MessageDispatcher.h"
+#include "SensorRegistry.h"
+
+TEST(SensorRegistry, InternIsIdempotentAndNamesRoundTrip) {
+  SensorHandle freezer = SensorRegistry::intern("freezer");
+  SensorHandle cooler = SensorRegistry::intern("cooler");
+
+  ASSERT_NE(freezer, SensorRegistry::INVALID);
+  ASSERT_NE(cooler, SensorRegistry::INVALID);
+  EXPECT_NE(freezer, cooler);
+  EXPECT_EQ(SensorRegistry::intern("freezer"), freezer);
+  EXPECT_EQ(SensorRegistry::find("cooler"), cooler);
+  EXPECT_STREQ(SensorRegistry::name(freezer), "freezer");
+  EXPECT_EQ(SensorRegistry::find("pantry"), SensorRegistry::INVALID);
+  EXPECT_STREQ(SensorRegistry::name(SensorRegistry::INVALID), "");
+  EXPECT_EQ(SensorRegistry::intern(""), SensorRegistry::INVALID);
+}
+
+TEST(SensorRegistry, RejectsNamesThatWouldBeTruncated) {
+  String longest(std::string(SensorRegistry::MAX_NAME_LEN - 1, 'a'));
+  String tooLong = longest + "b";
+  String alsoTooLong = longest + "c";
+
+  SensorHandle fits = SensorRegistry::intern(longest);
+  ASSERT_NE(fits, SensorRegistry::INVALID);
+  EXPECT_STREQ(SensorRegistry::name(fits), longest.c_str());
+
+  // Before, both of these matched `longest` on its first 31 characters
+  EXPECT_EQ(SensorRegistry::intern(tooLong), SensorRegistry::INVALID);
+  EXPECT_EQ(SensorRegistry::intern(alsoTooLong), SensorRegistry::INVALID);
+  EXPECT_EQ(SensorRegistry::find(tooLong), SensorRegistry::INVALID);
+}
+
+TEST(SensorRegistry, ReadersSeeCompleteNamesWhileOthersIntern) {
+  std::atomic<bool> done{false};
+  std::atomic<uint32_t> torn{0};
+
+  std::thread reader([&] {
+    while (!done.load()) {
+      for (size_t i = 0; i < SensorRegistry::count(); ++i) {
+        const char* name = SensorRegistry::name(static_cast<SensorHandle>(i));
+        if (name[0] == '\0' || SensorRegistry::find(name) != i) torn.fetch_add(1);
+      }
+    }
+  });
+
+  std::vector<std::thread> writers;
+  for (int w = 0; w < 4; ++w) {
+    writers.emplace_back([w] {
+      for (int i = 0; i < 4; ++i) {
+        SensorRegistry::intern(String("probe-") + String(w) + "-" + String(i));
+      }
+    });
+  }
+  for (auto& t : writers) t.join();
+  done.store(true);
+  reader.join();
+
+  EXPECT_EQ(torn.load(), 0u);
+  for (int w = 0; w < 4; ++w) {
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_NE(SensorRegistry::find(String("probe-") + String(w) + "-" + String(i)), SensorRegistry::INVALID);
+    }
+  }
+}
+
+namespace {
+class CountingConsumer : public MessageConsumer {
+public:
+  using MessageConsumer::MessageConsumer;
+  ~CountingConsumer() override { end(); }
+  std::atomic<uint64_t> processed{0};
+  std::atomic<int64_t> checksum{0};
+
+protected:
+  void process(const SensorMessage& msg) override {
+    processed.fetch_add(1, std::memory_order_relaxed);
+    checksum.fetch_add(msg.get(Channel::Temperature), std::memory_order_relaxed);
+  }
+};
+}
+
+TEST(SensorRegistry, PublishToProcessDoesNotAllocate) {
+  constexpr uint32_t MESSAGES = 2000000;
+
+  ConsumerExecutor::begin();
+  MessageDispatcher dispatcher;
+
+  CountingConsumer routed("walk-in");
+  routed.begin({ 64, OverflowPolicy::DropNewest });
+  CountingConsumer overlay("walk-in");
+  overlay.begin({ 1, OverflowPolicy::CoalesceLatest });
+  CountingConsumer wildcard("*");
+  wildcard.begin({ 64, OverflowPolicy::DropOldest });
+  dispatcher.registerConsumer(&routed);
+  dispatcher.registerConsumer(&overlay);
+  dispatcher.registerConsumer(&wildcard);
+
+  SensorHandle walkIn = SensorRegistry::find("walk-in");
+  SensorHandle other = SensorRegistry::intern("reach-in");
+  ASSERT_NE(walkIn, SensorRegistry::INVALID);
+
+  // Warm up lazily created thread state before counting
+  for (uint32_t i = 0; i < 1000; ++i) {
+    dispatcher.publish(SensorMessage::make(walkIn, i));
+  }
+  delay(50);
+
+  uint64_t before = AllocationCounter::allocations();
+  for (uint32_t i = 0; i < MESSAGES; ++i) {
+    SensorMessage msg = SensorMessage::make(i & 1 ? walkIn : other, i);
+    msg.set(Channel::Temperature, 3300 + static_cast<int32_t>(i % 100));
+    dispatcher.publish(msg);
+  }
+  delay(100);
+  uint64_t allocations = AllocationCounter::allocations() - before;
+
+  EXPECT_EQ(allocations, 0u) << "publish -> queue -> process allocated";
+
+  // Every reading was either processed or counted by its overflow policy
+  MessageConsumer::QueueStats stats = wildcard.getQueueStats();
+  EXPECT_EQ(stats.enqueued, MESSAGES + 1000);
+  EXPECT_GT(wildcard.processed.load(), 0u);
+  EXPECT_GT(routed.processed.load(), 0u);
+  EXPECT_GT(overlay.processed.load(), 0u);
+}